@@ -0,0 +1,972 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+//
+// Measures the throughput, the number of allocations, the memory pool usage,
+// and the stack usage of the serializers and deserializers.
+//
+// Usage:
+//   benchmarks [options] [files...]
+//     --min-time <ms>     minimum duration of each measurement (default: 200)
+//     --rounds <n>        number of measurements, the best is kept (default: 5)
+//     --capacity <bytes>  capacity of the JsonDocument for the files
+//                         (default: 16384)
+//     --block-size <bytes>  size of the blocks of GrowableJsonDocument
+//                         (default: 512)
+//     --output <file>     write the results to a file instead of stdout
+//
+//   benchmarks --compare <baseline.json> <current.json> [--threshold <%>]
+//
+//   benchmarks --ndjson <records> [--threads <n>]
+//     decodes a generated log with one reading per line: each line in a new
+//     document, with a JsonSequence, and with a JsonSequence per thread on
+//     shards split at newlines (default: one thread per core)
+//
+// Files ending with ".json" are read as JSON, others as MessagePack.
+// The synthetic documents "sqm", "sqm_batch", and "getsettings" mimic the
+// traffic of the /SQM and /getsettings endpoints of the firmware, and use
+// the same document capacities. "sqm_records_<n>" contain <n> readings with
+// string values, to see how the parsing time grows with the number of
+// strings. "large_object" has 300 members. "log_messages" contains long
+// strings with a few characters to escape, to measure the serialization of
+// strings into the different writers. "telemetry" is made of integers and
+// timestamps, to measure the serialization of integers. "log_messages_msgpack"
+// and "telemetry_msgpack" are the same documents in MessagePack.
+// "measure_serialize" and "serialize_chunked" are two ways to know the length
+// of the output before sending it: measureJson() then serializeJson(), or a
+// single pass into a ChunkedBuffer.
+//
+// The benchmarks use the instrumentation and the documents of this tree
+// (InstrumentedAllocator, memoryStats(), JsonHandler, GrowableJsonDocument,
+// ChunkedBuffer, JsonSequence), so they don't build against older versions.
+// To compare two builds of this tree, run both with the same arguments, then
+// compare the results. The exit code is 1 if a benchmark is slower than the
+// threshold, or if it allocates more memory.
+// The memory pools count their allocations (ARDUINOJSON_ENABLE_MEMORY_STATS).
+// A synthetic document is over budget if its pool overflows the capacity of
+// the firmware; the exit code is then 1.
+// The "growable" operations parse into a GrowableJsonDocument instead of a
+// DynamicJsonDocument; "growable_reuse" keeps the document between the runs,
+// like a loop that calls clear() before each request. They need
+// ARDUINOJSON_ENABLE_GROWABLE_POOL, so the other operations are built with it
+// too.
+// "benchmarks_iterative" is the same program, built with
+// ARDUINOJSON_ENABLE_ITERATIVE_PARSING, to compare both parsers.
+
+// Stream class of the test helpers, for the benchmarks of Stream inputs
+#include <Arduino.h>
+
+#define ARDUINOJSON_ENABLE_ARDUINO_STREAM 1
+#define ARDUINOJSON_ENABLE_ARDUINO_STRING 1
+#define ARDUINOJSON_ENABLE_GROWABLE_POOL 1
+#define ARDUINOJSON_ENABLE_MEMORY_STATS 1
+#include <ArduinoJson.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+AllocatorStats heapStats;
+
+struct CountingAllocator : InstrumentedAllocator<> {
+  CountingAllocator() : InstrumentedAllocator<>(heapStats) {}
+};
+
+typedef BasicJsonDocument<CountingAllocator> BenchmarkDocument;
+typedef BasicGrowableJsonDocument<CountingAllocator> GrowableBenchmarkDocument;
+
+enum Format { JSON, MSGPACK };
+
+struct Document {
+  std::string name;
+  Format format;
+  std::string content;
+  std::string filter;  // in JSON
+  size_t capacity;
+};
+
+struct Options {
+  double minTime;  // in milliseconds
+  int rounds;
+  size_t capacity;
+  size_t blockSize;
+  const char* output;
+};
+
+// What one run of an operation did
+struct Outcome {
+  size_t bytes;  // input or output size, used for the throughput
+  size_t poolUsage;
+  MemoryPoolStats pool;  // zero if the operation doesn't fill a document
+  DeserializationError error;
+
+  Outcome(size_t b, size_t p, DeserializationError e = DeserializationError::Ok)
+      : bytes(b), poolUsage(p), pool(), error(e) {}
+
+  Outcome(size_t b, const JsonDocument& doc,
+          DeserializationError e = DeserializationError::Ok)
+      : bytes(b),
+        poolUsage(doc.memoryUsage()),
+        pool(doc.memoryStats()),
+        error(e) {}
+};
+
+struct Result {
+  std::string document;
+  Format format;
+  std::string operation;
+  size_t bytes;
+  unsigned long iterations;
+  double nsPerOp;
+  size_t allocations;
+  size_t allocatedBytes;
+  size_t peakHeap;  // bytes allocated at the same time by the operation
+  size_t peakPool;
+  MemoryPoolStats pool;
+  size_t stack;  // high-water mark, in bytes
+  bool overBudget;
+  DeserializationError error;
+};
+
+volatile size_t sink;
+
+typedef std::chrono::steady_clock Clock;
+
+// The stack usage is measured by filling the stack with a pattern before the
+// operation, then looking how much of the pattern was overwritten
+const size_t stackProbeSize = 64 * 1024;
+const char stackPattern = char(0xA5);
+
+NO_INLINE void paintStack() {
+  char area[stackProbeSize];
+  volatile char* p = area;
+  for (size_t i = 0; i < stackProbeSize; i++)
+    p[i] = stackPattern;
+}
+
+NO_INLINE size_t paintedStack() {
+  char area[stackProbeSize];
+#if defined(__GNUC__)
+  // the area is read as the previous calls left it: hide that from the
+  // compiler, which would otherwise see a read of uninitialized memory
+  __asm__ volatile("" : : "r"(area) : "memory");
+#endif
+  const volatile char* p = area;  // the stack grows down, area[0] is deepest
+  size_t n = 0;
+  while (n < stackProbeSize && p[n] == stackPattern)
+    n++;
+  return n;
+}
+
+template <typename TOperation>
+NO_INLINE size_t measureStack(TOperation op) {
+  paintStack();
+  sink = sink + op().bytes;
+  return stackProbeSize - paintedStack();
+}
+
+struct NoOperation {
+  Outcome operator()() const {
+    return Outcome(0, 0);
+  }
+};
+
+template <typename TOperation>
+Result run(const Options& options, const Document& document,
+           const char* operation, TOperation op) {
+  Result result;
+  result.document = document.name;
+  result.format = document.format;
+  result.operation = operation;
+
+  // first run: warms the caches and counts the allocations
+  size_t heapBefore = heapStats.currentBytes;
+  heapStats.reset();
+  Outcome outcome = op();
+  result.allocations = heapStats.allocations;
+  result.allocatedBytes = heapStats.totalBytes;
+  result.peakHeap = heapStats.peakBytes - heapBefore;
+  result.pool = outcome.pool;
+  // the synthetic documents have the capacity of the firmware
+  result.overBudget = document.capacity > 0 && outcome.pool.overflows > 0;
+
+  // second run: measures the stack, minus the overhead of measureStack()
+  static size_t stackOverhead = measureStack(NoOperation());
+  size_t stack = measureStack(op);
+  result.stack = stack > stackOverhead ? stack - stackOverhead : 0;
+  result.bytes = outcome.bytes;
+  result.peakPool = outcome.poolUsage;
+  result.error = outcome.error;
+
+  result.nsPerOp = 0;
+  result.iterations = 0;
+  for (int round = 0; round < options.rounds; round++) {
+    unsigned long iterations = 0;
+    double elapsed;  // in nanoseconds
+    Clock::time_point start = Clock::now();
+    do {
+      outcome = op();
+      sink = sink + outcome.bytes;
+      iterations++;
+      elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start)
+                    .count();
+    } while (elapsed < options.minTime * 1e6);
+    double nsPerOp = elapsed / double(iterations);
+    if (round == 0 || nsPerOp < result.nsPerOp) {
+      result.nsPerOp = nsPerOp;
+      result.iterations = iterations;
+    }
+  }
+  return result;
+}
+
+DeserializationError deserialize(JsonDocument& doc, const Document& document) {
+  if (document.format == JSON)
+    return deserializeJson(doc, document.content.data(),
+                           document.content.size());
+  else
+    return deserializeMsgPack(doc, document.content.data(),
+                              document.content.size());
+}
+
+DeserializationError deserialize(JsonDocument& doc, const Document& document,
+                                 JsonDocument& filter) {
+  if (document.format == JSON)
+    return deserializeJson(doc, document.content.data(),
+                           document.content.size(),
+                           DeserializationOption::Filter(filter));
+  else
+    return deserializeMsgPack(doc, document.content.data(),
+                              document.content.size(),
+                              DeserializationOption::Filter(filter));
+}
+
+// Receives the events of the parser, without storing anything
+struct EventCounter : JsonHandler {
+  size_t count = 0;
+
+  void startObject() override {
+    count++;
+  }
+  void endObject() override {
+    count++;
+  }
+  void startArray() override {
+    count++;
+  }
+  void endArray() override {
+    count++;
+  }
+  void key(JsonString) override {
+    count++;
+  }
+  void value(JsonVariantConst) override {
+    count++;
+  }
+};
+
+// Simulates a network stream, like WiFiClient, where each call has a fixed
+// cost whatever the number of bytes
+class LatencyStream : public Stream {
+ public:
+  LatencyStream(const std::string& content, long latencyNs = 1000)
+      : _content(content), _position(0), _latency(latencyNs) {}
+
+  int available() {
+    wait();
+    return int(_content.size() - _position);
+  }
+
+  int read() {
+    wait();
+    if (_position >= _content.size())
+      return -1;
+    return static_cast<unsigned char>(_content[_position++]);
+  }
+
+  size_t readBytes(char* buffer, size_t length) {
+    wait();
+    size_t n = std::min(length, _content.size() - _position);
+    memcpy(buffer, _content.data() + _position, n);
+    _position += n;
+    return n;
+  }
+
+ private:
+  void wait() const {
+    Clock::time_point end = Clock::now() + std::chrono::nanoseconds(_latency);
+    while (Clock::now() < end) {
+    }
+  }
+
+  const std::string& _content;
+  size_t _position;
+  long _latency;
+};
+
+void benchmark(const Options& options, const Document& document,
+               std::vector<Result>& results) {
+  const size_t capacity =
+      document.capacity ? document.capacity : options.capacity;
+
+  results.push_back(run(options, document, "deserialize", [&]() {
+    BenchmarkDocument doc(capacity);
+    DeserializationError err = deserialize(doc, document);
+    return Outcome(document.content.size(), doc, err);
+  }));
+
+  results.push_back(run(options, document, "growable", [&]() {
+    GrowableBenchmarkDocument doc(options.blockSize);
+    DeserializationError err = deserialize(doc, document);
+    return Outcome(document.content.size(), doc, err);
+  }));
+
+  GrowableBenchmarkDocument reused(options.blockSize);
+  results.push_back(run(options, document, "growable_reuse", [&]() {
+    DeserializationError err = deserialize(reused, document);
+    return Outcome(document.content.size(), reused, err);
+  }));
+
+  BenchmarkDocument filter(1024);
+  deserializeJson(filter, document.filter);
+  results.push_back(run(options, document, "filter", [&]() {
+    BenchmarkDocument doc(capacity);
+    DeserializationError err = deserialize(doc, document, filter);
+    return Outcome(document.content.size(), doc, err);
+  }));
+
+  if (document.format == JSON) {
+    // same input, but events instead of a tree; the strings are decoded in
+    // place so that their length isn't limited by the scratch buffer
+    std::vector<char> input(document.content.size() + 1);
+    results.push_back(run(options, document, "events", [&]() {
+      memcpy(input.data(), document.content.data(), document.content.size());
+      input.back() = 0;
+      EventCounter counter;
+      DeserializationError err = deserializeJson(counter, input.data());
+      return Outcome(counter.count ? document.content.size() : 0, 0, err);
+    }));
+  }
+
+  // same input through a Stream that costs 1 us per call; the input is read
+  // one byte at a time, or by blocks when its size is known
+  results.push_back(run(options, document, "stream", [&]() {
+    LatencyStream stream(document.content);
+    BenchmarkDocument doc(capacity);
+    DeserializationError err = document.format == JSON
+                                   ? deserializeJson(doc, stream)
+                                   : deserializeMsgPack(doc, stream);
+    return Outcome(document.content.size(), doc, err);
+  }));
+
+  results.push_back(run(options, document, "stream_sized", [&]() {
+    LatencyStream stream(document.content);
+    BenchmarkDocument doc(capacity);
+    size_t size = document.content.size();
+    DeserializationError err = document.format == JSON
+                                   ? deserializeJson(doc, stream, size)
+                                   : deserializeMsgPack(doc, stream, size);
+    return Outcome(size, doc, err);
+  }));
+
+  // the other benchmarks start from the parsed document
+  BenchmarkDocument source(capacity);
+  deserialize(source, document);
+  std::vector<char> buffer(2 * document.content.size() + 1024);
+
+  if (document.format == JSON) {
+    results.push_back(run(options, document, "serialize", [&]() {
+      size_t n = serializeJson(source, buffer.data(), buffer.size());
+      return Outcome(n, source.memoryUsage());
+    }));
+
+    results.push_back(run(options, document, "measure", [&]() {
+      return Outcome(measureJson(source), source.memoryUsage());
+    }));
+
+    // same output, appended to a string instead of a buffer
+    results.push_back(run(options, document, "serialize_string", [&]() {
+      std::string output;
+      size_t n = serializeJson(source, output);
+      return Outcome(n, source.memoryUsage());
+    }));
+
+    results.push_back(run(options, document, "serialize_arduino_string", [&]() {
+      ::String output;
+      output.limitCapacityTo(buffer.size());
+      size_t n = serializeJson(source, output);
+      return Outcome(n, source.memoryUsage());
+    }));
+
+    // to send a Content-Length: measure, allocate, then serialize again...
+    results.push_back(run(options, document, "measure_serialize", [&]() {
+      size_t n = measureJson(source);
+      char* output = static_cast<char*>(CountingAllocator().allocate(n + 1));
+      n = serializeJson(source, output, n + 1);
+      CountingAllocator().deallocate(output);
+      return Outcome(n, source.memoryUsage());
+    }));
+
+    // ...or serialize once in chunks, and get the length at the end
+    results.push_back(run(options, document, "serialize_chunked", [&]() {
+      BasicChunkedBuffer<CountingAllocator> output(512);
+      size_t n = serializeJson(source, output);
+      return Outcome(output.overflowed() ? 0 : n, source.memoryUsage());
+    }));
+
+    if (source.is<JsonObject>()) {
+      // same access pattern as fetch_settings(): containsKey(), then []
+      std::vector<std::string> keys;
+      size_t keyBytes = 0;
+      for (JsonPair kv : source.as<JsonObject>()) {
+        keys.push_back(kv.key().c_str());
+        keyBytes += kv.key().size();
+      }
+      JsonObjectConst object = source.as<JsonObjectConst>();
+      results.push_back(run(options, document, "lookup", [&]() {
+        size_t found = 0;
+        for (size_t i = 0; i < keys.size(); i++) {
+          const char* key = keys[i].c_str();
+          if (object.containsKey(key) && !object[key].isNull())
+            found++;
+        }
+        return Outcome(found == keys.size() ? keyBytes : 0, 0);
+      }));
+    }
+  } else {
+    results.push_back(run(options, document, "serialize", [&]() {
+      size_t n = serializeMsgPack(source, buffer.data(), buffer.size());
+      return Outcome(n, source.memoryUsage());
+    }));
+
+    results.push_back(run(options, document, "measure", [&]() {
+      return Outcome(measureMsgPack(source), source.memoryUsage());
+    }));
+  }
+
+  results.push_back(run(options, document, "msgpack_roundtrip", [&]() {
+    size_t n = serializeMsgPack(source, buffer.data(), buffer.size());
+    BenchmarkDocument doc(capacity);
+    DeserializationError err = deserializeMsgPack(doc, buffer.data(), n);
+    return Outcome(n, doc, err);
+  }));
+}
+
+// Body of a POST /SQM request, as built by post_data()
+std::string sqmDocument() {
+  return "{\"raining\":\"0\",\"luminosity\":\"21.57\",\"seeing\":\"2.85\","
+         "\"nelm\":\"6.14\",\"concentration\":\"12\",\"object\":\"-17.43\","
+         "\"ambient\":\"8.91\",\"lux\":\"0.00\","
+         "\"lightning_distanceToStorm\":\"0\",\"errors\":\"\","
+         "\"isSeeing\":\"1\"}";
+}
+
+// A night of readings, one every ten minutes, with numeric values
+std::string sqmBatchDocument() {
+  DynamicJsonDocument doc(65536);
+  for (int i = 0; i < 72; i++) {
+    JsonObject reading = doc.createNestedObject();
+    reading["raining"] = i % 17 == 0;
+    reading["luminosity"] = 21.57 - 0.013 * i;
+    reading["seeing"] = 2.85 + 0.05 * (i % 7);
+    reading["nelm"] = 6.14 - 0.002 * i;
+    reading["concentration"] = 12 + i % 5;
+    reading["object"] = -17.43 + 0.11 * (i % 9);
+    reading["ambient"] = 8.91 - 0.021 * i;
+    reading["lux"] = 0.0001 * (i % 3);
+    reading["lightning_distanceToStorm"] = 0;
+    reading["errors"] = i % 23 == 0 ? "TSL2591, " : "";
+    reading["isSeeing"] = true;
+  }
+  std::string json;
+  serializeJson(doc, json);
+  return json;
+}
+
+// Readings as sent by post_data(), with all values as strings, so most values
+// are distinct; used to see how parsing scales with the number of strings
+std::string sqmRecordsDocument(int count) {
+  DynamicJsonDocument doc(size_t(count) * 1024);
+  char value[16];
+  for (int i = 0; i < count; i++) {
+    JsonObject reading = doc.createNestedObject();
+    reading["raining"] = i % 17 == 0 ? "1" : "0";
+    snprintf(value, sizeof(value), "%.2f", 21.57 - 0.0013 * i);
+    reading["luminosity"] = value;
+    snprintf(value, sizeof(value), "%.2f", 6.14 - 0.0002 * i);
+    reading["nelm"] = value;
+    snprintf(value, sizeof(value), "%.2f", -17.43 + 0.011 * i);
+    reading["object"] = value;
+    snprintf(value, sizeof(value), "%.2f", 8.91 - 0.0021 * i);
+    reading["ambient"] = value;
+    snprintf(value, sizeof(value), "%d", 1650000000 + 600 * i);
+    reading["time"] = value;
+    reading["errors"] = i % 23 == 0 ? "TSL2591, " : "";
+  }
+  std::string json;
+  serializeJson(doc, json);
+  return json;
+}
+
+// An object with many members, like the ones of the server-side tools
+std::string largeObjectDocument(int count) {
+  DynamicJsonDocument doc(size_t(count) * 128);
+  char key[32];
+  for (int i = 0; i < count; i++) {
+    snprintf(key, sizeof(key), "sensor_%03d_threshold", i);
+    doc[key] = 0.5 * i;
+  }
+  std::string json;
+  serializeJson(doc, json);
+  return json;
+}
+
+// Messages of a log, mostly plain text, with a few quotes and line breaks
+std::string logMessagesDocument(int count) {
+  DynamicJsonDocument doc(size_t(count) * 512);
+  char message[160];
+  for (int i = 0; i < count; i++) {
+    JsonObject entry = doc.createNestedObject();
+    entry["level"] = i % 13 == 0 ? "warning" : "info";
+    snprintf(message, sizeof(message),
+             "Reading %d: sky quality %.2f mag/arcsec2, luminosity %.4f lux, "
+             "ambient temperature %.1f C%s",
+             i, 21.57 - 0.0013 * i, 0.0001 * (i % 7), 8.91 - 0.021 * i,
+             i % 13 == 0 ? "\nsensor \"TSL2591\" saturated, gain reduced"
+                         : ", all sensors OK");
+    entry["message"] = message;
+  }
+  std::string json;
+  serializeJson(doc, json);
+  return json;
+}
+
+// Rows of [timestamp, raw counts of the sensors, lightning distance], like the
+// history the firmware could upload in a single request
+std::string telemetryDocument(int count) {
+  DynamicJsonDocument doc(size_t(count) * 160);
+  for (int i = 0; i < count; i++) {
+    JsonArray row = doc.createNestedArray();
+    row.add(1650000000L + 600L * i);
+    row.add(37 + (i * 7919) % 65536);    // TSL2591 full spectrum
+    row.add(5 + (i * 104729) % 4096);    // TSL2591 infrared
+    row.add(-1743 + (i * 31) % 500);     // object temperature, in 1/100 C
+    row.add(891 - (i * 17) % 1200);      // ambient temperature, in 1/100 C
+    row.add(i % 37 == 0 ? 12 : 0);       // lightning distance, in km
+  }
+  std::string json;
+  serializeJson(doc, json);
+  return json;
+}
+
+std::string toMsgPack(const std::string& json) {
+  DynamicJsonDocument doc(json.size() * 4);
+  deserializeJson(doc, json);
+  std::string msgpack;
+  serializeMsgPack(doc, msgpack);
+  return msgpack;
+}
+
+// Response of GET /getsettings, as read by fetch_settings()
+std::string getSettingsDocument() {
+  return "{\"seeing_thr\":3,\"setpoint1\":22.0,\"setpoint2\":21.0,"
+         "\"max_lux\":50.0,\"SLEEPTIME_s\":300,\"DISPLAY_TIMEOUT_s\":30,"
+         "\"DISPLAY_ON\":1,\"set_sqm_limit\":21.5}";
+}
+
+void addSyntheticDocuments(std::vector<Document>& documents) {
+  Document sqm = {"sqm", JSON, sqmDocument(),
+                  "{\"luminosity\":true,\"nelm\":true,\"errors\":true}",
+                  1024};
+  Document batch = {"sqm_batch", JSON, sqmBatchDocument(),
+                    "[{\"luminosity\":true,\"nelm\":true}]", 32768};
+  Document settings = {"getsettings", JSON, getSettingsDocument(),
+                       "{\"SLEEPTIME_s\":true,\"set_sqm_limit\":true}",
+                       2048};
+  documents.push_back(sqm);
+  documents.push_back(batch);
+  documents.push_back(settings);
+
+  Document largeObject = {"large_object", JSON, largeObjectDocument(300),
+                          "{\"sensor_150_threshold\":true}", 32768};
+  documents.push_back(largeObject);
+
+  Document log = {"log_messages", JSON, logMessagesDocument(200),
+                  "[{\"level\":true}]", 65536};
+  documents.push_back(log);
+
+  Document telemetry = {"telemetry", JSON, telemetryDocument(200), "[false]",
+                        65536};
+  documents.push_back(telemetry);
+
+  // the same in MessagePack
+  Document logMsgPack = {"log_messages_msgpack", MSGPACK,
+                         toMsgPack(log.content), "[{\"level\":true}]", 65536};
+  documents.push_back(logMsgPack);
+  Document telemetryMsgPack = {"telemetry_msgpack", MSGPACK,
+                               toMsgPack(telemetry.content), "[false]", 65536};
+  documents.push_back(telemetryMsgPack);
+
+  for (int count = 10; count <= 1000; count *= 10) {
+    Document records = {"sqm_records_" + std::to_string(count), JSON,
+                        sqmRecordsDocument(count),
+                        "[{\"luminosity\":true,\"time\":true}]",
+                        size_t(count) * 512 + 4096};
+    documents.push_back(records);
+  }
+}
+
+bool endsWith(const std::string& s, const char* suffix) {
+  size_t n = strlen(suffix);
+  return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+
+bool loadFile(const char* path, std::vector<Document>& documents) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file)
+    return false;
+  std::ostringstream content;
+  content << file.rdbuf();
+
+  std::string name = path;
+  size_t slash = name.find_last_of("/\\");
+  if (slash != std::string::npos)
+    name = name.substr(slash + 1);
+
+  // the filter skips everything, which measures how fast values are skipped
+  Document document = {name, endsWith(name, ".json") ? JSON : MSGPACK,
+                       content.str(), "{\"*\":false}", 0};
+  documents.push_back(document);
+  return true;
+}
+
+void writeResults(const Options& options, const std::vector<Result>& results) {
+  DynamicJsonDocument doc(1024 + 768 * results.size());
+  doc["version"] = ARDUINOJSON_VERSION;
+  doc["capacity"] = options.capacity;
+  doc["block_size"] = options.blockSize;
+  JsonObject config = doc.createNestedObject("config");
+  config["use_double"] = ARDUINOJSON_USE_DOUBLE;
+  config["use_long_long"] = ARDUINOJSON_USE_LONG_LONG;
+  config["fast_float_parsing"] = ARDUINOJSON_ENABLE_FAST_FLOAT_PARSING;
+  config["shortest_float_format"] = ARDUINOJSON_USE_SHORTEST_FLOAT_FORMAT;
+  config["iterative_parsing"] = ARDUINOJSON_ENABLE_ITERATIVE_PARSING;
+
+  JsonArray array = doc.createNestedArray("results");
+  for (size_t i = 0; i < results.size(); i++) {
+    const Result& r = results[i];
+    JsonObject obj = array.createNestedObject();
+    obj["document"] = r.document;
+    obj["format"] = r.format == JSON ? "json" : "msgpack";
+    obj["operation"] = r.operation;
+    obj["bytes"] = r.bytes;
+    obj["iterations"] = r.iterations;
+    obj["ns_per_op"] = r.nsPerOp;
+    obj["mb_per_s"] = r.nsPerOp > 0 ? double(r.bytes) * 1e3 / r.nsPerOp : 0;
+    obj["allocations"] = r.allocations;
+    obj["allocated_bytes"] = r.allocatedBytes;
+    obj["peak_heap"] = r.peakHeap;
+    obj["peak_pool"] = r.peakPool;
+    obj["slots"] = r.pool.slots;
+    obj["strings"] = r.pool.strings;
+    obj["string_bytes"] = r.pool.stringBytes;
+    obj["dedup_hits"] = r.pool.dedupHits;
+    obj["blocks"] = r.pool.blocks;
+    obj["overflows"] = r.pool.overflows;
+    if (r.overBudget)
+      obj["over_budget"] = true;
+    obj["stack"] = r.stack;
+    if (r.error)
+      obj["error"] = r.error.c_str();
+  }
+
+  if (options.output) {
+    std::ofstream file(options.output);
+    serializeJsonPretty(doc, file);
+  } else {
+    std::string json;
+    serializeJsonPretty(doc, json);
+    puts(json.c_str());
+  }
+}
+
+// Returns the number of results over budget
+int printSummary(const std::vector<Result>& results) {
+  int overBudget = 0;
+  fprintf(stderr, "%-26s %-24s %10s %12s %8s %10s %8s %8s\n", "document",
+          "operation", "MB/s", "ns/op", "allocs", "peak pool", "dedup",
+          "stack");
+  for (size_t i = 0; i < results.size(); i++) {
+    const Result& r = results[i];
+    double mbps = r.nsPerOp > 0 ? double(r.bytes) * 1e3 / r.nsPerOp : 0;
+    fprintf(stderr, "%-26s %-24s %10.1f %12.1f %8zu %10zu %8zu %8zu%s\n",
+            r.document.c_str(), r.operation.c_str(), mbps, r.nsPerOp,
+            r.allocations, r.peakPool, r.pool.dedupHits, r.stack,
+            r.overBudget ? "  OVER BUDGET" : "");
+    if (r.overBudget)
+      overBudget++;
+  }
+  return overBudget;
+}
+
+bool loadResults(const char* path, JsonDocument& doc) {
+  std::ifstream file(path);
+  DeserializationError err = deserializeJson(doc, file);
+  if (err) {
+    fprintf(stderr, "%s: %s\n", path, err.c_str());
+    return false;
+  }
+  return true;
+}
+
+JsonObject findResult(JsonArray results, JsonObject needle) {
+  for (JsonArray::iterator it = results.begin(); it != results.end(); ++it) {
+    JsonObject candidate = it->as<JsonObject>();
+    if (candidate["document"] == needle["document"] &&
+        candidate["operation"] == needle["operation"])
+      return candidate;
+  }
+  return JsonObject();
+}
+
+int compare(const char* baselinePath, const char* currentPath,
+            double threshold) {
+  DynamicJsonDocument baseline(1 << 20), current(1 << 20);
+  if (!loadResults(baselinePath, baseline) ||
+      !loadResults(currentPath, current))
+    return 2;
+
+  int regressions = 0;
+  printf("%-26s %-24s %10s %10s %8s %s\n", "document", "operation", "before",
+         "after", "change", "allocs");
+  JsonArray currentResults = current["results"];
+  for (JsonArray::iterator it = currentResults.begin();
+       it != currentResults.end(); ++it) {
+    JsonObject after = it->as<JsonObject>();
+    JsonObject before = findResult(baseline["results"], after);
+    if (before.isNull())
+      continue;
+
+    double speedBefore = before["mb_per_s"];
+    double speedAfter = after["mb_per_s"];
+    double change =
+        speedBefore > 0 ? (speedAfter / speedBefore - 1) * 100 : 0;
+    size_t allocsBefore = before["allocated_bytes"];
+    size_t allocsAfter = after["allocated_bytes"];
+    // older results don't have the pool counters
+    size_t poolBefore = before["peak_pool"];
+    size_t poolAfter = after["peak_pool"];
+
+    bool slower = change < -threshold;
+    bool bigger = allocsAfter > allocsBefore || poolAfter > poolBefore;
+    if (slower || bigger)
+      regressions++;
+
+    printf("%-26s %-24s %10.1f %10.1f %+7.1f%% %zu -> %zu bytes%s\n",
+           after["document"].as<const char*>(),
+           after["operation"].as<const char*>(), speedBefore, speedAfter,
+           change, allocsBefore, allocsAfter,
+           slower || bigger ? "  REGRESSION" : "");
+  }
+
+  printf("%d regression(s)\n", regressions);
+  return regressions ? 1 : 0;
+}
+
+// An archived station log, one reading per line
+std::string ndjsonLog(long count) {
+  std::string log;
+  log.reserve(size_t(count) * 160);
+  char line[256];
+  for (long i = 0; i < count; i++) {
+    snprintf(line, sizeof(line),
+             "{\"time\":%ld,\"sqm\":%.2f,\"nelm\":%.2f,\"object\":%.2f,"
+             "\"ambient\":%.2f,\"lux\":%.2f,\"raining\":%d,"
+             "\"errors\":\"%s\"}\n",
+             1650000000L + 60L * i, 17 + double(i % 500) / 100,
+             4 + double(i % 300) / 100, -20 + double(i % 400) / 10,
+             5 + double(i % 200) / 10, double(i % 1000) / 10, int(i % 97 == 0),
+             i % 1013 == 0 ? "TSL2591" : "");
+    log += line;
+  }
+  return log;
+}
+
+struct NdjsonResult {
+  long records;
+  double seconds;
+};
+
+// Baseline: finds each line, then parses it into a new document
+NdjsonResult parseLinesOneByOne(const char* begin, const char* end) {
+  NdjsonResult result = {0, 0};
+  while (begin < end) {
+    const char* eol = static_cast<const char*>(
+        memchr(begin, '\n', size_t(end - begin)));
+    if (!eol)
+      eol = end;
+    DynamicJsonDocument doc(1024);
+    if (!deserializeJson(doc, begin, size_t(eol - begin)))
+      result.records++;
+    begin = eol + 1;
+  }
+  return result;
+}
+
+// Reads the lines with one JsonSequence, into the same document
+NdjsonResult parseSequence(const char* begin, const char* end) {
+  NdjsonResult result = {0, 0};
+  DynamicJsonDocument doc(1024);
+  JsonSequence<const char*> records(doc, begin, size_t(end - begin));
+  DeserializationError err;
+  while ((err = records.next()) != DeserializationError::EmptyInput) {
+    if (!err)
+      result.records++;
+  }
+  return result;
+}
+
+// Splits the input at newlines, then parses the shards in parallel
+NdjsonResult parseShards(const char* begin, const char* end, unsigned count) {
+  std::vector<const char*> bounds(1, begin);
+  for (unsigned i = 1; i < count; i++) {
+    const char* p = begin + size_t(end - begin) * i / count;
+    if (p < bounds.back())
+      p = bounds.back();
+    const char* eol = static_cast<const char*>(
+        memchr(p, '\n', size_t(end - p)));
+    bounds.push_back(eol ? eol + 1 : end);
+  }
+  bounds.push_back(end);
+
+  std::vector<NdjsonResult> results(count);
+  std::vector<std::thread> threads;
+  for (unsigned i = 0; i < count; i++) {
+    threads.push_back(std::thread([&results, &bounds, i]() {
+      results[i] = parseSequence(bounds[i], bounds[i + 1]);
+    }));
+  }
+  NdjsonResult total = {0, 0};
+  for (unsigned i = 0; i < count; i++) {
+    threads[i].join();
+    total.records += results[i].records;
+  }
+  return total;
+}
+
+template <typename TParse>
+void benchmarkNdjson(const char* name, const std::string& log, long expected,
+                     TParse parse) {
+  NdjsonResult result = {0, 0};
+  double best = 0;
+  for (int round = 0; round < 3; round++) {
+    Clock::time_point start = Clock::now();
+    result = parse(log.data(), log.data() + log.size());
+    double seconds =
+        std::chrono::duration<double>(Clock::now() - start).count();
+    if (round == 0 || seconds < best)
+      best = seconds;
+  }
+  printf("%-16s %10ld records %8.3f s %12.0f records/s %8.1f MB/s%s\n", name,
+         result.records, best, double(result.records) / best,
+         double(log.size()) / best / 1e6,
+         result.records == expected ? "" : "  MISSING RECORDS");
+}
+
+// Decodes a generated log of station readings, one per line, like the ingest
+// tool does with the archived logs
+int runNdjson(long count, unsigned threads) {
+  std::string log = ndjsonLog(count);
+  printf("%ld records, %.1f MB, %u threads\n", count,
+         double(log.size()) / 1e6, threads);
+  benchmarkNdjson("line_by_line", log, count, parseLinesOneByOne);
+  benchmarkNdjson("sequence", log, count, parseSequence);
+  benchmarkNdjson("sequence_threads", log, count,
+                  [threads](const char* begin, const char* end) {
+                    return parseShards(begin, end, threads);
+                  });
+  return 0;
+}
+
+int usage() {
+  fputs(
+      "usage: benchmarks [--min-time <ms>] [--rounds <n>] "
+      "[--capacity <bytes>] [--block-size <bytes>] [--output <file>] "
+      "[files...]\n"
+      "       benchmarks --compare <baseline.json> <current.json> "
+      "[--threshold <percent>]\n"
+      "       benchmarks --ndjson <records> [--threads <n>]\n",
+      stderr);
+  return 2;
+}
+
+}  // namespace
+
+int main(int argc, const char* argv[]) {
+  Options options = {200, 5, 16384, 512, 0};
+  const char* compareWith[2] = {0, 0};
+  double threshold = 5;
+  long ndjsonRecords = 0;
+  unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+  std::vector<Document> documents;
+  addSyntheticDocuments(documents);
+
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--min-time" && hasValue) {
+      options.minTime = atof(argv[++i]);
+    } else if (arg == "--rounds" && hasValue) {
+      options.rounds = atoi(argv[++i]);
+    } else if (arg == "--capacity" && hasValue) {
+      options.capacity = size_t(atol(argv[++i]));
+    } else if (arg == "--block-size" && hasValue) {
+      options.blockSize = size_t(atol(argv[++i]));
+    } else if (arg == "--output" && hasValue) {
+      options.output = argv[++i];
+    } else if (arg == "--threshold" && hasValue) {
+      threshold = atof(argv[++i]);
+    } else if (arg == "--ndjson" && hasValue) {
+      ndjsonRecords = atol(argv[++i]);
+    } else if (arg == "--threads" && hasValue) {
+      threads = unsigned(std::max(1, atoi(argv[++i])));
+    } else if (arg == "--compare" && i + 2 < argc) {
+      compareWith[0] = argv[++i];
+      compareWith[1] = argv[++i];
+    } else if (arg.compare(0, 2, "--") == 0) {
+      return usage();
+    } else if (!loadFile(argv[i], documents)) {
+      fprintf(stderr, "%s: cannot read file\n", argv[i]);
+      return 2;
+    }
+  }
+
+  if (compareWith[0])
+    return compare(compareWith[0], compareWith[1], threshold);
+
+  if (ndjsonRecords > 0)
+    return runNdjson(ndjsonRecords, threads);
+
+  if (options.rounds < 1)
+    options.rounds = 1;
+
+  std::vector<Result> results;
+  for (size_t i = 0; i < documents.size(); i++)
+    benchmark(options, documents[i], results);
+
+  int overBudget = printSummary(results);
+  writeResults(options, results);
+  if (overBudget)
+    fprintf(stderr, "%d result(s) over budget\n", overBudget);
+  return overBudget ? 1 : 0;
+}
@@ -0,0 +1,285 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <stdlib.h>  // malloc, free
+#include <catch.hpp>
+#include <string>
+
+// Carves the blocks from a single buffer, because VariantSlot can only link
+// slots that are close enough, which separate calls to malloc() don't
+// guarantee (with AddressSanitizer for example)
+class BlockArena {
+ public:
+  BlockArena()
+      : allocated(0),
+        freed(0),
+        failAfter(-1),
+        _buffer(static_cast<char*>(malloc(capacity))),
+        _used(0) {}
+
+  ~BlockArena() {
+    free(_buffer);
+  }
+
+  void* allocate(size_t n) {
+    n = ARDUINOJSON_NAMESPACE::addPadding(n);
+    if (allocated == failAfter || _used + n > capacity)
+      return 0;
+    allocated++;
+    void* p = _buffer + _used;
+    _used += n;
+    return p;
+  }
+
+  int allocated;
+  int freed;
+  int failAfter;  // number of blocks before the allocations fail
+
+ private:
+  static const size_t capacity = 65536;
+
+  char* _buffer;
+  size_t _used;
+};
+
+class CountingAllocator {
+ public:
+  CountingAllocator(BlockArena& arena) : _arena(&arena) {}
+
+  void* allocate(size_t n) {
+    return _arena->allocate(n);
+  }
+
+  void deallocate(void*) {
+    _arena->freed++;
+  }
+
+  void* reallocate(void*, size_t) {
+    return 0;
+  }
+
+ private:
+  BlockArena* _arena;
+};
+
+typedef BasicGrowableJsonDocument<CountingAllocator> CountingJsonDocument;
+
+static std::string longString(size_t n) {
+  return std::string(n, '*');
+}
+
+TEST_CASE("GrowableJsonDocument") {
+  BlockArena arena;
+
+  SECTION("Construct/Destruct") {
+    { CountingJsonDocument doc(256, arena); }
+
+    REQUIRE(arena.allocated == 1);
+    REQUIRE(arena.freed == 1);
+  }
+
+  SECTION("capacity() of a new document") {
+    CountingJsonDocument doc(256, arena);
+
+    REQUIRE(doc.capacity() == 256);
+    REQUIRE(doc.blockCount() == 1);
+    REQUIRE(doc.memoryUsage() == 0);
+  }
+
+  SECTION("chains blocks instead of overflowing") {
+    CountingJsonDocument doc(64, arena);
+    DynamicJsonDocument expected(4096);
+
+    for (int i = 0; i < 50; i++) {
+      doc.add(i);
+      expected.add(i);
+    }
+
+    REQUIRE(doc.overflowed() == false);
+    REQUIRE(doc.size() == 50);
+    REQUIRE(doc == expected);
+    REQUIRE(doc.memoryUsage() == expected.memoryUsage());
+    REQUIRE(doc.blockCount() > 1);
+    REQUIRE(doc.capacity() >= doc.memoryUsage());
+  }
+
+  SECTION("string longer than a block") {
+    CountingJsonDocument doc(64, arena);
+    std::string json = "[\"" + longString(300) + "\",\"" + longString(200) +
+                       "\",\"" + longString(300) + "\"]";
+
+    DeserializationError err = deserializeJson(doc, json);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc[0] == longString(300));
+    REQUIRE(doc[1] == longString(200));
+    REQUIRE(doc[2] == longString(300));
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(3) + JSON_STRING_SIZE(300) +
+                                     JSON_STRING_SIZE(200));  // deduplicated
+  }
+
+  SECTION("deduplicates the strings of the previous blocks") {
+    CountingJsonDocument doc(64, arena);
+
+    for (int i = 0; i < 20; i++)
+      doc.createNestedObject()[std::string("sensor")] =
+          std::string("temperature");
+
+    REQUIRE(doc.blockCount() > 1);
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(20) + 20 * JSON_OBJECT_SIZE(1) +
+                                     JSON_STRING_SIZE(6) +
+                                     JSON_STRING_SIZE(11));
+  }
+
+  SECTION("matches DynamicJsonDocument") {
+    CountingJsonDocument doc(48, arena);
+    DynamicJsonDocument expected(4096);
+    const char* json =
+        "{\"config\":{\"name\":\"sqm\",\"values\":[1,2.5,true,null,\"x\"]},"
+        "\"readings\":[{\"lux\":0.12,\"sqm\":21.3},{\"lux\":0.13,"
+        "\"sqm\":21.25}],\"comment\":\"a string that is longer than a block\"}";
+
+    REQUIRE(deserializeJson(doc, json) == DeserializationError::Ok);
+    REQUIRE(deserializeJson(expected, json) == DeserializationError::Ok);
+
+    REQUIRE(doc == expected);
+    REQUIRE(doc.memoryUsage() == expected.memoryUsage());
+  }
+
+  SECTION("overflows when the allocator fails") {
+    arena.failAfter = 2;
+    CountingJsonDocument doc(64, arena);
+
+    DeserializationError err =
+        deserializeJson(doc, "[1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16]");
+
+    REQUIRE(err == DeserializationError::NoMemory);
+    REQUIRE(arena.allocated == 2);
+  }
+
+  SECTION("first block can't be allocated") {
+    arena.failAfter = 0;
+    CountingJsonDocument doc(64, arena);
+
+    REQUIRE(doc.capacity() == 0);
+    REQUIRE(doc.add(1) == false);
+    REQUIRE(doc.overflowed() == true);
+  }
+
+  SECTION("clear() releases all the blocks but the first") {
+    CountingJsonDocument doc(64, arena);
+    for (int i = 0; i < 50; i++)
+      doc.add(i);
+    int blocks = arena.allocated;
+
+    doc.clear();
+
+    REQUIRE(doc.blockCount() == 1);
+    REQUIRE(doc.capacity() == 64);
+    REQUIRE(arena.freed == blocks - 1);
+  }
+
+  SECTION("Copy construct") {
+    CountingJsonDocument doc1(64, arena);
+    doc1["hello"] = longString(100);
+
+    CountingJsonDocument doc2(doc1);
+
+    REQUIRE(doc2["hello"] == longString(100));
+    REQUIRE(doc2.blockSize() == 64);
+  }
+
+#if ARDUINOJSON_HAS_RVALUE_REFERENCES
+  SECTION("Move construct") {
+    {
+      CountingJsonDocument doc1(64, arena);
+      doc1["hello"] = longString(100);
+
+      CountingJsonDocument doc2(std::move(doc1));
+
+      REQUIRE(doc2["hello"] == longString(100));
+      doc2["world"] = longString(100);  // still growable
+      REQUIRE(doc2["world"] == longString(100));
+    }
+    REQUIRE(arena.freed == arena.allocated);
+  }
+#endif
+
+  SECTION("garbageCollect()") {
+    CountingJsonDocument doc(64, arena);
+    doc["a"] = longString(100);
+    doc["b"] = 1;
+    doc.remove("a");
+
+    REQUIRE(doc.garbageCollect() == true);
+
+    REQUIRE(doc.as<std::string>() == "{\"b\":1}");
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(1));
+  }
+}
+
+TEST_CASE("JsonDocument::mark() and rewind()") {
+  BlockArena arena;
+
+  SECTION("GrowableJsonDocument") {
+    CountingJsonDocument doc(64, arena);
+    doc["device"] = std::string("sqm");
+    JsonDocumentMark mark = doc.mark();
+    size_t usage = doc.memoryUsage();
+
+    for (int cycle = 0; cycle < 3; cycle++) {
+      doc["lux"] = 0.5;
+      doc["comment"] = longString(200);
+      REQUIRE(doc.size() == 3);
+
+      doc.rewind(mark);
+
+      REQUIRE(doc.as<std::string>() == "{\"device\":\"sqm\"}");
+      REQUIRE(doc.memoryUsage() == usage);
+      REQUIRE(doc.blockCount() == 1);
+    }
+    REQUIRE(arena.freed == arena.allocated - 1);
+  }
+
+  SECTION("StaticJsonDocument") {
+    StaticJsonDocument<256> doc;
+    doc.add(1);
+    JsonDocumentMark mark = doc.mark();
+
+    doc.add(std::string("hello"));
+    doc.add(3);
+    doc.rewind(mark);
+    doc.add(2);
+
+    REQUIRE(doc.as<std::string>() == "[1,2]");
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(2));
+  }
+
+  SECTION("restores the overflow flag") {
+    StaticJsonDocument<JSON_ARRAY_SIZE(1)> doc;
+    JsonDocumentMark mark = doc.mark();
+    doc.add(1);
+    doc.add(2);
+    REQUIRE(doc.overflowed() == true);
+
+    doc.rewind(mark);
+
+    REQUIRE(doc.overflowed() == false);
+    REQUIRE(doc.isNull());
+  }
+}
+
+TEST_CASE("JsonDocument::peakMemoryUsage()") {
+  StaticJsonDocument<256> doc;
+  doc.add(1);
+  doc.add(2);
+  size_t peak = doc.memoryUsage();
+
+  doc.clear();
+  doc.add(1);
+
+  REQUIRE(doc.peakMemoryUsage() == peak);
+  REQUIRE(doc.memoryUsage() < peak);
+}
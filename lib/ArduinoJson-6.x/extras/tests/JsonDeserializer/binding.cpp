@@ -0,0 +1,227 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+
+namespace {
+struct Settings {
+  int seeing_thr;
+  double setpoint1;
+  float max_lux;
+  bool display_on;
+  long sleeptime;
+  char name[8];
+};
+
+const JsonField<Settings> settingsFields[] = {
+    JsonField<Settings>("seeing_thr", &Settings::seeing_thr),
+    JsonField<Settings>("setpoint1", &Settings::setpoint1),
+    JsonField<Settings>("max_lux", &Settings::max_lux),
+    JsonField<Settings>("DISPLAY_ON", &Settings::display_on),
+    JsonField<Settings>("SLEEPTIME_s", &Settings::sleeptime),
+    JsonField<Settings>("name", &Settings::name),
+};
+
+void resetSettings(Settings& s) {
+  s.seeing_thr = -1;
+  s.setpoint1 = -1;
+  s.max_lux = -1;
+  s.display_on = false;
+  s.sleeptime = -1;
+  strcpy(s.name, "none");
+}
+}  // namespace
+
+TEST_CASE("deserializeJson() into a bound struct") {
+  Settings settings;
+  resetSettings(settings);
+
+  SECTION("all fields") {
+    DeserializationError err = deserializeJson(
+        settings, settingsFields,
+        "{\"seeing_thr\":12,\"setpoint1\":3.5,\"max_lux\":1e3,"
+        "\"DISPLAY_ON\":true,\"SLEEPTIME_s\":300,\"name\":\"sqm\"}");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(settings.seeing_thr == 12);
+    REQUIRE(settings.setpoint1 == 3.5);
+    REQUIRE(settings.max_lux == 1000.0f);
+    REQUIRE(settings.display_on == true);
+    REQUIRE(settings.sleeptime == 300);
+    REQUIRE(std::string(settings.name) == "sqm");
+  }
+
+  SECTION("missing keys leave the members unchanged") {
+    DeserializationError err =
+        deserializeJson(settings, settingsFields, "{\"setpoint1\":2}");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(settings.seeing_thr == -1);
+    REQUIRE(settings.setpoint1 == 2.0);
+    REQUIRE(std::string(settings.name) == "none");
+  }
+
+  SECTION("empty object") {
+    DeserializationError err =
+        deserializeJson(settings, settingsFields, " { } ");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(settings.seeing_thr == -1);
+  }
+
+  SECTION("unknown keys are skipped") {
+    DeserializationError err = deserializeJson(
+        settings, settingsFields,
+        "{\"a\":[1,{\"b\":[]}],\"seeing_thr\":5,\"c\":{\"seeing_thr\":6},"
+        "\"d\":\"seeing_thr\",\"e\":null,\"f\":false,\"g\":-1.5e3}");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(settings.seeing_thr == 5);
+  }
+
+  SECTION("last value wins when a key is repeated") {
+    DeserializationError err = deserializeJson(
+        settings, settingsFields, "{\"seeing_thr\":1,\"seeing_thr\":2}");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(settings.seeing_thr == 2);
+  }
+
+  SECTION("values are converted like JsonVariant::as<T>()") {
+    DeserializationError err = deserializeJson(
+        settings, settingsFields,
+        "{\"seeing_thr\":7.9,\"setpoint1\":\"x\",\"DISPLAY_ON\":1,"
+        "\"SLEEPTIME_s\":[1,2],\"name\":42}");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(settings.seeing_thr == 7);
+    REQUIRE(settings.setpoint1 == 0.0);
+    REQUIRE(settings.display_on == true);
+    REQUIRE(settings.sleeptime == 0);
+    REQUIRE(std::string(settings.name) == "");
+  }
+
+  SECTION("strings are truncated to the size of the array") {
+    DeserializationError err = deserializeJson(settings, settingsFields,
+                                               "{\"name\":\"0123456789\"}");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(std::string(settings.name) == "0123456");
+  }
+
+  SECTION("escaped keys") {
+    DeserializationError err = deserializeJson(settings, settingsFields,
+                                               "{\"seeing\\u005fthr\":3}");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(settings.seeing_thr == 3);
+  }
+
+  SECTION("key longer than ARDUINOJSON_SCRATCH_BUFFER_SIZE is skipped") {
+    std::string json = "{\"" + std::string(200, 'k') +
+                       "\":\"v\",\"seeing_thr\":4}";
+
+    DeserializationError err = deserializeJson(settings, settingsFields, json);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(settings.seeing_thr == 4);
+  }
+
+  SECTION("string longer than ARDUINOJSON_SCRATCH_BUFFER_SIZE") {
+    std::string json = "{\"name\":\"" + std::string(200, 'v') + "\"}";
+
+    DeserializationError err = deserializeJson(settings, settingsFields, json);
+
+    REQUIRE(err == DeserializationError::NoMemory);
+  }
+
+  SECTION("long string value of an unknown key") {
+    std::string json =
+        "{\"comment\":\"" + std::string(200, 'v') + "\",\"seeing_thr\":8}";
+
+    DeserializationError err = deserializeJson(settings, settingsFields, json);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(settings.seeing_thr == 8);
+  }
+
+  SECTION("root is not an object") {
+    REQUIRE(deserializeJson(settings, settingsFields, "[1]") ==
+            DeserializationError::InvalidInput);
+    REQUIRE(deserializeJson(settings, settingsFields, "null") ==
+            DeserializationError::InvalidInput);
+  }
+
+  SECTION("empty input") {
+    REQUIRE(deserializeJson(settings, settingsFields, "") ==
+            DeserializationError::EmptyInput);
+  }
+
+  SECTION("incomplete input") {
+    REQUIRE(deserializeJson(settings, settingsFields, "{\"seeing_thr\":1") ==
+            DeserializationError::IncompleteInput);
+    REQUIRE(deserializeJson(settings, settingsFields, "{\"a\":[1,") ==
+            DeserializationError::IncompleteInput);
+  }
+
+  SECTION("invalid input") {
+    REQUIRE(deserializeJson(settings, settingsFields, "{\"seeing_thr\"1}") ==
+            DeserializationError::InvalidInput);
+    REQUIRE(deserializeJson(settings, settingsFields, "{\"a\":1;}") ==
+            DeserializationError::InvalidInput);
+  }
+
+  SECTION("nesting limit") {
+    DeserializationOption::NestingLimit nesting(1);
+
+    REQUIRE(deserializeJson(settings, settingsFields, "{\"a\":1}", nesting) ==
+            DeserializationError::Ok);
+    REQUIRE(deserializeJson(settings, settingsFields, "{\"a\":[]}", nesting) ==
+            DeserializationError::TooDeep);
+  }
+}
+
+TEST_CASE("deserializeJson() into a bound struct, input types") {
+  Settings settings;
+  resetSettings(settings);
+
+  SECTION("std::string") {
+    std::string json("{\"seeing_thr\":1,\"name\":\"ab\"}");
+
+    REQUIRE(deserializeJson(settings, settingsFields, json) ==
+            DeserializationError::Ok);
+    REQUIRE(settings.seeing_thr == 1);
+    REQUIRE(std::string(settings.name) == "ab");
+  }
+
+  SECTION("std::istream") {
+    std::istringstream json("{\"seeing_thr\":2,\"name\":\"cd\"}");
+
+    REQUIRE(deserializeJson(settings, settingsFields, json) ==
+            DeserializationError::Ok);
+    REQUIRE(settings.seeing_thr == 2);
+    REQUIRE(std::string(settings.name) == "cd");
+  }
+
+  SECTION("char*, size_t") {
+    const char* json = "{\"seeing_thr\":3}garbage";
+
+    REQUIRE(deserializeJson(settings, settingsFields, json, 16) ==
+            DeserializationError::Ok);
+    REQUIRE(settings.seeing_thr == 3);
+  }
+
+  SECTION("mutable char* (zero-copy)") {
+    char json[] = "{\"seeing_thr\":4,\"name\":\"e\\u0066\"}";
+
+    REQUIRE(deserializeJson(settings, settingsFields, json) ==
+            DeserializationError::Ok);
+    REQUIRE(settings.seeing_thr == 4);
+    REQUIRE(std::string(settings.name) == "ef");
+  }
+}
@@ -0,0 +1,317 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+// Records the events as a string like "{ k:a [ 1 2 ] }"
+class EventRecorder : public JsonHandler {
+ public:
+  virtual void startObject() {
+    _events += "{ ";
+  }
+
+  virtual void endObject() {
+    _events += "} ";
+  }
+
+  virtual void startArray() {
+    _events += "[ ";
+  }
+
+  virtual void endArray() {
+    _events += "] ";
+  }
+
+  virtual void key(JsonString k) {
+    _events += std::string(k.c_str(), k.size()) + ":";
+  }
+
+  virtual void value(JsonVariantConst v) {
+    std::string s;
+    serializeJson(v, s);
+    _events += s + " ";
+  }
+
+  const std::string& events() const {
+    return _events;
+  }
+
+ private:
+  std::string _events;
+};
+
+// Produces the events that a document would generate
+void recordTree(JsonVariantConst v, EventRecorder& recorder) {
+  if (v.is<JsonObjectConst>()) {
+    recorder.startObject();
+    JsonObjectConst object = v.as<JsonObjectConst>();
+    for (JsonObjectConst::iterator it = object.begin(); it != object.end();
+         ++it) {
+      recorder.key(it->key());
+      recordTree(it->value(), recorder);
+    }
+    recorder.endObject();
+  } else if (v.is<JsonArrayConst>()) {
+    recorder.startArray();
+    JsonArrayConst array = v.as<JsonArrayConst>();
+    for (JsonArrayConst::iterator it = array.begin(); it != array.end(); ++it)
+      recordTree(*it, recorder);
+    recorder.endArray();
+  } else {
+    recorder.value(v);
+  }
+}
+
+std::string events(const char* json) {
+  EventRecorder recorder;
+  DeserializationError err = deserializeJson(recorder, json);
+  return recorder.events() + err.c_str();
+}
+
+// Materializes the elements of the root array one at a time, and keeps their
+// "name" member
+class NameCollector : public JsonHandler {
+ public:
+  NameCollector(JsonDocument& doc)
+      : _doc(doc), _builder(doc), _depth(0), overflowed(false) {}
+
+  virtual void startObject() {
+    if (_depth == 1)
+      _builder.reset();
+    if (_depth >= 1)
+      _builder.startObject();
+    _depth++;
+  }
+
+  virtual void endObject() {
+    _depth--;
+    if (_depth >= 1)
+      _builder.endObject();
+    if (_depth == 1) {
+      names.push_back(_doc["name"].as<std::string>());
+      if (_builder.overflowed())
+        overflowed = true;
+    }
+  }
+
+  virtual void startArray() {
+    if (_depth >= 1)
+      _builder.startArray();
+    _depth++;
+  }
+
+  virtual void endArray() {
+    _depth--;
+    if (_depth >= 1)
+      _builder.endArray();
+  }
+
+  virtual void key(JsonString k) {
+    if (_depth >= 2)
+      _builder.key(k);
+  }
+
+  virtual void value(JsonVariantConst v) {
+    if (_depth >= 2)
+      _builder.value(v);
+  }
+
+ private:
+  JsonDocument& _doc;
+  JsonDocumentBuilder _builder;
+  int _depth;
+
+ public:
+  bool overflowed;
+  std::vector<std::string> names;
+};
+
+const char* corpus[] = {
+#include "json_corpus.h"
+};
+
+std::string readFile(const char* path) {
+  std::ifstream file(path, std::ios::binary);
+  std::ostringstream content;
+  content << file.rdbuf();
+  return content.str();
+}
+}  // namespace
+
+TEST_CASE("deserializeJson(JsonHandler&)") {
+  SECTION("scalars") {
+    CHECK(events("42") == "42 Ok");
+    CHECK(events("-1.5") == "-1.5 Ok");
+    CHECK(events("true") == "true Ok");
+    CHECK(events("null") == "null Ok");
+    CHECK(events("'hello'") == "\"hello\" Ok");
+  }
+
+  SECTION("empty containers") {
+    CHECK(events("[]") == "[ ] Ok");
+    CHECK(events(" { } ") == "{ } Ok");
+  }
+
+  SECTION("nested") {
+    CHECK(events("{\"a\":[1,{\"b\":\"c\"}],\"d\":null}") ==
+          "{ a:[ 1 { b:\"c\" } ] d:null } Ok");
+  }
+
+  SECTION("duplicate keys are reported") {
+    CHECK(events("{\"a\":1,\"a\":2}") == "{ a:1 a:2 } Ok");
+  }
+
+  SECTION("escaped strings") {
+    CHECK(events("{\"\\u00e9\":\"\\n\"}") == "{ \xC3\xA9:\"\\n\" } Ok");
+  }
+
+  SECTION("errors") {
+    CHECK(events("") == "EmptyInput");
+    CHECK(events("[1,") == "[ 1 IncompleteInput");
+    CHECK(events("{\"a\" 1}") == "{ InvalidInput");
+    CHECK(events("[1]]") == "[ 1 ] Ok");
+    CHECK(events("1]") == "InvalidInput");
+  }
+
+  SECTION("nesting limit") {
+    EventRecorder recorder;
+    DeserializationOption::NestingLimit nesting(1);
+
+    CHECK(deserializeJson(recorder, "[[1]]", nesting) ==
+          DeserializationError::TooDeep);
+    CHECK(recorder.events() == "[ ");
+  }
+
+  SECTION("string longer than ARDUINOJSON_SCRATCH_BUFFER_SIZE") {
+    EventRecorder recorder;
+    std::string json = "[\"" + std::string(200, 'x') + "\"]";
+
+    CHECK(deserializeJson(recorder, json) == DeserializationError::NoMemory);
+
+    // no limit when strings are decoded in place
+    std::vector<char> buffer(json.begin(), json.end());
+    buffer.push_back(0);
+    CHECK(deserializeJson(recorder, &buffer[0]) == DeserializationError::Ok);
+  }
+
+  SECTION("input types") {
+    std::string json("[1,{\"a\":\"b\"}]");
+    std::string expected("[ 1 { a:\"b\" } ] ");
+
+    SECTION("std::string") {
+      EventRecorder recorder;
+      REQUIRE(deserializeJson(recorder, json) == DeserializationError::Ok);
+      CHECK(recorder.events() == expected);
+    }
+
+    SECTION("std::istream") {
+      EventRecorder recorder;
+      std::istringstream input(json);
+      REQUIRE(deserializeJson(recorder, input) == DeserializationError::Ok);
+      CHECK(recorder.events() == expected);
+    }
+
+    SECTION("char*, size_t") {
+      EventRecorder recorder;
+      REQUIRE(deserializeJson(recorder, "[1][2]", 3) ==
+              DeserializationError::Ok);
+      CHECK(recorder.events() == "[ 1 ] ");
+    }
+  }
+}
+
+TEST_CASE("JsonDocumentBuilder") {
+  SECTION("builds the same document as deserializeJson()") {
+    const char* json = "{\"a\":[1,2.5,{\"b\":true}],\"c\":\"d\",\"e\":{}}";
+    DynamicJsonDocument expected(1024);
+    DynamicJsonDocument actual(1024);
+    deserializeJson(expected, json);
+    JsonDocumentBuilder builder(actual);
+
+    REQUIRE(deserializeJson(builder, json) == DeserializationError::Ok);
+
+    CHECK(builder.overflowed() == false);
+    CHECK(actual == expected);
+    CHECK(actual.memoryUsage() == expected.memoryUsage());
+  }
+
+  SECTION("document too small") {
+    StaticJsonDocument<JSON_ARRAY_SIZE(1)> doc;
+    JsonDocumentBuilder builder(doc);
+
+    REQUIRE(deserializeJson(builder, "[1,2]") == DeserializationError::Ok);
+
+    CHECK(builder.overflowed() == true);
+    CHECK(doc.size() == 1);
+  }
+
+  SECTION("too deep") {
+    DynamicJsonDocument doc(4096);
+    JsonDocumentBuilder builder(doc);
+    DeserializationOption::NestingLimit nesting(50);
+
+    REQUIRE(deserializeJson(builder, std::string(30, '[') + std::string(30, ']'),
+                            nesting) == DeserializationError::Ok);
+
+    CHECK(builder.overflowed() == true);
+  }
+
+  SECTION("materializes one element at a time") {
+    StaticJsonDocument<256> doc;
+    NameCollector collector(doc);
+
+    std::string json = "[";
+    for (int i = 0; i < 100; i++) {
+      if (i)
+        json += ",";
+      json +=
+          "{\"name\":\"item\",\"tags\":[\"a\",\"b\"],\"pos\":{\"x\":1}}";
+    }
+    json += "]";
+
+    REQUIRE(deserializeJson(collector, json) == DeserializationError::Ok);
+
+    CHECK(collector.overflowed == false);
+    CHECK(collector.names.size() == 100);
+    CHECK(collector.names[99] == "item");
+  }
+}
+
+TEST_CASE("deserializeJson(JsonHandler&) matches the tree on the corpus") {
+  for (size_t i = 0; i < sizeof(corpus) / sizeof(corpus[0]); i++) {
+    std::string json = readFile(corpus[i]);
+    INFO(corpus[i]);
+
+    DynamicJsonDocument doc(65536);
+    DeserializationError treeError = deserializeJson(doc, json);
+
+    // decode in place, so that the length of the strings is not limited
+    std::vector<char> buffer(json.begin(), json.end());
+    buffer.push_back(0);
+    EventRecorder actual;
+    DeserializationError eventError = deserializeJson(actual, &buffer[0]);
+
+    CHECK(eventError == treeError);
+    if (treeError)
+      continue;
+
+    EventRecorder expected;
+    recordTree(doc.as<JsonVariantConst>(), expected);
+    CHECK(actual.events() == expected.events());
+
+    DynamicJsonDocument built(65536);
+    JsonDocumentBuilder builder(built);
+    buffer.assign(json.begin(), json.end());
+    buffer.push_back(0);
+    REQUIRE(deserializeJson(builder, &buffer[0]) == DeserializationError::Ok);
+    CHECK(built == doc);
+  }
+}
@@ -0,0 +1,229 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace {
+const char* corpus[] = {
+#include "json_corpus.h"
+};
+
+std::string readFile(const char* path) {
+  std::ifstream file(path, std::ios::binary);
+  std::ostringstream content;
+  content << file.rdbuf();
+  return content.str();
+}
+
+// Feeds json in two chunks, split at the specified position
+template <size_t N>
+DeserializationError feedSplit(IncrementalJsonDeserializer<N>& deserializer,
+                               const std::string& json, size_t split) {
+  DeserializationError err = deserializer.feed(json.data(), split);
+  if (err != DeserializationError::IncompleteInput)
+    return err;
+  err = deserializer.feed(json.data() + split, json.size() - split);
+  if (err != DeserializationError::IncompleteInput)
+    return err;
+  return deserializer.finish();
+}
+
+// Feeds json one byte at a time
+template <size_t N>
+DeserializationError feedBytes(IncrementalJsonDeserializer<N>& deserializer,
+                               const std::string& json) {
+  for (size_t i = 0; i < json.size(); i++) {
+    DeserializationError err = deserializer.feed(json.data() + i, 1);
+    if (err != DeserializationError::IncompleteInput)
+      return err;
+  }
+  return deserializer.finish();
+}
+}  // namespace
+
+TEST_CASE("IncrementalJsonDeserializer") {
+  DynamicJsonDocument doc(4096);
+  IncrementalJsonDeserializer<> deserializer(doc);
+
+  SECTION("chunks") {
+    CHECK(deserializer.feed("{\"he", 4) ==
+          DeserializationError::IncompleteInput);
+    CHECK(deserializer.feed("llo\": [1", 8) ==
+          DeserializationError::IncompleteInput);
+    CHECK(deserializer.feed("2, tr", 5) ==
+          DeserializationError::IncompleteInput);
+    CHECK(deserializer.feed("ue, \"\\u00", 9) ==
+          DeserializationError::IncompleteInput);
+    CHECK(deserializer.feed("e9\"]}", 5) == DeserializationError::Ok);
+
+    CHECK(doc.as<std::string>() == "{\"hello\":[12,true,\"\xC3\xA9\"]}");
+  }
+
+  SECTION("ignores the input after the document") {
+    CHECK(deserializer.feed("[1]garbage", 10) == DeserializationError::Ok);
+    CHECK(deserializer.feed("[2]", 3) == DeserializationError::Ok);
+
+    CHECK(doc.as<std::string>() == "[1]");
+  }
+
+  SECTION("number at the root needs finish()") {
+    CHECK(deserializer.feed("12", 2) == DeserializationError::IncompleteInput);
+    CHECK(deserializer.feed("34", 2) == DeserializationError::IncompleteInput);
+    CHECK(deserializer.finish() == DeserializationError::Ok);
+
+    CHECK(doc.as<int>() == 1234);
+  }
+
+  SECTION("finish() on an incomplete document") {
+    deserializer.feed("[1,", 3);
+
+    CHECK(deserializer.finish() == DeserializationError::IncompleteInput);
+  }
+
+  SECTION("finish() without input") {
+    deserializer.feed("  ", 2);
+
+    CHECK(deserializer.finish() == DeserializationError::EmptyInput);
+  }
+
+  SECTION("errors are sticky") {
+    CHECK(deserializer.feed("[1 2", 4) == DeserializationError::InvalidInput);
+    CHECK(deserializer.feed("]", 1) == DeserializationError::InvalidInput);
+    CHECK(deserializer.finish() == DeserializationError::InvalidInput);
+  }
+
+  SECTION("reset()") {
+    deserializer.feed("[1 2", 4);
+    deserializer.reset();
+
+    CHECK(deserializer.feed("[3]", 3) == DeserializationError::Ok);
+    CHECK(doc.as<std::string>() == "[3]");
+  }
+
+  SECTION("nesting limit") {
+    IncrementalJsonDeserializer<> shallow(doc,
+                                          DeserializationOption::NestingLimit(1));
+
+    CHECK(shallow.feed("[1]", 3) == DeserializationError::Ok);
+    shallow.reset();
+    CHECK(shallow.feed("[[1]]", 5) == DeserializationError::TooDeep);
+  }
+
+  SECTION("string longer than the capacity") {
+    IncrementalJsonDeserializer<8> small(doc);
+
+    CHECK(small.feed("[\"1234567\"]", 11) == DeserializationError::Ok);
+    small.reset();
+    CHECK(small.feed("[\"12345678\"]", 12) == DeserializationError::NoMemory);
+    small.reset();
+    CHECK(small.feed("{\"12345678\":1}", 14) ==
+          DeserializationError::NoMemory);
+  }
+
+  SECTION("string at the default capacity") {
+    const size_t longest = ARDUINOJSON_SCRATCH_BUFFER_SIZE - 1;
+    std::string json = "[\"" + std::string(longest, 'a') + "\"]";
+
+    CHECK(feedBytes(deserializer, json) == DeserializationError::Ok);
+    CHECK(doc[0].as<std::string>().size() == longest);
+  }
+
+  SECTION("string one byte over the default capacity") {
+    const size_t tooLong = ARDUINOJSON_SCRATCH_BUFFER_SIZE;
+    std::string json = "[\"" + std::string(tooLong, 'a') + "\"]";
+
+    CHECK(feedSplit(deserializer, json, json.size() / 2) ==
+          DeserializationError::NoMemory);
+  }
+
+  SECTION("key at the default capacity") {
+    std::string key(ARDUINOJSON_SCRATCH_BUFFER_SIZE - 1, 'k');
+    std::string json = "{\"" + key + "\":1}";
+
+    CHECK(feedBytes(deserializer, json) == DeserializationError::Ok);
+    CHECK(doc[key] == 1);
+  }
+
+  SECTION("key one byte over the default capacity") {
+    std::string json =
+        "{\"" + std::string(ARDUINOJSON_SCRATCH_BUFFER_SIZE, 'k') + "\":1}";
+
+    CHECK(feedBytes(deserializer, json) == DeserializationError::NoMemory);
+  }
+
+  SECTION("document too small") {
+    StaticJsonDocument<JSON_ARRAY_SIZE(1)> small;
+    IncrementalJsonDeserializer<> tooSmall(small);
+
+    CHECK(tooSmall.feed("[1,", 3) == DeserializationError::IncompleteInput);
+    CHECK(tooSmall.feed("2]", 2) == DeserializationError::NoMemory);
+  }
+
+  SECTION("comments") {
+    const char* json = "/*a*/[1,//b\n2]";
+#if ARDUINOJSON_ENABLE_COMMENTS
+    CHECK(feedBytes(deserializer, json) == DeserializationError::Ok);
+    CHECK(doc.as<std::string>() == "[1,2]");
+#else
+    CHECK(feedBytes(deserializer, json) == DeserializationError::InvalidInput);
+#endif
+  }
+}
+
+TEST_CASE("IncrementalJsonParser") {
+  SECTION("sends the events to the handler") {
+    DynamicJsonDocument doc(1024);
+    JsonDocumentBuilder builder(doc);
+    IncrementalJsonParser<> parser(builder);
+
+    CHECK(parser.feed("{a:'b'", 6) == DeserializationError::IncompleteInput);
+    CHECK(parser.feed(",c:null}", 8) == DeserializationError::Ok);
+
+    CHECK(doc.as<std::string>() == "{\"a\":\"b\",\"c\":null}");
+  }
+
+  SECTION("strings of stringCapacity - 1 characters at most") {
+    DynamicJsonDocument doc(1024);
+    JsonDocumentBuilder builder(doc);
+    IncrementalJsonParser<16> parser(builder);
+
+    CHECK(parser.feed("[\"123456789012345\"]", 19) ==
+          DeserializationError::Ok);
+    parser.reset();
+    CHECK(parser.feed("[\"1234567890123456\"]", 20) ==
+          DeserializationError::NoMemory);
+  }
+}
+
+TEST_CASE("IncrementalJsonDeserializer matches the tree on the corpus") {
+  DynamicJsonDocument expected(65536);
+  DynamicJsonDocument actual(65536);
+  IncrementalJsonDeserializer<256> deserializer(actual);
+
+  for (size_t i = 0; i < sizeof(corpus) / sizeof(corpus[0]); i++) {
+    std::string json = readFile(corpus[i]);
+    INFO(corpus[i]);
+
+    DeserializationError treeError = deserializeJson(expected, json);
+
+    for (size_t split = 0; split <= json.size(); split++) {
+      INFO("split at " << split);
+      deserializer.reset();
+      DeserializationError err = feedSplit(deserializer, json, split);
+      CHECK(err == treeError);
+      if (!treeError)
+        CHECK(actual == expected);
+    }
+
+    deserializer.reset();
+    CHECK(feedBytes(deserializer, json) == treeError);
+    if (!treeError)
+      CHECK(actual == expected);
+  }
+}
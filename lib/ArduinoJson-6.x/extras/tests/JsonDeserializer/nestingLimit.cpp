@@ -99,3 +99,37 @@ TEST_CASE("JsonDeserializer nesting") {
     }
   }
 }
+
+#if ARDUINOJSON_ENABLE_ITERATIVE_PARSING
+TEST_CASE("Iterative parser and deep documents") {
+  const int maxDepth = ARDUINOJSON_ITERATIVE_PARSING_MAX_DEPTH;
+  DynamicJsonDocument doc(16384);
+  DeserializationOption::NestingLimit nesting(255);
+
+  SECTION("up to ARDUINOJSON_ITERATIVE_PARSING_MAX_DEPTH") {
+    std::string json = std::string(maxDepth, '[') + std::string(maxDepth, ']');
+
+    REQUIRE(deserializeJson(doc, json, nesting) == DeserializationError::Ok);
+    REQUIRE(doc.nesting() == maxDepth);
+  }
+
+  SECTION("deeper than ARDUINOJSON_ITERATIVE_PARSING_MAX_DEPTH") {
+    std::string json =
+        std::string(maxDepth + 1, '[') + std::string(maxDepth + 1, ']');
+
+    REQUIRE(deserializeJson(doc, json, nesting) ==
+            DeserializationError::TooDeep);
+  }
+
+  SECTION("skipped values can be deeper") {
+    std::string json = "{\"a\":" + std::string(200, '[') +
+                       std::string(200, ']') + ",\"b\":1}";
+    StaticJsonDocument<64> filter;
+    filter["b"] = true;
+
+    REQUIRE(deserializeJson(doc, json, DeserializationOption::Filter(filter),
+                            nesting) == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"b\":1}");
+  }
+}
+#endif
@@ -0,0 +1,176 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <sstream>
+#include <string>
+
+static const char nightLog[] =
+    "{\"time\":1650000000,\"sqm\":21.57}\n"
+    "{\"time\":1650000600,\"sqm\":21.61}\n"
+    "{\"time\":1650001200,\"sqm\":21.49}\n";
+
+TEST_CASE("JsonSequence") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("reads a buffer") {
+    JsonSequence<const char*> records(doc, nightLog, strlen(nightLog));
+
+    REQUIRE(records.next() == DeserializationError::Ok);
+    REQUIRE(doc["time"] == 1650000000);
+    REQUIRE(records.next() == DeserializationError::Ok);
+    REQUIRE(doc["time"] == 1650000600);
+    REQUIRE(records.next() == DeserializationError::Ok);
+    REQUIRE(doc["time"] == 1650001200);
+    REQUIRE(doc["sqm"] == 21.49);
+    REQUIRE(records.next() == DeserializationError::EmptyInput);
+    REQUIRE(records.next() == DeserializationError::EmptyInput);
+    REQUIRE(records.count() == 3);
+  }
+
+  SECTION("reads a stream") {
+    std::istringstream input(nightLog);
+    JsonSequence<std::istream> records(doc, input);
+
+    REQUIRE(records.next() == DeserializationError::Ok);
+    REQUIRE(records.next() == DeserializationError::Ok);
+    REQUIRE(records.next() == DeserializationError::Ok);
+    REQUIRE(doc["time"] == 1650001200);
+    REQUIRE(records.next() == DeserializationError::EmptyInput);
+  }
+
+  SECTION("reads a std::string") {
+    std::string input(nightLog);
+    JsonSequence<std::string> records(doc, input);
+
+    REQUIRE(records.next() == DeserializationError::Ok);
+    REQUIRE(doc["time"] == 1650000000);
+  }
+
+  SECTION("stops at the specified size") {
+    JsonSequence<const char*> records(doc, nightLog, strlen(nightLog) - 1);
+
+    REQUIRE(records.next() == DeserializationError::Ok);
+    REQUIRE(records.next() == DeserializationError::Ok);
+    REQUIRE(records.next() == DeserializationError::Ok);
+    REQUIRE(records.next() == DeserializationError::EmptyInput);
+  }
+
+  SECTION("empty input") {
+    JsonSequence<const char*> records(doc, "", 0);
+
+    REQUIRE(records.next() == DeserializationError::EmptyInput);
+    REQUIRE(records.count() == 0);
+  }
+
+  SECTION("blank lines and CRLF") {
+    const char* input = "\r\n[1]\r\n\r\n  [2]  \r\n\n";
+    JsonSequence<const char*> records(doc, input, strlen(input));
+
+    REQUIRE(records.next() == DeserializationError::Ok);
+    REQUIRE(doc[0] == 1);
+    REQUIRE(records.next() == DeserializationError::Ok);
+    REQUIRE(doc[0] == 2);
+    REQUIRE(records.next() == DeserializationError::EmptyInput);
+  }
+
+  SECTION("scalars") {
+    const char* input = "42\n\"hello\"\ntrue\n-1.5";
+    JsonSequence<const char*> records(doc, input, strlen(input));
+
+    REQUIRE(records.next() == DeserializationError::Ok);
+    REQUIRE(doc.as<int>() == 42);
+    REQUIRE(records.next() == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "hello");
+    REQUIRE(records.next() == DeserializationError::Ok);
+    REQUIRE(doc.as<bool>() == true);
+    REQUIRE(records.next() == DeserializationError::Ok);
+    REQUIRE(doc.as<double>() == -1.5);
+    REQUIRE(records.next() == DeserializationError::EmptyInput);
+  }
+
+  SECTION("JSON text sequence (RFC 7464)") {
+    const char* input = "\x1e{\"a\":1}\n\x1e{\"a\":2}\n";
+    JsonSequence<const char*> records(doc, input, strlen(input));
+
+    REQUIRE(records.next() == DeserializationError::Ok);
+    REQUIRE(doc["a"] == 1);
+    REQUIRE(records.next() == DeserializationError::Ok);
+    REQUIRE(doc["a"] == 2);
+    REQUIRE(records.next() == DeserializationError::EmptyInput);
+  }
+
+  SECTION("two values on the same line") {
+    const char* input = "{\"a\":1}{\"a\":2}\n{\"a\":3}\n";
+    JsonSequence<const char*> records(doc, input, strlen(input));
+
+    REQUIRE(records.next() == DeserializationError::InvalidInput);
+    REQUIRE(records.next() == DeserializationError::Ok);
+    REQUIRE(doc["a"] == 3);
+    REQUIRE(records.count() == 1);
+  }
+
+  SECTION("resumes after an invalid line") {
+    const char* input = "{\"a\":1}\n{\"a\":?}\n{\"a\":3}\n";
+    JsonSequence<const char*> records(doc, input, strlen(input));
+
+    REQUIRE(records.next() == DeserializationError::Ok);
+    REQUIRE(records.next() == DeserializationError::InvalidInput);
+    REQUIRE(records.next() == DeserializationError::Ok);
+    REQUIRE(doc["a"] == 3);
+    REQUIRE(records.next() == DeserializationError::EmptyInput);
+    REQUIRE(records.count() == 2);
+  }
+
+  SECTION("incomplete last line") {
+    const char* input = "{\"a\":1}\n{\"a\":";
+    JsonSequence<const char*> records(doc, input, strlen(input));
+
+    REQUIRE(records.next() == DeserializationError::Ok);
+    REQUIRE(records.next() == DeserializationError::IncompleteInput);
+    REQUIRE(records.next() == DeserializationError::EmptyInput);
+  }
+
+  SECTION("document too small") {
+    StaticJsonDocument<JSON_OBJECT_SIZE(1) + 8> small;
+    const char* input = "{\"a\":1,\"b\":2}\n{\"c\":3}\n";
+    JsonSequence<const char*> records(small, input, strlen(input));
+
+    REQUIRE(records.next() == DeserializationError::NoMemory);
+    REQUIRE(records.next() == DeserializationError::Ok);
+    REQUIRE(small["c"] == 3);
+  }
+
+  SECTION("reuses the memory pool") {
+    JsonSequence<const char*> records(doc, nightLog, strlen(nightLog));
+
+    records.next();
+    size_t usage = doc.memoryUsage();
+    records.next();
+
+    REQUIRE(doc.memoryUsage() == usage);
+    REQUIRE(doc.size() == 2);
+  }
+
+  SECTION("filter") {
+    StaticJsonDocument<64> filter;
+    filter["sqm"] = true;
+    JsonSequence<const char*> records(doc, nightLog, strlen(nightLog));
+
+    REQUIRE(records.next(DeserializationOption::Filter(filter)) ==
+            DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"sqm\":21.57}");
+  }
+
+  SECTION("nesting limit") {
+    const char* input = "[[1]]\n[2]\n";
+    JsonSequence<const char*> records(doc, input, strlen(input),
+                                      DeserializationOption::NestingLimit(1));
+
+    REQUIRE(records.next() == DeserializationError::TooDeep);
+    REQUIRE(records.next() == DeserializationError::Ok);
+    REQUIRE(doc[0] == 2);
+  }
+}
@@ -6,6 +6,9 @@
 #include <ArduinoJson.h>
 #include <catch.hpp>
 
+#include <sstream>
+#include <vector>
+
 TEST_CASE("Valid JSON strings value") {
   struct TestCase {
     const char* input;
@@ -130,3 +133,71 @@ TEST_CASE("Empty memory pool") {
     REQUIRE(deserializeJson(doc, empty) == DeserializationError::Ok);
   }
 }
+
+static std::string deserializeFromStream(const std::string& json,
+                                         DeserializationError& err) {
+  DynamicJsonDocument doc(4096);
+  std::istringstream stream(json);  // no direct access => scalar path
+  err = deserializeJson(doc, stream);
+  return doc.as<std::string>();
+}
+
+TEST_CASE("Strings parsed from RAM match the character-based path") {
+  const char* specials[] = {"\\\"", "\\\\", "\\n",       "\\u0041", "\x01",
+                            "'",    "\xc3\xa4", "\\/", "\\t"};
+  const size_t specialCount = sizeof(specials) / sizeof(specials[0]);
+
+  DynamicJsonDocument doc(4096);
+  StaticJsonDocument<32> filter;
+  filter["b"] = true;
+
+  for (size_t length = 0; length < 40; length++) {
+    for (size_t pos = 0; pos <= length; pos++) {
+      for (size_t i = 0; i < specialCount; i++) {
+        std::string json = "\"" + std::string(pos, 'a') + specials[i] +
+                           std::string(length - pos, 'b') + "\"";
+        CAPTURE(json);
+
+        DeserializationError err;
+        std::string expected = deserializeFromStream(json, err);
+        REQUIRE(err == DeserializationError::Ok);
+
+        // const char*
+        REQUIRE(deserializeJson(doc, json.c_str()) == err);
+        REQUIRE(doc.as<std::string>() == expected);
+
+        // const char*, size_t
+        REQUIRE(deserializeJson(doc, json.c_str(), json.size()) == err);
+        REQUIRE(doc.as<std::string>() == expected);
+
+        // char* (zero-copy)
+        std::vector<char> input(json.begin(), json.end());
+        input.push_back(0);
+        REQUIRE(deserializeJson(doc, &input[0]) == err);
+        REQUIRE(doc.as<std::string>() == expected);
+
+        // skipped by filter
+        std::string obj = "{\"a\":" + json + ",\"b\":" + json + "}";
+        REQUIRE(deserializeJson(doc, obj.c_str(), obj.size(),
+                                DeserializationOption::Filter(filter)) ==
+                DeserializationError::Ok);
+        REQUIRE(doc.size() == 1);
+        REQUIRE(doc["b"].as<std::string>() == expected);
+      }
+    }
+  }
+}
+
+TEST_CASE("Truncated long strings") {
+  DynamicJsonDocument doc(4096);
+  std::string json = "\"" + std::string(37, 'x');
+
+  for (size_t length = 1; length <= json.size(); length++) {
+    CAPTURE(length);
+    REQUIRE(deserializeJson(doc, json.c_str(), length) ==
+            DeserializationError::IncompleteInput);
+    std::string input = json.substr(0, length);
+    REQUIRE(deserializeJson(doc, input.c_str()) ==
+            DeserializationError::IncompleteInput);
+  }
+}
@@ -0,0 +1,172 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <stdlib.h>  // malloc, free
+#include <catch.hpp>
+#include <string>
+
+// Allocates a limited number of blocks
+class LimitedAllocator {
+ public:
+  LimitedAllocator(int& allocations, int limit = 1000)
+      : _allocations(&allocations), _limit(limit) {}
+
+  void* allocate(size_t n) {
+    if (*_allocations >= _limit)
+      return 0;
+    (*_allocations)++;
+    return malloc(n);
+  }
+
+  void deallocate(void* p) {
+    free(p);
+  }
+
+ private:
+  int* _allocations;
+  int _limit;
+};
+
+// Only accepts blocks, like a socket
+struct CustomDestination {
+  std::string str;
+
+  size_t write(const uint8_t* data, size_t n) {
+    str.append(reinterpret_cast<const char*>(data), n);
+    return n;
+  }
+};
+
+typedef BasicChunkedBuffer<LimitedAllocator> LimitedChunkedBuffer;
+
+template <typename TBuffer>
+static std::string joinChunks(const TBuffer& buffer) {
+  std::string s;
+  for (const BufferChunk* c = buffer.firstChunk(); c; c = buffer.next(c))
+    s.append(c->data(), c->size);
+  return s;
+}
+
+TEST_CASE("ChunkedBuffer") {
+  int allocations = 0;
+
+  SECTION("empty") {
+    LimitedChunkedBuffer buffer(8, allocations);
+
+    REQUIRE(buffer.size() == 0);
+    REQUIRE(buffer.chunkCount() == 0);
+    REQUIRE(buffer.firstChunk() == 0);
+    REQUIRE(allocations == 0);
+  }
+
+  SECTION("fits in one chunk") {
+    LimitedChunkedBuffer buffer(8, allocations);
+    DynamicJsonDocument doc(256);
+    doc.add(1);
+    doc.add(2);
+
+    size_t n = serializeJson(doc, buffer);
+
+    REQUIRE(n == 5);
+    REQUIRE(buffer.size() == 5);
+    REQUIRE(buffer.chunkCount() == 1);
+    REQUIRE(joinChunks(buffer) == "[1,2]");
+    REQUIRE(buffer.overflowed() == false);
+  }
+
+  SECTION("spans several chunks") {
+    LimitedChunkedBuffer buffer(8, allocations);
+    DynamicJsonDocument doc(256);
+    doc["hello"] = "a string that spans several chunks";
+
+    size_t n = serializeJson(doc, buffer);
+
+    REQUIRE(n == measureJson(doc));
+    REQUIRE(buffer.size() == n);
+    REQUIRE(buffer.chunkCount() == (n + 7) / 8);
+    REQUIRE(allocations == int(buffer.chunkCount()));
+    REQUIRE(joinChunks(buffer) == doc.as<std::string>());
+  }
+
+  SECTION("exactly fills the chunks") {
+    LimitedChunkedBuffer buffer(5, allocations);
+    DynamicJsonDocument doc(256);
+    doc.add(1);
+    doc.add(2);
+
+    serializeJson(doc, buffer);
+
+    REQUIRE(buffer.chunkCount() == 1);
+    REQUIRE(allocations == 1);
+  }
+
+  SECTION("serializeJsonPretty()") {
+    LimitedChunkedBuffer buffer(4, allocations);
+    DynamicJsonDocument doc(256);
+    doc["a"] = 1;
+
+    size_t n = serializeJsonPretty(doc, buffer);
+
+    REQUIRE(n == measureJsonPretty(doc));
+    REQUIRE(joinChunks(buffer) == "{\r\n  \"a\": 1\r\n}");
+  }
+
+  SECTION("serializeMsgPack()") {
+    LimitedChunkedBuffer buffer(2, allocations);
+    DynamicJsonDocument doc(256);
+    doc["a"] = 1;
+
+    size_t n = serializeMsgPack(doc, buffer);
+
+    REQUIRE(n == 4);
+    REQUIRE(joinChunks(buffer) == "\x81\xA1"
+                                  "a\x01");
+  }
+
+  SECTION("clear() reuses the chunks") {
+    LimitedChunkedBuffer buffer(8, allocations);
+    DynamicJsonDocument doc(256);
+    doc["hello"] = "world";
+    serializeJson(doc, buffer);
+    int before = allocations;
+
+    buffer.clear();
+    REQUIRE(buffer.size() == 0);
+    REQUIRE(buffer.firstChunk() == 0);
+
+    doc["hello"] = "you";
+    serializeJson(doc, buffer);
+
+    REQUIRE(allocations == before);
+    REQUIRE(buffer.chunkCount() == 2);
+    REQUIRE(joinChunks(buffer) == "{\"hello\":\"you\"}");
+  }
+
+  SECTION("allocation failure") {
+    LimitedChunkedBuffer buffer(4, LimitedAllocator(allocations, 2));
+    DynamicJsonDocument doc(256);
+    doc["hello"] = "world";
+
+    size_t n = serializeJson(doc, buffer);
+
+    REQUIRE(n == 8);
+    REQUIRE(buffer.size() == 8);
+    REQUIRE(buffer.overflowed() == true);
+    REQUIRE(joinChunks(buffer) == "{\"hello\"");
+  }
+
+  SECTION("writeTo()") {
+    LimitedChunkedBuffer buffer(3, allocations);
+    DynamicJsonDocument doc(256);
+    doc["hello"] = "world";
+    serializeJson(doc, buffer);
+    CustomDestination destination;
+
+    size_t n = buffer.writeTo(destination);
+
+    REQUIRE(n == buffer.size());
+    REQUIRE(destination.str == "{\"hello\":\"world\"}");
+  }
+}
@@ -0,0 +1,102 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <stdlib.h>  // malloc, free
+#include <catch.hpp>
+#include <string>
+
+class FailingAllocator {
+ public:
+  void* allocate(size_t) {
+    return 0;
+  }
+
+  void deallocate(void* p) {
+    free(p);
+  }
+
+  void* reallocate(void*, size_t) {
+    return 0;
+  }
+};
+
+typedef BasicJsonDocument<InstrumentedAllocator<> > InstrumentedJsonDocument;
+
+TEST_CASE("InstrumentedAllocator") {
+  AllocatorStats stats;
+
+  SECTION("Construct/Destruct") {
+    { InstrumentedJsonDocument doc(1024, stats); }
+
+    REQUIRE(stats.allocations == 1);
+    REQUIRE(stats.deallocations == 1);
+    REQUIRE(stats.failures == 0);
+    REQUIRE(stats.totalBytes == 1024);
+    REQUIRE(stats.largestBytes == 1024);
+    REQUIRE(stats.currentBytes == 0);
+    REQUIRE(stats.peakBytes == 1024);
+    REQUIRE(stats.longestLifetime == 1);
+  }
+
+  SECTION("counts the blocks that are still allocated") {
+    InstrumentedJsonDocument doc1(1024, stats);
+    InstrumentedJsonDocument doc2(512, stats);
+
+    REQUIRE(stats.allocations == 2);
+    REQUIRE(stats.currentBytes == 1536);
+    REQUIRE(stats.largestBytes == 1024);
+  }
+
+  SECTION("Copy construct") {
+    {
+      InstrumentedJsonDocument doc1(1024, stats);
+      doc1.set(std::string("hello"));
+      InstrumentedJsonDocument doc2(doc1);
+
+      REQUIRE(stats.allocations == 2);
+      REQUIRE(stats.peakBytes == 2048);
+    }
+    REQUIRE(stats.deallocations == 2);
+    REQUIRE(stats.longestLifetime == 3);
+  }
+
+  SECTION("shrinkToFit()") {
+    InstrumentedJsonDocument doc(4096, stats);
+    doc.set(std::string("hello"));
+
+    doc.shrinkToFit();
+
+    REQUIRE(stats.allocations == 2);
+    REQUIRE(stats.currentBytes == doc.capacity());
+    REQUIRE(stats.peakBytes == 4096);
+    REQUIRE(doc.as<std::string>() == "hello");
+  }
+
+  SECTION("reset() keeps the blocks allocated before") {
+    InstrumentedJsonDocument doc1(1024, stats);
+    stats.reset();
+
+    {
+      InstrumentedJsonDocument doc2(256, stats);
+      REQUIRE(stats.currentBytes == 1280);
+    }
+
+    REQUIRE(stats.allocations == 1);
+    REQUIRE(stats.totalBytes == 256);
+    REQUIRE(stats.peakBytes == 1280);
+    REQUIRE(stats.currentBytes == 1024);
+  }
+
+  SECTION("counts the failures") {
+    InstrumentedAllocator<FailingAllocator> allocator(stats);
+    BasicJsonDocument<InstrumentedAllocator<FailingAllocator> > doc(1024,
+                                                                    allocator);
+
+    REQUIRE(doc.capacity() == 0);
+    REQUIRE(stats.allocations == 0);
+    REQUIRE(stats.failures == 1);
+    REQUIRE(stats.currentBytes == 0);
+  }
+}
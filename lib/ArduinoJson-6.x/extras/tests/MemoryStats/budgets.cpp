@@ -0,0 +1,106 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+// Memory budgets of the payloads exchanged by the firmware.
+// A failure means that a change uses more memory for the same document.
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <string>
+
+typedef BasicJsonDocument<InstrumentedAllocator<> > InstrumentedJsonDocument;
+
+// Body of a POST /SQM request, as built by post_data()
+static const char sqmBody[] =
+    "{\"raining\":\"0\",\"luminosity\":\"21.57\",\"seeing\":\"2.85\","
+    "\"nelm\":\"6.14\",\"concentration\":\"12\",\"object\":\"-17.43\","
+    "\"ambient\":\"8.91\",\"lux\":\"0.00\","
+    "\"lightning_distanceToStorm\":\"0\",\"errors\":\"\","
+    "\"isSeeing\":\"1\"}";
+
+// Response of GET /getsettings, as read by fetch_settings()
+static const char getSettingsResponse[] =
+    "{\"seeing_thr\":3,\"setpoint1\":22.0,\"setpoint2\":21.0,"
+    "\"max_lux\":50.0,\"SLEEPTIME_s\":300,\"DISPLAY_TIMEOUT_s\":30,"
+    "\"DISPLAY_ON\":1,\"set_sqm_limit\":21.5}";
+
+// A night of readings, as sent by post_data()
+static std::string sqmBatch(int count) {
+  std::string json = "[";
+  for (int i = 0; i < count; i++) {
+    if (i)
+      json += ",";
+    json += sqmBody;
+  }
+  json += "]";
+  return json;
+}
+
+TEST_CASE("Memory budgets") {
+  AllocatorStats heap;
+
+  SECTION("POST /SQM body") {
+    InstrumentedJsonDocument doc(1024, heap);
+
+    REQUIRE(deserializeJson(doc, sqmBody) == DeserializationError::Ok);
+    MemoryPoolStats pool = doc.memoryStats();
+
+    REQUIRE(pool.slots == 11);
+    REQUIRE(pool.overflows == 0);
+#if ARDUINOJSON_ENABLE_STRING_DEDUPLICATION
+    REQUIRE(pool.dedupHits == 1);  // "0"
+#endif
+    REQUIRE(pool.stringBytes == 147);
+    REQUIRE(pool.peakSize == JSON_OBJECT_SIZE(11) + 147);
+    REQUIRE(heap.allocations == 1);
+    REQUIRE(heap.peakBytes == 1024);
+  }
+
+  SECTION("GET /getsettings response") {
+    InstrumentedJsonDocument doc(2048, heap);
+
+    REQUIRE(deserializeJson(doc, getSettingsResponse) ==
+            DeserializationError::Ok);
+    MemoryPoolStats pool = doc.memoryStats();
+
+    REQUIRE(pool.slots == 8);
+    REQUIRE(pool.strings == 8);  // only the keys
+    REQUIRE(pool.overflows == 0);
+    REQUIRE(pool.stringBytes == 94);
+    REQUIRE(pool.peakSize == JSON_OBJECT_SIZE(8) + 94);
+    REQUIRE(heap.allocations == 1);
+  }
+
+  SECTION("GET /getsettings response, kept in place") {
+    // the keys stay in the input buffer, so only the slots use the pool
+    InstrumentedJsonDocument doc(2048, heap);
+    char input[sizeof(getSettingsResponse)];
+    memcpy(input, getSettingsResponse, sizeof(input));
+
+    REQUIRE(deserializeJson(doc, input) == DeserializationError::Ok);
+    MemoryPoolStats pool = doc.memoryStats();
+
+    REQUIRE(pool.strings == 0);
+    REQUIRE(pool.peakSize == JSON_OBJECT_SIZE(8));
+  }
+
+#if ARDUINOJSON_ENABLE_STRING_DEDUPLICATION
+  SECTION("a night of readings stores each key once") {
+    InstrumentedJsonDocument doc(32768, heap);
+
+    REQUIRE(deserializeJson(doc, sqmBatch(72)) == DeserializationError::Ok);
+    MemoryPoolStats pool = doc.memoryStats();
+
+    REQUIRE(pool.slots == 72 + 72 * 11);
+    REQUIRE(pool.overflows == 0);
+    // the same keys and values as a single body
+    REQUIRE(pool.strings == 21);
+    REQUIRE(pool.dedupHits == 72 * 22 - 21);
+    REQUIRE(pool.stringBytes == 147);
+    REQUIRE(pool.peakSize ==
+            JSON_ARRAY_SIZE(72) + 72 * JSON_OBJECT_SIZE(11) + 147);
+    REQUIRE(heap.allocations == 1);
+  }
+#endif
+}
@@ -0,0 +1,124 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <string>
+
+// Carves the blocks of a GrowableJsonDocument from a static buffer, so they
+// are close enough for VariantSlot
+class StaticBlockAllocator {
+ public:
+  StaticBlockAllocator() : _used(0) {}
+
+  void* allocate(size_t n) {
+    n = ARDUINOJSON_NAMESPACE::addPadding(n);
+    if (_used + n > sizeof(_buffer))
+      return 0;
+    void* p = _buffer + _used;
+    _used += n;
+    return p;
+  }
+
+  void deallocate(void*) {}
+
+  void* reallocate(void*, size_t) {
+    return 0;
+  }
+
+ private:
+  static char _buffer[8192];
+  size_t _used;
+};
+
+char StaticBlockAllocator::_buffer[8192];
+
+TEST_CASE("JsonDocument::memoryStats()") {
+  SECTION("new document") {
+    StaticJsonDocument<256> doc;
+    MemoryPoolStats stats = doc.memoryStats();
+
+    REQUIRE(stats.slots == 0);
+    REQUIRE(stats.strings == 0);
+    REQUIRE(stats.stringBytes == 0);
+    REQUIRE(stats.dedupHits == 0);
+    REQUIRE(stats.overflows == 0);
+    REQUIRE(stats.blocks == 0);
+    REQUIRE(stats.peakSize == 0);
+  }
+
+  SECTION("counts the slots and the strings") {
+    StaticJsonDocument<256> doc;
+    deserializeJson(doc, "{\"hello\":\"world\",\"answer\":42}");
+    MemoryPoolStats stats = doc.memoryStats();
+
+    REQUIRE(stats.slots == 2);
+    REQUIRE(stats.strings == 3);
+    REQUIRE(stats.stringBytes == 6 + 6 + 7);
+    REQUIRE(stats.peakSize == doc.memoryUsage());
+  }
+
+  SECTION("counts the deduplicated strings") {
+    StaticJsonDocument<256> doc;
+    deserializeJson(doc, "[{\"sensor\":\"lux\"},{\"sensor\":\"lux\"}]");
+    MemoryPoolStats stats = doc.memoryStats();
+
+#if ARDUINOJSON_ENABLE_STRING_DEDUPLICATION
+    REQUIRE(stats.strings == 2);
+    REQUIRE(stats.dedupHits == 2);
+#else
+    REQUIRE(stats.strings == 4);
+    REQUIRE(stats.dedupHits == 0);
+#endif
+  }
+
+  SECTION("counts each overflow once") {
+    StaticJsonDocument<JSON_ARRAY_SIZE(1)> doc;
+
+    doc.add(1);
+    doc.add(2);
+    doc.add(3);
+    REQUIRE(doc.memoryStats().overflows == 1);
+
+    doc.clear();
+    doc.add(1);
+    doc.add(2);
+    REQUIRE(doc.memoryStats().overflows == 2);
+  }
+
+  SECTION("counts the overflow of a string") {
+    StaticJsonDocument<8> doc;
+
+    deserializeJson(doc, "\"a string that doesn't fit\"");
+
+    REQUIRE(doc.memoryStats().overflows == 1);
+    REQUIRE(doc.memoryStats().strings == 0);
+  }
+
+  SECTION("counts the blocks of a GrowableJsonDocument") {
+    BasicGrowableJsonDocument<StaticBlockAllocator> doc(64);
+
+    deserializeJson(doc, "[\"" + std::string(200, '*') + "\"]");
+    MemoryPoolStats stats = doc.memoryStats();
+
+    REQUIRE(stats.blocks > 1);
+    REQUIRE(stats.blocks == doc.blockCount());
+    REQUIRE(stats.overflows == 0);
+  }
+
+  SECTION("resetMemoryStats()") {
+    StaticJsonDocument<256> doc;
+    deserializeJson(doc, "[\"hello\",\"world\",\"!\"]");
+    doc.clear();
+    doc.add(1);
+
+    doc.resetMemoryStats();
+    MemoryPoolStats stats = doc.memoryStats();
+
+    REQUIRE(stats.slots == 0);
+    REQUIRE(stats.strings == 0);
+    REQUIRE(stats.peakSize == doc.memoryUsage());
+    REQUIRE(doc.peakMemoryUsage() == doc.memoryUsage());
+  }
+}
@@ -3,6 +3,8 @@
 // MIT License
 
 #include <Arduino.h>
+
+#define ARDUINOJSON_ENABLE_ARDUINO_STREAM 1
 #include <ArduinoJson.hpp>
 #include <catch.hpp>
 
@@ -170,6 +172,10 @@ class StreamStub : public Stream {
  public:
   StreamStub(const char* s) : _stream(s) {}
 
+  int available() {
+    return static_cast<int>(_stream.rdbuf()->in_avail());
+  }
+
   int read() {
     return _stream.get();
   }
@@ -223,3 +229,84 @@ TEST_CASE("Reader<Stream>") {
     REQUIRE(buffer[6] == 'g');
   }
 }
+
+// Like a network stream when the next packet hasn't arrived yet
+class StreamWithNothingAvailable : public StreamStub {
+ public:
+  StreamWithNothingAvailable(const char* s) : StreamStub(s) {}
+
+  int available() {
+    return 0;
+  }
+};
+
+TEST_CASE("BoundedReader<Stream>") {
+  SECTION("read()") {
+    StreamStub src("\x01\xFF\x02");
+    BoundedReader<StreamStub> reader(src, 2);
+
+    REQUIRE(reader.read() == 0x01);
+    REQUIRE(reader.read() == 0xFF);
+    REQUIRE(reader.read() == -1);
+    REQUIRE(src.read() == 0x02);
+  }
+
+  SECTION("read() when nothing is available") {
+    StreamWithNothingAvailable src("ABC");
+    BoundedReader<StreamWithNothingAvailable> reader(src, 3);
+
+    REQUIRE(reader.read() == 'A');
+    REQUIRE(reader.read() == 'B');
+    REQUIRE(reader.read() == 'C');
+    REQUIRE(reader.read() == -1);
+  }
+
+  SECTION("read() longer than the buffer") {
+    std::string input(3 * ARDUINOJSON_STREAM_BUFFER_SIZE + 1, 'x');
+    input += "END";
+    StreamStub src(input.c_str());
+    BoundedReader<StreamStub> reader(src, input.size() - 3);
+
+    size_t n = 0;
+    while (reader.read() == 'x')
+      n++;
+
+    REQUIRE(n == input.size() - 3);
+    REQUIRE(src.read() == 'E');
+  }
+
+  SECTION("readBytes() after read()") {
+    StreamStub src("ABCDEF");
+    BoundedReader<StreamStub> reader(src, 5);
+
+    char buffer[8] = "abcdefg";
+    REQUIRE(reader.read() == 'A');
+    REQUIRE(reader.readBytes(buffer, 7) == 4);
+
+    REQUIRE(buffer[0] == 'B');
+    REQUIRE(buffer[1] == 'C');
+    REQUIRE(buffer[2] == 'D');
+    REQUIRE(buffer[3] == 'E');
+    REQUIRE(buffer[4] == 'e');
+    REQUIRE(src.read() == 'F');
+  }
+
+  SECTION("deserializeJson() doesn't read past the document") {
+    StreamStub src("{\"hello\":\"world\"}[42]");
+    DynamicJsonDocument doc(1024);
+
+    REQUIRE(deserializeJson(doc, src, 17) == DeserializationError::Ok);
+    REQUIRE(doc["hello"] == "world");
+
+    REQUIRE(deserializeJson(doc, src) == DeserializationError::Ok);
+    REQUIRE(doc[0] == 42);
+  }
+
+  SECTION("deserializeJson() with a truncated document") {
+    StreamStub src("{\"hello\":\"world\"}");
+    DynamicJsonDocument doc(1024);
+
+    REQUIRE(deserializeJson(doc, src, 10) ==
+            DeserializationError::IncompleteInput);
+  }
+}
@@ -124,6 +124,22 @@ TEST_CASE("Writer<String>") {
       writer.~Writer();
       REQUIRE(output == "abcde");
     }
+
+    SECTION("string longer than the buffer") {
+      REQUIRE(print(writer, "abcdefghij") == 10);
+      REQUIRE(output == "abcdefgh");
+
+      writer.~Writer();
+      REQUIRE(output == "abcdefghij");
+    }
+
+    SECTION("returns the number of bytes written on error") {
+      output.limitCapacityTo(6);
+
+      REQUIRE(print(writer, "abcdefghij") == 8);
+      REQUIRE(output == "abcd");
+      REQUIRE(print(writer, "klm") == 0);
+    }
   }
 }
 
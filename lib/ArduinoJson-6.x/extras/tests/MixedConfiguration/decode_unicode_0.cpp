@@ -2,11 +2,45 @@
 #include <ArduinoJson.h>
 
 #include <catch.hpp>
+#include <sstream>
+#include <string>
 
 TEST_CASE("ARDUINOJSON_DECODE_UNICODE == 0") {
   DynamicJsonDocument doc(2048);
-  DeserializationError err = deserializeJson(doc, "\"\\uD834\\uDD1E\"");
 
-  REQUIRE(err == DeserializationError::Ok);
-  REQUIRE(doc.as<std::string>() == "\\uD834\\uDD1E");
+  SECTION("keeps the escape sequence") {
+    DeserializationError err = deserializeJson(doc, "\"\\uD834\\uDD1E\"");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "\\uD834\\uDD1E");
+  }
+
+  SECTION("between plain characters, from a RAM reader") {
+    std::string input = "[\"sqm \\u00B0C 21.35\",\"\\u0041\\u\"]";
+    DeserializationError err = deserializeJson(doc, input);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc[0].as<std::string>() == "sqm \\u00B0C 21.35");
+    REQUIRE(doc[1].as<std::string>() == "\\u0041\\u");
+  }
+
+  SECTION("between plain characters, from a stream") {
+    std::istringstream input("[\"sqm \\u00B0C 21.35\",\"\\u0041\\u\"]");
+    DeserializationError err = deserializeJson(doc, input);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc[0].as<std::string>() == "sqm \\u00B0C 21.35");
+    REQUIRE(doc[1].as<std::string>() == "\\u0041\\u");
+  }
+
+  SECTION("in a skipped value") {
+    StaticJsonDocument<64> filter;
+    filter["b"] = true;
+    DeserializationError err = deserializeJson(
+        doc, "{\"a\":\"x\\u0041y\",\"b\":\"\\u0042\"}",
+        DeserializationOption::Filter(filter));
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"b\":\"\\\\u0042\"}");
+  }
 }
@@ -0,0 +1,20 @@
+#define ARDUINOJSON_ENABLE_DIGIT_PAIRS 1
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+
+TEST_CASE("ARDUINOJSON_ENABLE_DIGIT_PAIRS == 1") {
+  StaticJsonDocument<256> doc;
+  doc.add(0);
+  doc.add(7);
+  doc.add(-42);
+  doc.add(1650000600);
+  doc.add(4294967295U);
+  doc.add(3.0625);
+  doc.add(0.000123);
+
+  std::string json;
+  serializeJson(doc, json);
+
+  REQUIRE(json == "[0,7,-42,1650000600,4294967295,3.0625,0.000123]");
+}
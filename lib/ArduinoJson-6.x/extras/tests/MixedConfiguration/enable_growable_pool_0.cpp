@@ -0,0 +1,35 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#define ARDUINOJSON_ENABLE_GROWABLE_POOL 0
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <string>
+
+TEST_CASE("ARDUINOJSON_ENABLE_GROWABLE_POOL == 0") {
+  using namespace ARDUINOJSON_NAMESPACE;
+
+  SECTION("MemoryPool only has its pointers and the overflow flag") {
+    struct FixedPool {
+      char *begin, *left, *right, *end;
+      bool overflowed;
+    };
+
+    REQUIRE(sizeof(MemoryPool) == sizeof(FixedPool));
+  }
+
+  SECTION("mark() and rewind()") {
+    StaticJsonDocument<256> doc;
+    doc.add(1);
+    JsonDocumentMark mark = doc.mark();
+
+    doc.add(std::string("hello"));
+    doc.rewind(mark);
+    doc.add(2);
+
+    REQUIRE(doc.as<std::string>() == "[1,2]");
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(2));
+  }
+}
@@ -0,0 +1,66 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#define ARDUINOJSON_ENABLE_GROWABLE_POOL 1
+#define ARDUINOJSON_ENABLE_STRING_HASH_INDEX 1
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+
+using namespace ARDUINOJSON_NAMESPACE;
+
+// Carves the blocks from a static buffer, so they are close enough for
+// VariantSlot
+class ArenaBlockAllocator : public MemoryBlockAllocator {
+ public:
+  ArenaBlockAllocator()
+      : MemoryBlockAllocator(allocate, deallocate), _used(0) {}
+
+ private:
+  static void* allocate(MemoryBlockAllocator* self, size_t n) {
+    ArenaBlockAllocator* arena = static_cast<ArenaBlockAllocator*>(self);
+    n = addPadding(n);
+    if (arena->_used + n > sizeof(_buffer))
+      return 0;
+    void* p = _buffer + arena->_used;
+    arena->_used += n;
+    return p;
+  }
+
+  static void deallocate(MemoryBlockAllocator*, void*) {}
+
+  static char _buffer[4096];
+  size_t _used;
+};
+
+char ArenaBlockAllocator::_buffer[4096];
+
+// Fills the current block with variants, until the pool chains the next one
+static void growPool(MemoryPool& pool) {
+  size_t blocks = pool.blockCount();
+  while (pool.blockCount() == blocks)
+    REQUIRE(pool.allocVariant() != 0);
+}
+
+TEST_CASE("ARDUINOJSON_ENABLE_GROWABLE_POOL == 1") {
+  ArenaBlockAllocator allocator;
+  MemoryPool pool(allocator, 256);
+
+  SECTION("Finds the strings of the previous blocks with the hash index") {
+    const char* before = pool.saveString(adaptString("sensor"));
+    growPool(pool);
+    // gives the new block a table of its own
+    pool.saveString(adaptString("lux"));
+
+    REQUIRE(pool.saveString(adaptString("sensor")) == before);
+  }
+
+  SECTION("Finds the strings of the current block with the hash index") {
+    growPool(pool);
+    const char* after = pool.saveString(adaptString("sensor"));
+    pool.saveString(adaptString("lux"));
+
+    REQUIRE(pool.saveString(adaptString("sensor")) == after);
+  }
+}
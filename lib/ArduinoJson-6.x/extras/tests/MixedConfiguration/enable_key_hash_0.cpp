@@ -0,0 +1,11 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#define ARDUINOJSON_ENABLE_KEY_HASH 0
+#include <ArduinoJson.h>
+
+// used by enable_key_hash_1.cpp
+size_t variantSlotSizeWithoutKeyHash() {
+  return sizeof(ARDUINOJSON_NAMESPACE::VariantSlot);
+}
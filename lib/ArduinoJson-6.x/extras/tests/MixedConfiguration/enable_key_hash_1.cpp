@@ -0,0 +1,94 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#define ARDUINOJSON_ENABLE_ARDUINO_STRING 1
+#define ARDUINOJSON_ENABLE_PROGMEM 1
+#define ARDUINOJSON_ENABLE_KEY_HASH 1
+#include <ArduinoJson.h>
+
+#include <stdio.h>
+#include <catch.hpp>
+#include <string>
+
+size_t variantSlotSizeWithoutKeyHash();
+
+TEST_CASE("ARDUINOJSON_ENABLE_KEY_HASH = 1") {
+  DynamicJsonDocument doc(16384);
+
+  SECTION("Doesn't change the size of the slots") {
+    CHECK(sizeof(ARDUINOJSON_NAMESPACE::VariantSlot) ==
+          variantSlotSizeWithoutKeyHash());
+  }
+
+  SECTION("Finds every member of a large object") {
+    char key[16];
+    for (int i = 0; i < 300; i++) {
+      sprintf(key, "key%d", i);
+      doc[key] = i;
+    }
+
+    int found = 0;
+    for (int i = 0; i < 300; i++) {
+      sprintf(key, "key%d", i);
+      if (doc.containsKey(key) && doc[key] == i)
+        found++;
+    }
+    CHECK(found == 300);
+    CHECK(doc.containsKey("key300") == false);
+  }
+
+  SECTION("Keys from deserializeJson()") {
+    deserializeJson(doc, "{\"SLEEPTIME_s\":300,\"set_sqm_limit\":21.5}");
+
+    CHECK(doc["SLEEPTIME_s"] == 300);
+    CHECK(doc["set_sqm_limit"] == 21.5);
+    CHECK(doc.containsKey("DISPLAY_ON") == false);
+  }
+
+  SECTION("Keys from deserializeMsgPack()") {
+    deserializeMsgPack(doc, "\x81\xA5hello\x2A");
+
+    CHECK(doc["hello"] == 42);
+    CHECK(doc.containsKey("world") == false);
+  }
+
+  SECTION("Linked and copied keys") {
+    doc["linked"] = 1;
+    doc[std::string("copied")] = 2;
+
+    CHECK(doc[std::string("linked")] == 1);
+    CHECK(doc["copied"] == 2);
+  }
+
+  SECTION("Arduino String and Flash string keys") {
+    doc[String("arduino")] = 1;
+    doc[F("flash")] = 2;
+
+    CHECK(doc[F("arduino")] == 1);
+    CHECK(doc[String("flash")] == 2);
+  }
+
+  SECTION("Keys containing NUL") {
+    doc["hello"] = 1;
+
+    CHECK(doc.containsKey(std::string("hello\0world", 11)) == false);
+    CHECK(doc.containsKey(std::string("hello\0", 6)) == false);
+  }
+
+  SECTION("Copied documents") {
+    doc["hello"] = "world";
+    DynamicJsonDocument copy(doc);
+
+    CHECK(copy["hello"] == "world");
+  }
+
+  SECTION("Removed members") {
+    doc["a"] = 1;
+    doc["b"] = 2;
+    doc.remove("a");
+
+    CHECK(doc.containsKey("a") == false);
+    CHECK(doc["b"] == 2);
+  }
+}
@@ -0,0 +1,25 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#define ARDUINOJSON_ENABLE_STRING_HASH_INDEX 0
+#include <ArduinoJson.h>
+
+#include <string>
+#include <vector>
+
+// Saves the strings in a MemoryPool and returns their offsets
+// (used by enable_string_hash_index_1.cpp to compare the two implementations)
+std::vector<long> saveStringsWithoutHashIndex(
+    const std::vector<std::string>& strings) {
+  using namespace ARDUINOJSON_NAMESPACE;
+  static char buffer[262144];
+  MemoryPool pool(buffer, sizeof(buffer));
+  std::vector<long> offsets;
+  for (size_t i = 0; i < strings.size(); i++) {
+    const char* s = pool.saveString(adaptString(strings[i]));
+    offsets.push_back(s ? long(s - buffer) : -1);
+    pool.allocVariant();
+  }
+  return offsets;
+}
@@ -0,0 +1,102 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#define ARDUINOJSON_ENABLE_STRING_HASH_INDEX 1
+#include <ArduinoJson.h>
+
+#include <stdint.h>
+#include <catch.hpp>
+#include <string>
+#include <vector>
+
+std::vector<long> saveStringsWithoutHashIndex(const std::vector<std::string>&);
+
+static std::vector<long> saveStringsWithHashIndex(
+    const std::vector<std::string>& strings) {
+  using namespace ARDUINOJSON_NAMESPACE;
+  static char buffer[262144];
+  MemoryPool pool(buffer, sizeof(buffer));
+  std::vector<long> offsets;
+  for (size_t i = 0; i < strings.size(); i++) {
+    const char* s = pool.saveString(adaptString(strings[i]));
+    offsets.push_back(s ? long(s - buffer) : -1);
+    pool.allocVariant();
+  }
+  return offsets;
+}
+
+static uint32_t randomWord(uint32_t& state) {
+  // xorshift32
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+static std::vector<std::string> randomStrings(const char* alphabet,
+                                              size_t alphabetSize,
+                                              size_t maxLength) {
+  uint32_t state = 2463534242;
+  std::vector<std::string> strings;
+  for (int i = 0; i < 2000; i++) {
+    std::string s;
+    size_t length = randomWord(state) % (maxLength + 1);
+    for (size_t j = 0; j < length; j++)
+      s += alphabet[randomWord(state) % alphabetSize];
+    strings.push_back(s);
+  }
+  return strings;
+}
+
+TEST_CASE("ARDUINOJSON_ENABLE_STRING_HASH_INDEX = 1") {
+  SECTION("Same deduplication as the linear scan") {
+    std::vector<std::string> strings = randomStrings("abcd", 4, 6);
+
+    CHECK(saveStringsWithHashIndex(strings) ==
+          saveStringsWithoutHashIndex(strings));
+  }
+
+  SECTION("Same deduplication with embedded NULs") {
+    std::vector<std::string> strings = randomStrings("ab\0", 3, 5);
+
+    CHECK(saveStringsWithHashIndex(strings) ==
+          saveStringsWithoutHashIndex(strings));
+  }
+
+  SECTION("Deduplicates keys and values") {
+    DynamicJsonDocument doc(4096);
+    deserializeJson(doc,
+                    "[{\"lux\":\"0.00\",\"errors\":\"\"},"
+                    "{\"lux\":\"0.00\",\"errors\":\"\"}]");
+
+    const char* key1 = doc[0].as<JsonObject>().begin()->key().c_str();
+    const char* key2 = doc[1].as<JsonObject>().begin()->key().c_str();
+    CHECK(key1 == key2);
+    CHECK(doc[0]["lux"].as<const char*>() == doc[1]["lux"].as<const char*>());
+    CHECK(doc[0]["errors"].as<const char*>() ==
+          doc[1]["errors"].as<const char*>());
+  }
+
+  SECTION("Survives shrinkToFit()") {
+    DynamicJsonDocument doc(4096);
+    doc.add(std::string("example"));
+    doc.add(std::string("other"));
+    doc.shrinkToFit();
+
+    // no room left, the only way to succeed is to find the existing copy
+    doc[1] = std::string("example");
+
+    CHECK(doc.overflowed() == false);
+    CHECK(doc[0].as<const char*>() == doc[1].as<const char*>());
+  }
+
+  SECTION("Falls back to the linear scan when the table doesn't fit") {
+    StaticJsonDocument<JSON_ARRAY_SIZE(2) + 8> doc;
+    doc.add(std::string("example"));
+    doc.add(std::string("example"));
+
+    CHECK(doc.overflowed() == false);
+    CHECK(doc[0].as<const char*>() == doc[1].as<const char*>());
+  }
+}
@@ -0,0 +1,31 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#define ARDUINOJSON_USE_SHORTEST_FLOAT_FORMAT 1
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <string>
+
+TEST_CASE("ARDUINOJSON_USE_SHORTEST_FLOAT_FORMAT == 1") {
+  StaticJsonDocument<256> doc;
+  std::string json;
+
+  SECTION("float") {
+    doc["sqm"] = 21.35f;
+    doc["temperature"] = 0.1f;
+    doc["pressure"] = 1013.25f;
+    serializeJson(doc, json);
+
+    REQUIRE(json == "{\"sqm\":21.35,\"temperature\":0.1,\"pressure\":1013.25}");
+  }
+
+  SECTION("double") {
+    doc["sqm"] = 21.35;
+    doc["widened"] = double(21.35f);
+    serializeJson(doc, json);
+
+    REQUIRE(json == "{\"sqm\":21.35,\"widened\":21.35}");
+  }
+}
@@ -0,0 +1,162 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+
+namespace {
+struct Settings {
+  int seeing_thr;
+  double setpoint1;
+  bool display_on;
+  char name[8];
+};
+
+const JsonField<Settings> settingsFields[] = {
+    JsonField<Settings>("seeing_thr", &Settings::seeing_thr),
+    JsonField<Settings>("setpoint1", &Settings::setpoint1),
+    JsonField<Settings>("DISPLAY_ON", &Settings::display_on),
+    JsonField<Settings>("name", &Settings::name),
+};
+
+void resetSettings(Settings& s) {
+  s.seeing_thr = -1;
+  s.setpoint1 = -1;
+  s.display_on = false;
+  strcpy(s.name, "none");
+}
+}  // namespace
+
+TEST_CASE("deserializeMsgPack() into a bound struct") {
+  Settings settings;
+  resetSettings(settings);
+
+  SECTION("fixmap") {
+    DeserializationError err = deserializeMsgPack(
+        settings, settingsFields,
+        "\x84\xAAseeing_thr\x0C\xA9setpoint1\xCB\x40\x0C\x00\x00\x00\x00\x00"
+        "\x00\xAA"
+        "DISPLAY_ON\xC3\xA4name\xA3sqm");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(settings.seeing_thr == 12);
+    REQUIRE(settings.setpoint1 == 3.5);
+    REQUIRE(settings.display_on == true);
+    REQUIRE(std::string(settings.name) == "sqm");
+  }
+
+  SECTION("map 16") {
+    DeserializationError err = deserializeMsgPack(
+        settings, settingsFields, "\xDE\x00\x01\xAAseeing_thr\xCD\x01\x2C");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(settings.seeing_thr == 300);
+  }
+
+  SECTION("map 32") {
+    DeserializationError err = deserializeMsgPack(
+        settings, settingsFields,
+        "\xDF\x00\x00\x00\x01\xAAseeing_thr\xD0\xFF");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(settings.seeing_thr == -1);
+  }
+
+  SECTION("unknown keys are skipped") {
+    DeserializationError err = deserializeMsgPack(
+        settings, settingsFields,
+        "\x84\xA1"
+        "a\x92\x01\x81\xA1"
+        "b\x90\xA1"
+        "c\x81\xAAseeing_thr\x06\xAAseeing_thr\x05\xA1"
+        "d\xD9\x03xyz");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(settings.seeing_thr == 5);
+  }
+
+  SECTION("composite value of a known key") {
+    DeserializationError err = deserializeMsgPack(
+        settings, settingsFields, "\x81\xAAseeing_thr\x91\x07");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(settings.seeing_thr == 0);
+  }
+
+  SECTION("strings are truncated to the size of the array") {
+    DeserializationError err = deserializeMsgPack(
+        settings, settingsFields, "\x81\xA4name\xAA" "0123456789");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(std::string(settings.name) == "0123456");
+  }
+
+  SECTION("key longer than ARDUINOJSON_SCRATCH_BUFFER_SIZE is skipped") {
+    std::string input = "\x82\xD9\xC8" + std::string(200, 'k') +
+                        "\x01\xAAseeing_thr\x04";
+
+    DeserializationError err =
+        deserializeMsgPack(settings, settingsFields, input);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(settings.seeing_thr == 4);
+  }
+
+  SECTION("string longer than ARDUINOJSON_SCRATCH_BUFFER_SIZE") {
+    std::string input = "\x81\xA4name\xD9\xC8" + std::string(200, 'v');
+
+    DeserializationError err =
+        deserializeMsgPack(settings, settingsFields, input);
+
+    REQUIRE(err == DeserializationError::NoMemory);
+  }
+
+  SECTION("root is not a map") {
+    REQUIRE(deserializeMsgPack(settings, settingsFields, "\x91\x01") ==
+            DeserializationError::InvalidInput);
+  }
+
+  SECTION("empty input") {
+    REQUIRE(deserializeMsgPack(settings, settingsFields, std::string()) ==
+            DeserializationError::EmptyInput);
+  }
+
+  SECTION("incomplete input") {
+    std::string input("\x82\xAAseeing_thr\x01");
+
+    REQUIRE(deserializeMsgPack(settings, settingsFields, input) ==
+            DeserializationError::IncompleteInput);
+  }
+
+  SECTION("key is not a string") {
+    REQUIRE(deserializeMsgPack(settings, settingsFields, "\x81\x01\x01") ==
+            DeserializationError::InvalidInput);
+  }
+
+  SECTION("nesting limit") {
+    DeserializationOption::NestingLimit nesting(1);
+
+    REQUIRE(deserializeMsgPack(settings, settingsFields, "\x81\xA1\x61\x90",
+                               nesting) == DeserializationError::TooDeep);
+  }
+
+  SECTION("std::istream") {
+    std::istringstream input(std::string("\x81\xAAseeing_thr\x02", 13));
+
+    REQUIRE(deserializeMsgPack(settings, settingsFields, input) ==
+            DeserializationError::Ok);
+    REQUIRE(settings.seeing_thr == 2);
+  }
+
+  SECTION("char*, size_t") {
+    const char* input = "\x81\xAAseeing_thr\x03\xC1";
+
+    REQUIRE(deserializeMsgPack(settings, settingsFields, input, 13) ==
+            DeserializationError::Ok);
+    REQUIRE(settings.seeing_thr == 3);
+  }
+}
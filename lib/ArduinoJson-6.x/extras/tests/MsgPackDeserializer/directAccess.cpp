@@ -0,0 +1,172 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+// Inputs in RAM are read with memcpy() instead of one byte at a time.
+// These tests compare both paths: the result must be the same.
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct ParseResult {
+  DeserializationError error;
+  std::string json;
+};
+
+// const char* and a size: direct access, the strings are copied
+static ParseResult parseFromBuffer(const std::string& input, size_t capacity) {
+  DynamicJsonDocument doc(capacity);
+  ParseResult result;
+  result.error = deserializeMsgPack(doc, input.data(), input.size());
+  serializeJson(doc, result.json);
+  return result;
+}
+
+// char* and a size: direct access, the strings stay in the input
+static ParseResult parseInPlace(const std::string& input, size_t capacity) {
+  DynamicJsonDocument doc(capacity);
+  std::vector<char> buffer(input.begin(), input.end());
+  buffer.push_back(0);
+  ParseResult result;
+  result.error = deserializeMsgPack(doc, &buffer[0], input.size());
+  serializeJson(doc, result.json);
+  return result;
+}
+
+// std::istream: read one byte at a time
+static ParseResult parseFromStream(const std::string& input, size_t capacity) {
+  DynamicJsonDocument doc(capacity);
+  std::istringstream stream(input);
+  ParseResult result;
+  result.error = deserializeMsgPack(doc, stream);
+  serializeJson(doc, result.json);
+  return result;
+}
+
+static void checkSameResults(const std::string& input) {
+  const size_t capacity = 200000;
+  ParseResult expected = parseFromStream(input, capacity);
+  ParseResult copied = parseFromBuffer(input, capacity);
+  ParseResult moved = parseInPlace(input, capacity);
+
+  CAPTURE(input.size());
+  CHECK(copied.error == expected.error);
+  CHECK(copied.json == expected.json);
+  CHECK(moved.error == expected.error);
+  CHECK(moved.json == expected.json);
+}
+
+static void checkTruncations(const std::string& input, size_t step = 1) {
+  for (size_t n = 0; n < input.size(); n += step)
+    checkSameResults(input.substr(0, n));
+}
+
+static std::string sampleDocument() {
+  DynamicJsonDocument doc(200000);
+  JsonObject root = doc.to<JsonObject>();
+  JsonArray integers = root.createNestedArray("integers");
+  integers.add(0);
+  integers.add(-1);
+  integers.add(-32);
+  integers.add(-33);
+  integers.add(127);
+  integers.add(128);
+  integers.add(-129);
+  integers.add(300);
+  integers.add(-32769);
+  integers.add(70000);
+  integers.add(4294967295UL);
+  integers.add(-2147483647L - 1);
+#if ARDUINOJSON_USE_LONG_LONG
+  integers.add(uint64_t(100000) * 100000 * 100000);
+  integers.add(-int64_t(100000) * 100000 * 100000);
+#endif
+  JsonArray floats = root.createNestedArray("floats");
+  floats.add(0.5f);
+  floats.add(-1.25f);
+  floats.add(3.14159265358979);
+  floats.add(1e300);
+  JsonArray strings = root.createNestedArray("strings");
+  strings.add("");
+  strings.add(std::string(31, 'a'));
+  strings.add(std::string(32, 'b'));
+  strings.add(std::string(255, 'c'));
+  strings.add(std::string(256, 'd'));
+  strings.add(std::string(70000, 'e'));
+  JsonObject nested = root.createNestedObject(std::string(40, 'k'));
+  nested["true"] = true;
+  nested["false"] = false;
+  nested["null"] = static_cast<char*>(0);
+  std::string msgpack;
+  serializeMsgPack(doc, msgpack);
+  return msgpack;
+}
+
+TEST_CASE("deserializeMsgPack() with direct access to the input") {
+  SECTION("all types") {
+    std::string input = sampleDocument();
+
+    checkSameResults(input);
+  }
+
+  SECTION("truncated input") {
+    checkTruncations(sampleDocument(), 61);
+  }
+
+  SECTION("every truncation of the headers") {
+    static const char numbers[] =
+        "\x93\xcd\x01\x02\xd2\x01\x02\x03\x04\xcb"
+        "\x40\x09\x21\xfb\x54\x44\x2d\x18";
+    static const char strings[] =
+        "\x82\xd9\x05hello\xda\x00\x05world\xa1x\xdb\x00\x00\x00\x03"
+        "abc";
+
+    checkTruncations(std::string(numbers, sizeof(numbers) - 1));
+    checkTruncations(std::string(strings, sizeof(strings) - 1));
+  }
+
+  SECTION("skipped values") {
+    // bin 8, bin 16, bin 32, fixext 1, ext 8
+    static const char skipped[] =
+        "\x95\xc4\x02"
+        "ab\xc5\x00\x01x\xc6\x00\x00\x00\x01y\xd4\x01\x02\xc7\x01\x05z";
+    std::string input(skipped, sizeof(skipped) - 1);
+
+    checkSameResults(input);
+    checkTruncations(input);
+  }
+
+  SECTION("filtered values") {
+    std::string input = sampleDocument();
+    StaticJsonDocument<64> filter;
+    filter["integers"] = true;
+
+    DynamicJsonDocument doc1(4096), doc2(4096);
+    std::istringstream stream(input);
+    REQUIRE(deserializeMsgPack(doc1, stream,
+                               DeserializationOption::Filter(filter)) ==
+            DeserializationError::Ok);
+    REQUIRE(deserializeMsgPack(doc2, input.data(), input.size(),
+                               DeserializationOption::Filter(filter)) ==
+            DeserializationError::Ok);
+    REQUIRE(doc1.as<std::string>() == doc2.as<std::string>());
+    REQUIRE(doc2["integers"].size() > 0);
+  }
+
+  SECTION("pool too small") {
+    // only for the copied strings: the others don't use the pool
+    std::string input = sampleDocument();
+
+    for (size_t capacity = 256; capacity < 100000; capacity *= 2) {
+      ParseResult expected = parseFromStream(input, capacity);
+      ParseResult copied = parseFromBuffer(input, capacity);
+
+      CAPTURE(capacity);
+      CHECK(copied.error == expected.error);
+      CHECK(copied.json == expected.json);
+    }
+  }
+}
@@ -0,0 +1,149 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#define ARDUINOJSON_USE_DOUBLE 1
+#define ARDUINOJSON_ENABLE_FAST_FLOAT_PARSING 1
+
+#include <ArduinoJson.hpp>
+#include <catch.hpp>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace ARDUINOJSON_NAMESPACE;
+
+static uint64_t bitsOf(double x) {
+  uint64_t bits;
+  memcpy(&bits, &x, sizeof(bits));
+  return bits;
+}
+
+// xorshift64*, deterministic across platforms
+static uint64_t nextRandom() {
+  static uint64_t state = 0x9E3779B97F4A7C15ULL;
+  state ^= state >> 12;
+  state ^= state << 25;
+  state ^= state >> 27;
+  return state * 0x2545F4914F6CDD1DULL;
+}
+
+static void checkAgainstStrtod(const char* input) {
+  CAPTURE(input);
+  double expected = strtod(input, 0);
+  REQUIRE(bitsOf(parseNumber<double>(input)) == bitsOf(expected));
+}
+
+// With more than 19 significant digits, the fast path may decline, but it
+// must never return a wrong value
+static bool checkFastPathAgainstStrtod(const char* input) {
+  CAPTURE(input);
+  double result;
+  if (!parseFloatFast(input, result))
+    return false;
+  REQUIRE(bitsOf(result) == bitsOf(strtod(input, 0)));
+  return true;
+}
+
+static void generateNumber(char* buffer, int digits) {
+  int exponent = int(nextRandom() % 700) - 350;
+  char* p = buffer;
+  for (int j = 0; j < digits; j++) {
+    if (j == 1)
+      *p++ = '.';
+    *p++ = char((j == 0 ? '1' : '0') + nextRandom() % (j == 0 ? 9 : 10));
+  }
+  sprintf(p, "e%d", exponent);
+}
+
+TEST_CASE("decimalToDouble()") {
+  uint64_t bits;
+
+  SECTION("zero") {
+    REQUIRE(decimalToDouble(0, 0, bits));
+    REQUIRE(bits == 0);
+    REQUIRE(decimalToDouble(0, 300, bits));
+    REQUIRE(bits == 0);
+  }
+
+  SECTION("underflow") {
+    REQUIRE(decimalToDouble(1, -343, bits));
+    REQUIRE(bits == 0);
+  }
+
+  SECTION("overflow") {
+    REQUIRE(decimalToDouble(1, 309, bits));
+    REQUIRE(bits == bitsOf(strtod("inf", 0)));
+  }
+
+  SECTION("exact integers") {
+    for (uint64_t i = 1; i < 100000; i++) {
+      REQUIRE(decimalToDouble(i, 0, bits));
+      REQUIRE(bits == bitsOf(double(i)));
+    }
+  }
+}
+
+TEST_CASE("parseNumber<double>() matches strtod()") {
+  char buffer[64];
+
+  SECTION("shortest round-trip of random doubles") {
+    for (int i = 0; i < 200000; i++) {
+      double x;
+      uint64_t bits = nextRandom() & 0x7FFFFFFFFFFFFFFFULL;
+      memcpy(&x, &bits, sizeof(x));
+      if (x != x || x * 2 == x)  // NaN or infinity
+        continue;
+      sprintf(buffer, "%.17g", x);
+      checkAgainstStrtod(buffer);
+      sprintf(buffer, "%.15g", x);
+      checkAgainstStrtod(buffer);
+    }
+  }
+
+  SECTION("random digits and exponents") {
+    for (int i = 0; i < 200000; i++) {
+      generateNumber(buffer, 1 + int(nextRandom() % 19));
+      checkAgainstStrtod(buffer);
+    }
+  }
+
+  SECTION("more than 19 digits") {
+    int accepted = 0;
+    for (int i = 0; i < 100000; i++) {
+      generateNumber(buffer, 20 + int(nextRandom() % 20));
+      if (checkFastPathAgainstStrtod(buffer))
+        accepted++;
+    }
+    REQUIRE(accepted > 99000);  // falling back should be rare
+  }
+
+  SECTION("subnormals") {
+    checkAgainstStrtod("4.9406564584124654e-324");
+    checkAgainstStrtod("2.4703282292062328e-324");  // rounds up to min
+    checkAgainstStrtod("2.4703282292062327e-324");  // rounds down to zero
+    checkAgainstStrtod("2.2250738585072011e-308");
+    checkAgainstStrtod("2.2250738585072012e-308");
+  }
+
+  SECTION("halfway cases") {
+    checkAgainstStrtod("9007199254740993");    // 2^53 + 1
+    checkAgainstStrtod("9007199254740995");    // 2^53 + 3
+    checkAgainstStrtod("9007199254740993.0");  // 2^53 + 1
+    checkAgainstStrtod("1.00000000000000011102230246251565404236316680908203125");
+    checkFastPathAgainstStrtod(
+        "1.00000000000000011102230246251565404236316680908203124");
+    checkFastPathAgainstStrtod(
+        "1.00000000000000011102230246251565404236316680908203126");
+  }
+
+  SECTION("values that the previous algorithm rounded incorrectly") {
+    checkAgainstStrtod("0.1");
+    checkAgainstStrtod("0.3");
+    checkAgainstStrtod("2.2250738585072014e-308");
+    checkAgainstStrtod("1.7976931348623157e308");
+    checkAgainstStrtod("21.57");
+    checkAgainstStrtod("-0.000123456789012345678");
+  }
+}
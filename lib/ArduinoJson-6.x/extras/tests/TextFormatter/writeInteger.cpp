@@ -6,6 +6,8 @@
 #include <limits>
 #include <string>
 
+#include <string.h>  // memcmp
+
 #include <ArduinoJson/Json/TextFormatter.hpp>
 #include <ArduinoJson/Serialization/Writer.hpp>
 
@@ -53,3 +55,93 @@ TEST_CASE("uint32_t") {
   checkWriteInteger<uint32_t>(0, "0");
   checkWriteInteger<uint32_t>(4294967295U, "4294967295");
 }
+
+TEST_CASE("int64_t") {
+  checkWriteInteger<int64_t>(0, "0");
+  checkWriteInteger<int64_t>(-int64_t(9223372036) * 1000000000 - 854775807 - 1,
+                             "-9223372036854775808");
+  checkWriteInteger<int64_t>(int64_t(9223372036) * 1000000000 + 854775807,
+                             "9223372036854775807");
+}
+
+TEST_CASE("uint64_t") {
+  checkWriteInteger<uint64_t>(0, "0");
+  checkWriteInteger<uint64_t>(uint64_t(4294967295U) + 1, "4294967296");
+  checkWriteInteger<uint64_t>(uint64_t(1000000000) * 100000000,
+                              "100000000000000000");
+  checkWriteInteger<uint64_t>(uint64_t(1000000000) * 100000000 + 7,
+                              "100000000000000007");
+  checkWriteInteger<uint64_t>(
+      uint64_t(18446744073U) * 1000000000 + 709551615,
+      "18446744073709551615");
+}
+
+TEST_CASE("powers of ten") {
+  uint64_t power = 1;
+  std::string digits = "1";
+  for (int i = 0; i < 20; i++) {
+    checkWriteInteger<uint64_t>(power, digits);
+    checkWriteInteger<uint64_t>(power - 1, i ? std::string(size_t(i), '9')
+                                             : std::string("0"));
+    checkWriteInteger<uint64_t>(power + 1,
+                                i ? digits.substr(0, digits.size() - 1) + "1"
+                                  : std::string("2"));
+    power *= 10;
+    digits += "0";
+  }
+}
+
+// Checks countDigits() and writeDigitPairs() against a decimal counter,
+// incremented like a string
+template <typename T>
+static void checkRange(T first, T last) {
+  char counter[20];
+  char* end = counter + sizeof(counter);
+  char* begin = writeDigitPairs(first, end);  // trusted for the first value
+  for (T value = first;; value++) {
+    char output[20];
+    size_t length = countDigits(value);
+    if (length != size_t(end - begin) ||
+        writeDigitPairs(value, output + length) != output ||
+        memcmp(output, begin, length) != 0) {
+      CAPTURE(value);
+      FAIL(std::string(output, length) + " != " + std::string(begin, end));
+    }
+    if (value == last)
+      break;
+    for (char* p = end;;) {
+      if (p == begin) {
+        *--begin = '1';
+        break;
+      }
+      if (*--p != '9') {
+        ++*p;
+        break;
+      }
+      *p = '0';
+    }
+  }
+}
+
+TEST_CASE("writeDigitPairs()") {
+  SECTION("first 1000000 values") {
+    checkRange<uint32_t>(0, 999999);
+  }
+
+  SECTION("around 2^32") {
+    checkRange<uint32_t>(4294000000U, 4294967295U);
+    checkRange<uint64_t>(4294967295U, uint64_t(4294967295U) + 1000000);
+  }
+
+  SECTION("around the chunks of 8 digits") {
+    uint64_t chunk = 100000000;
+    checkRange<uint64_t>(chunk * 100 - 500000, chunk * 100 + 500000);
+    checkRange<uint64_t>(chunk * chunk - 500000, chunk * chunk + 500000);
+  }
+}
+
+// Hidden because it takes a few minutes; run it with:
+//   TextFormatterTests "[.exhaustive]"
+TEST_CASE("writeDigitPairs() over the full 32-bit range", "[.exhaustive]") {
+  checkRange<uint32_t>(0, 4294967295U);
+}
@@ -0,0 +1,207 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#include <catch.hpp>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits>
+#include <string>
+
+#define ARDUINOJSON_ENABLE_NAN 1
+#define ARDUINOJSON_ENABLE_INFINITY 1
+#define ARDUINOJSON_USE_SHORTEST_FLOAT_FORMAT 1
+#include <ArduinoJson/Json/TextFormatter.hpp>
+#include <ArduinoJson/Serialization/Writer.hpp>
+
+using namespace ARDUINOJSON_NAMESPACE;
+
+template <typename TFloat>
+static std::string format(TFloat input) {
+  std::string output;
+  Writer<std::string> sb(output);
+  TextFormatter<Writer<std::string> > writer(sb);
+  writer.writeFloat(input);
+  REQUIRE(writer.bytesWritten() == output.size());
+  return output;
+}
+
+template <typename TFloat>
+static void check(TFloat input, const std::string& expected) {
+  CHECK(format(input) == expected);
+}
+
+static double parse(const std::string& s, double) {
+  return strtod(s.c_str(), 0);
+}
+
+static float parse(const std::string& s, float) {
+  return strtof(s.c_str(), 0);
+}
+
+// Formats the value and parses it back, then compares the bits
+template <typename TFloat>
+static bool roundTrips(TFloat input) {
+  std::string output = format(input);
+  TFloat result = parse(output, input);
+  if (memcmp(&result, &input, sizeof(TFloat)) == 0)
+    return true;
+  WARN(output);
+  return false;
+}
+
+static uint32_t randomWord(uint32_t& state) {
+  // xorshift32
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+static double randomDouble(uint32_t& state) {
+  uint64_t bits;
+  double value;
+  do {
+    bits = (uint64_t(randomWord(state)) << 32) | randomWord(state);
+    memcpy(&value, &bits, sizeof(value));
+  } while (value != value || value - value != 0);  // skip NaN and infinity
+  return value;
+}
+
+static float randomFloat(uint32_t& state) {
+  uint32_t bits;
+  float value;
+  do {
+    bits = randomWord(state);
+    memcpy(&value, &bits, sizeof(value));
+  } while (value != value || value - value != 0);  // skip NaN and infinity
+  return value;
+}
+
+TEST_CASE("TextFormatter::writeFloat(double) with shortest format") {
+  SECTION("Pi") {
+    check<double>(3.14159265359, "3.14159265359");
+  }
+
+  SECTION("Zero") {
+    check<double>(0.0, "0");
+  }
+
+  SECTION("Decimals that are not exact in binary") {
+    check<double>(0.1, "0.1");
+    check<double>(21.57, "21.57");
+    check<double>(0.1 + 0.2, "0.30000000000000004");
+  }
+
+  SECTION("Integers") {
+    check<double>(1.0, "1");
+    check<double>(1000.0, "1000");
+    check<double>(9999999.0, "9999999");
+  }
+
+  SECTION("Negative values") {
+    check<double>(-1.5, "-1.5");
+    check<double>(-0.001, "-0.001");
+  }
+
+  SECTION("Small values use the exponent above the threshold") {
+    check<double>(0.000123, "0.000123");
+    check<double>(1e-5, "1e-5");
+    check<double>(1.5e-7, "1.5e-7");
+  }
+
+  SECTION("Big values use the exponent above the threshold") {
+    check<double>(1e7, "1e7");
+    check<double>(12345678.9, "1.23456789e7");
+  }
+
+  SECTION("Extremes") {
+    check<double>(1.7976931348623157e308, "1.7976931348623157e308");
+    check<double>(2.2250738585072014e-308, "2.2250738585072014e-308");
+    check<double>(5e-324, "5e-324");
+  }
+
+  SECTION("Infinity") {
+    check<double>(std::numeric_limits<double>::infinity(), "Infinity");
+  }
+
+  SECTION("NaN") {
+    check<double>(std::numeric_limits<double>::quiet_NaN(), "NaN");
+  }
+
+  SECTION("Random bit patterns round-trip") {
+    uint32_t state = 2463534242;
+    int failures = 0;
+    for (int i = 0; i < 100000; i++) {
+      if (!roundTrips(randomDouble(state)))
+        failures++;
+    }
+    CHECK(failures == 0);
+  }
+
+  SECTION("Floats stored as doubles get the digits of the float") {
+    check<double>(21.35f, "21.35");
+    check<double>(0.1f, "0.1");
+    check<double>(-12.4f, "-12.4");
+    check<double>(3.4028235e38f, "3.4028235e38");
+    check<double>(1e-45f, "1e-45");
+  }
+
+  SECTION("Floats stored as doubles round-trip as floats") {
+    uint32_t state = 362436069;
+    int failures = 0;
+    for (int i = 0; i < 100000; i++) {
+      float value = randomFloat(state);
+      if (parse(format<double>(value), value) != value) {
+        WARN(format<double>(value));
+        failures++;
+      }
+    }
+    CHECK(failures == 0);
+  }
+
+  SECTION("Short decimals round-trip and keep their digits") {
+    uint32_t state = 88675123;
+    int failures = 0;
+    for (int i = 0; i < 10000; i++) {
+      uint32_t mantissa = randomWord(state) % 100000;
+      double value = double(mantissa) / 100;
+      char expected[32];
+      sprintf(expected, "%.15g", value);
+      if (format(value) != expected) {
+        WARN(expected);
+        failures++;
+      }
+    }
+    CHECK(failures == 0);
+  }
+}
+
+TEST_CASE("TextFormatter::writeFloat(float) with shortest format") {
+  SECTION("Pi") {
+    check<float>(3.14159265359f, "3.1415927");
+  }
+
+  SECTION("Sensor readings") {
+    check<float>(21.57f, "21.57");
+    check<float>(-12.4f, "-12.4");
+    check<float>(1013.25f, "1013.25");
+  }
+
+  SECTION("Big and small values") {
+    check<float>(3.4028235e38f, "3.4028235e38");
+    check<float>(1e-45f, "1e-45");
+  }
+
+  SECTION("Random bit patterns round-trip") {
+    uint32_t state = 123456789;
+    int failures = 0;
+    for (int i = 0; i < 100000; i++) {
+      if (!roundTrips(randomFloat(state)))
+        failures++;
+    }
+    CHECK(failures == 0);
+  }
+}
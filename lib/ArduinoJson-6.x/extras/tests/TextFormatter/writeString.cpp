@@ -18,6 +18,15 @@ void check(const char* input, std::string expected) {
   REQUIRE(writer.bytesWritten() == expected.size());
 }
 
+void check(const std::string& input, std::string expected) {
+  char output[128] = {0};
+  StaticStringWriter sb(output, sizeof(output));
+  TextFormatter<StaticStringWriter> writer(sb);
+  writer.writeString(input.data(), input.size());
+  REQUIRE(expected == output);
+  REQUIRE(writer.bytesWritten() == expected.size());
+}
+
 TEST_CASE("TextFormatter::writeString()") {
   SECTION("EmptyString") {
     check("", "\"\"");
@@ -54,4 +63,37 @@ TEST_CASE("TextFormatter::writeString()") {
   SECTION("HorizontalTab") {
     check("\t", "\"\\t\"");
   }
+
+  SECTION("Other control characters are not escaped") {
+    check("\x01\x1F", "\"\x01\x1F\"");
+  }
+
+  SECTION("Non-ASCII characters") {
+    check("caf\xC3\xA9 \xE2\x82\xAC", "\"caf\xC3\xA9 \xE2\x82\xAC\"");
+  }
+
+  SECTION("Long string without escape sequence") {
+    check("abcdefghijklmnopqrstuvwxyz0123456789",
+          "\"abcdefghijklmnopqrstuvwxyz0123456789\"");
+  }
+
+  SECTION("Escape sequences at every position of a word") {
+    for (size_t i = 0; i < 17; i++) {
+      std::string input(17, 'x');
+      input[i] = '"';
+      std::string expected = "\"" + input.substr(0, i) + "\\\"" +
+                             input.substr(i + 1) + "\"";
+      check(input.c_str(), expected);
+    }
+  }
+
+  SECTION("Consecutive escape sequences in a long string") {
+    check("first line\r\nsecond \"line\"\\\tend",
+          "\"first line\\r\\nsecond \\\"line\\\"\\\\\\tend\"");
+  }
+
+  SECTION("Null character, when the size is given") {
+    check(std::string("hello\0world!!", 13),
+          "\"hello\\u0000world!!\"");
+  }
 }
@@ -26,6 +26,10 @@
 #include "ArduinoJson/Variant/VariantRef.hpp"
 
 #include "ArduinoJson/Document/DynamicJsonDocument.hpp"
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+#  include "ArduinoJson/Document/GrowableJsonDocument.hpp"
+#endif
+#include "ArduinoJson/Document/InstrumentedAllocator.hpp"
 #include "ArduinoJson/Document/StaticJsonDocument.hpp"
 
 #include "ArduinoJson/Array/ArrayImpl.hpp"
@@ -38,11 +42,15 @@
 #include "ArduinoJson/Variant/VariantCompare.hpp"
 #include "ArduinoJson/Variant/VariantImpl.hpp"
 
+#include "ArduinoJson/Json/IncrementalJsonParser.hpp"
 #include "ArduinoJson/Json/JsonDeserializer.hpp"
+#include "ArduinoJson/Json/JsonDocumentBuilder.hpp"
+#include "ArduinoJson/Json/JsonSequence.hpp"
 #include "ArduinoJson/Json/JsonSerializer.hpp"
 #include "ArduinoJson/Json/PrettyJsonSerializer.hpp"
 #include "ArduinoJson/MsgPack/MsgPackDeserializer.hpp"
 #include "ArduinoJson/MsgPack/MsgPackSerializer.hpp"
+#include "ArduinoJson/Serialization/ChunkedBuffer.hpp"
 
 #include "ArduinoJson/compatibility.hpp"
 
@@ -59,19 +67,38 @@ typedef ARDUINOJSON_NAMESPACE::String JsonString;
 typedef ARDUINOJSON_NAMESPACE::UInt JsonUInt;
 typedef ARDUINOJSON_NAMESPACE::VariantConstRef JsonVariantConst;
 typedef ARDUINOJSON_NAMESPACE::VariantRef JsonVariant;
+using ARDUINOJSON_NAMESPACE::BasicChunkedBuffer;
 using ARDUINOJSON_NAMESPACE::BasicJsonDocument;
+using ARDUINOJSON_NAMESPACE::BufferChunk;
+using ARDUINOJSON_NAMESPACE::ChunkedBuffer;
 using ARDUINOJSON_NAMESPACE::copyArray;
 using ARDUINOJSON_NAMESPACE::DeserializationError;
 using ARDUINOJSON_NAMESPACE::deserializeJson;
 using ARDUINOJSON_NAMESPACE::deserializeMsgPack;
 using ARDUINOJSON_NAMESPACE::DynamicJsonDocument;
+using ARDUINOJSON_NAMESPACE::IncrementalJsonDeserializer;
+using ARDUINOJSON_NAMESPACE::IncrementalJsonParser;
 using ARDUINOJSON_NAMESPACE::JsonDocument;
+using ARDUINOJSON_NAMESPACE::JsonDocumentBuilder;
+using ARDUINOJSON_NAMESPACE::JsonDocumentMark;
+using ARDUINOJSON_NAMESPACE::JsonField;
+using ARDUINOJSON_NAMESPACE::JsonHandler;
+using ARDUINOJSON_NAMESPACE::JsonSequence;
 using ARDUINOJSON_NAMESPACE::measureJson;
 using ARDUINOJSON_NAMESPACE::serialized;
 using ARDUINOJSON_NAMESPACE::serializeJson;
 using ARDUINOJSON_NAMESPACE::serializeJsonPretty;
 using ARDUINOJSON_NAMESPACE::serializeMsgPack;
 using ARDUINOJSON_NAMESPACE::StaticJsonDocument;
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+using ARDUINOJSON_NAMESPACE::BasicGrowableJsonDocument;
+using ARDUINOJSON_NAMESPACE::GrowableJsonDocument;
+#endif
+#if ARDUINOJSON_ENABLE_MEMORY_STATS
+using ARDUINOJSON_NAMESPACE::AllocatorStats;
+using ARDUINOJSON_NAMESPACE::InstrumentedAllocator;
+using ARDUINOJSON_NAMESPACE::MemoryPoolStats;
+#endif
 
 namespace DeserializationOption {
 using ARDUINOJSON_NAMESPACE::Filter;
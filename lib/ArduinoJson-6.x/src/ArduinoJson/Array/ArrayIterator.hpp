@@ -27,7 +27,7 @@ class VariantPtr {
 
 class ArrayIterator {
  public:
-  ArrayIterator() : _slot(0) {}
+  ArrayIterator() : _pool(0), _slot(0) {}
   explicit ArrayIterator(MemoryPool* pool, VariantSlot* slot)
       : _pool(pool), _slot(slot) {}
 
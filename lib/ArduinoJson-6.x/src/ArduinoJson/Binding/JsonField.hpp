@@ -0,0 +1,59 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Variant/VariantRef.hpp>
+
+namespace ARDUINOJSON_NAMESPACE {
+
+template <typename T, typename TMember>
+struct FieldAssigner {
+  static void assign(T& object, char T::*member, VariantConstRef value) {
+    object.*reinterpret_cast<TMember T::*>(member) = value.as<TMember>();
+  }
+};
+
+// Character arrays receive a copy of the string, truncated if needed
+template <typename T, size_t N>
+struct FieldAssigner<T, char[N]> {
+  static void assign(T& object, char T::*member, VariantConstRef value) {
+    char* dst = object.*reinterpret_cast<char(T::*)[N]>(member);
+    const char* src = value.as<const char*>();
+    size_t i = 0;
+    if (src) {
+      for (; i < N - 1 && src[i]; i++)
+        dst[i] = src[i];
+    }
+    dst[i] = 0;
+  }
+};
+
+// Binds a key of a JSON object to a member of the struct T.
+// The member pointer is stored with a common type so that fields of different
+// types can live in the same table; FieldAssigner casts it back.
+template <typename T>
+class JsonField {
+ public:
+  template <typename TMember>
+  JsonField(const char* key, TMember T::*member)
+      : _key(key),
+        _member(reinterpret_cast<char T::*>(member)),
+        _assign(&FieldAssigner<T, TMember>::assign) {}
+
+  const char* key() const {
+    return _key;
+  }
+
+  void assign(T& object, VariantConstRef value) const {
+    _assign(object, _member, value);
+  }
+
+ private:
+  const char* _key;
+  char T::*_member;
+  void (*_assign)(T&, char T::*, VariantConstRef);
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
@@ -0,0 +1,38 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Binding/JsonField.hpp>
+#include <ArduinoJson/Strings/StringAdapters.hpp>
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// The object being deserialized and the table of its fields
+template <typename T>
+class ObjectBinding {
+ public:
+  ObjectBinding(T& object, const JsonField<T>* fields, size_t count)
+      : _object(&object), _fields(fields), _count(count) {}
+
+  // Returns the field bound to this key, or null if the key is unknown
+  const JsonField<T>* find(String key) const {
+    for (size_t i = 0; i < _count; i++) {
+      if (stringEquals(adaptString(key), adaptString(_fields[i].key())))
+        return &_fields[i];
+    }
+    return 0;
+  }
+
+  void assign(const JsonField<T>* field, const VariantData& value) {
+    field->assign(*_object, VariantConstRef(&value));
+  }
+
+ private:
+  T* _object;
+  const JsonField<T>* _fields;
+  size_t _count;
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
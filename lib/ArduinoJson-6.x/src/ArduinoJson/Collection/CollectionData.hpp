@@ -73,6 +73,10 @@ class CollectionData {
 
   void movePointers(ptrdiff_t stringDistance, ptrdiff_t variantDistance);
 
+  // Unlinks the slots that follow the tail, after MemoryPool::rewind()
+  // discarded them
+  void truncate();
+
  private:
   VariantSlot* getSlot(size_t index) const;
 
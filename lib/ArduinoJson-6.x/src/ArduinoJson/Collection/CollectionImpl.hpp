@@ -78,9 +78,18 @@ template <typename TAdaptedString>
 inline VariantSlot* CollectionData::getSlot(TAdaptedString key) const {
   if (key.isNull())
     return 0;
+#if ARDUINOJSON_ENABLE_KEY_HASH
+  // compare the hashes first to skip most string comparisons
+  uint8_t hash = hashKey(key);
+#endif
   VariantSlot* slot = _head;
   while (slot) {
+#if ARDUINOJSON_ENABLE_KEY_HASH
+    if (slot->keyHash() == hash &&
+        stringEquals(key, adaptString(slot->key())))
+#else
     if (stringEquals(key, adaptString(slot->key())))
+#endif
       break;
     slot = slot->next();
   }
@@ -186,6 +195,11 @@ inline void movePointer(T*& p, ptrdiff_t offset) {
   ARDUINOJSON_ASSERT(isAligned(p));
 }
 
+inline void CollectionData::truncate() {
+  if (_tail)
+    _tail->setNext(0);
+}
+
 inline void CollectionData::movePointers(ptrdiff_t stringDistance,
                                          ptrdiff_t variantDistance) {
   movePointer(_head, variantDistance);
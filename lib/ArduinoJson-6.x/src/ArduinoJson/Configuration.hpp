@@ -98,6 +98,20 @@
 #  define ARDUINOJSON_DEFAULT_NESTING_LIMIT 10
 #endif
 
+// Parse the nested arrays and objects with a loop and an explicit stack,
+// instead of one recursive call per level, so that the stack usage of
+// deserializeJson() doesn't depend on the nesting of the document
+#ifndef ARDUINOJSON_ENABLE_ITERATIVE_PARSING
+#  define ARDUINOJSON_ENABLE_ITERATIVE_PARSING 0
+#endif
+
+// Maximum nesting of the arrays and objects stored by the iterative parser;
+// each level takes a pointer and a filter on the explicit stack.
+// Skipped values only take one bit per level.
+#ifndef ARDUINOJSON_ITERATIVE_PARSING_MAX_DEPTH
+#  define ARDUINOJSON_ITERATIVE_PARSING_MAX_DEPTH 32
+#endif
+
 // Number of bits to store the pointer to next node
 // (saves RAM but limits the number of values in a document)
 #ifndef ARDUINOJSON_SLOT_OFFSET_SIZE
@@ -191,6 +205,35 @@
 #  define ARDUINOJSON_NEGATIVE_EXPONENTIATION_THRESHOLD 1e-5
 #endif
 
+// Parse floating-point values with the Eisel-Lemire algorithm: faster and
+// correctly rounded, but requires a 10KB table, so it's off by default on
+// AVR, ESP8266 and ESP32
+#ifndef ARDUINOJSON_ENABLE_FAST_FLOAT_PARSING
+#  if defined(__AVR) || defined(ESP8266) || defined(ESP32) || \
+      !ARDUINOJSON_USE_DOUBLE
+#    define ARDUINOJSON_ENABLE_FAST_FLOAT_PARSING 0
+#  else
+#    define ARDUINOJSON_ENABLE_FAST_FLOAT_PARSING 1
+#  endif
+#endif
+
+// Serialize floating-point values with the shortest representation that
+// reads back as the same value (e.g. 0.1 instead of 0.100000001), instead of
+// a fixed number of significant digits; requires a 600-byte table
+#ifndef ARDUINOJSON_USE_SHORTEST_FLOAT_FORMAT
+#  define ARDUINOJSON_USE_SHORTEST_FLOAT_FORMAT 0
+#endif
+
+// Serialize integers two digits at a time, with a 200-byte table, instead of
+// one division per digit
+#ifndef ARDUINOJSON_ENABLE_DIGIT_PAIRS
+#  if defined(__AVR)
+#    define ARDUINOJSON_ENABLE_DIGIT_PAIRS 0
+#  else
+#    define ARDUINOJSON_ENABLE_DIGIT_PAIRS 1
+#  endif
+#endif
+
 #ifndef ARDUINOJSON_LITTLE_ENDIAN
 #  if defined(_MSC_VER) ||                           \
       (defined(__BYTE_ORDER__) &&                    \
@@ -202,6 +245,18 @@
 #  endif
 #endif
 
+// Swap the bytes of the MessagePack integers and floats with the compiler's
+// intrinsics, instead of one byte at a time
+#ifndef ARDUINOJSON_HAS_BUILTIN_BSWAP
+#  if defined(__clang__) || \
+      (defined(__GNUC__) &&  \
+       (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 8)))
+#    define ARDUINOJSON_HAS_BUILTIN_BSWAP 1
+#  else
+#    define ARDUINOJSON_HAS_BUILTIN_BSWAP 0
+#  endif
+#endif
+
 #ifndef ARDUINOJSON_ENABLE_ALIGNMENT
 #  if defined(__AVR)
 #    define ARDUINOJSON_ENABLE_ALIGNMENT 0
@@ -218,10 +273,56 @@
 #  define ARDUINOJSON_ENABLE_STRING_DEDUPLICATION 1
 #endif
 
+// Find duplicate strings with a hash table stored next to the variants,
+// instead of scanning all the strings of the pool.
+// Makes deduplication O(1), but the table uses 8 to 16 bytes per distinct
+// string.
+#ifndef ARDUINOJSON_ENABLE_STRING_HASH_INDEX
+#  define ARDUINOJSON_ENABLE_STRING_HASH_INDEX 0
+#endif
+
+// Store an 8-bit hash of the key in each slot, so that looking up a member
+// skips most string comparisons.
+// The hash uses padding bytes of VariantSlot, except on 8-bit platforms where
+// each slot grows by one byte.
+#ifndef ARDUINOJSON_ENABLE_KEY_HASH
+#  define ARDUINOJSON_ENABLE_KEY_HASH 0
+#endif
+
+// Let the memory pool chain blocks instead of overflowing, for
+// GrowableJsonDocument and JsonDocument::peakMemoryUsage().
+// Adds four members to each pool, and makes memoryUsage() and capacity() walk
+// the blocks.
+#ifndef ARDUINOJSON_ENABLE_GROWABLE_POOL
+#  define ARDUINOJSON_ENABLE_GROWABLE_POOL 0
+#endif
+
+// Count the allocations of the JsonDocuments (slots, strings, deduplicated
+// strings, overflows, blocks) and the high-water mark of their memory pool,
+// and provide InstrumentedAllocator to count the calls to the heap.
+// Adds an increment to each allocation and seven counters to each document.
+#ifndef ARDUINOJSON_ENABLE_MEMORY_STATS
+#  define ARDUINOJSON_ENABLE_MEMORY_STATS 0
+#endif
+
 #ifndef ARDUINOJSON_STRING_BUFFER_SIZE
 #  define ARDUINOJSON_STRING_BUFFER_SIZE 32
 #endif
 
+// Size of the buffer that holds the keys and the string values when
+// deserializing without a JsonDocument, for example into a struct with a
+// JsonField table.
+// Longer keys are treated as unknown; longer strings produce NoMemory.
+#ifndef ARDUINOJSON_SCRATCH_BUFFER_SIZE
+#  define ARDUINOJSON_SCRATCH_BUFFER_SIZE 64
+#endif
+
+// Size of the buffer that holds the bytes read from a Stream when the size of
+// the document is known, as in deserializeJson(doc, stream, size)
+#ifndef ARDUINOJSON_STREAM_BUFFER_SIZE
+#  define ARDUINOJSON_STREAM_BUFFER_SIZE 64
+#endif
+
 #ifndef ARDUINOJSON_DEBUG
 #  ifdef __PLATFORMIO_BUILD_DEBUG__
 #    define ARDUINOJSON_DEBUG 1
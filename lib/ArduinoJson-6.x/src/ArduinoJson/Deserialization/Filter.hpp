@@ -10,6 +10,7 @@ namespace ARDUINOJSON_NAMESPACE {
 
 class Filter {
  public:
+  Filter() {}  // allows nothing
   explicit Filter(VariantConstRef v) : _variant(v) {}
 
   bool allow() const {
@@ -63,4 +64,34 @@ struct AllowAllFilter {
   }
 };
 
+// Keeps a single value but skips arrays and objects
+class ValueOnlyFilter {
+ public:
+  explicit ValueOnlyFilter(bool allow = true) : _allow(allow) {}
+
+  bool allow() const {
+    return _allow;
+  }
+
+  bool allowArray() const {
+    return false;
+  }
+
+  bool allowObject() const {
+    return false;
+  }
+
+  bool allowValue() const {
+    return _allow;
+  }
+
+  template <typename TKey>
+  ValueOnlyFilter operator[](const TKey&) const {
+    return ValueOnlyFilter(false);
+  }
+
+ private:
+  bool _allow;
+};
+
 }  // namespace ARDUINOJSON_NAMESPACE
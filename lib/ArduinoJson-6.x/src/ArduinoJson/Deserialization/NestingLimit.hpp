@@ -23,6 +23,10 @@ class NestingLimit {
     return _value == 0;
   }
 
+  uint8_t value() const {
+    return _value;
+  }
+
  private:
   uint8_t _value;
 };
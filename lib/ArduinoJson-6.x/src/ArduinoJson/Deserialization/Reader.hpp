@@ -5,6 +5,7 @@
 #pragma once
 
 #include <ArduinoJson/Namespace.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
 
 #include <stdlib.h>  // for size_t
 
@@ -33,6 +34,11 @@ struct BoundedReader {
   // no default implementation because we need to pass the size to the
   // constructor
 };
+
+// Tells if the reader gives direct access to an input stored in RAM, through
+// cursor(), end() (null if the input is null-terminated), and skip()
+template <typename TReader, typename Enable = void>
+struct ReaderHasDirectAccess : false_type {};
 }  // namespace ARDUINOJSON_NAMESPACE
 
 #include <ArduinoJson/Deserialization/Readers/IteratorReader.hpp>
@@ -28,4 +28,61 @@ struct Reader<TSource,
   Stream* _stream;
 };
 
+// Reads a document of known size (for example, the Content-Length of an HTTP
+// response) by blocks, instead of one character at a time.
+// Each block is limited to the bytes available and to the rest of the
+// document, so the reader never waits for nor consumes the bytes that follow.
+template <typename TSource>
+struct BoundedReader<
+    TSource, typename enable_if<is_base_of<Stream, TSource>::value>::type> {
+ public:
+  explicit BoundedReader(Stream& stream, size_t size)
+      : _stream(&stream), _remaining(size), _begin(0), _end(0) {}
+
+  int read() {
+    if (_begin == _end && !fill())
+      return -1;
+    return static_cast<unsigned char>(_buffer[_begin++]);
+  }
+
+  size_t readBytes(char* buffer, size_t length) {
+    size_t n = 0;
+    while (n < length && _begin < _end)
+      buffer[n++] = _buffer[_begin++];
+    if (n < length) {
+      size_t count = _stream->readBytes(buffer + n, limit(length - n));
+      _remaining -= count;
+      n += count;
+    }
+    return n;
+  }
+
+ private:
+  bool fill() {
+    size_t n = limit(sizeof(_buffer));
+    if (!n)
+      return false;
+    // wait for a single byte if nothing is available, like read() does
+    int available = _stream->available();
+    if (available <= 0)
+      n = 1;
+    else if (static_cast<size_t>(available) < n)
+      n = static_cast<size_t>(available);
+    _end = _stream->readBytes(_buffer, n);
+    _begin = 0;
+    _remaining -= _end;
+    return _end > 0;
+  }
+
+  size_t limit(size_t n) const {
+    return n < _remaining ? n : _remaining;
+  }
+
+  Stream* _stream;
+  size_t _remaining;
+  // indexes rather than pointers, because the reader is copied
+  size_t _begin, _end;
+  char _buffer[ARDUINOJSON_STREAM_BUFFER_SIZE];
+};
+
 }  // namespace ARDUINOJSON_NAMESPACE
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <ArduinoJson/Polyfills/assert.hpp>
+
 namespace ARDUINOJSON_NAMESPACE {
 
 template <typename TIterator>
@@ -26,8 +28,27 @@ class IteratorReader {
     while (i < length && _ptr < _end) buffer[i++] = *_ptr++;
     return i;
   }
+
+  TIterator cursor() const {
+    return _ptr;
+  }
+
+  TIterator end() const {
+    return _end;
+  }
+
+  void skip(size_t n) {
+    ARDUINOJSON_ASSERT(n <= size_t(_end - _ptr));
+    _ptr += n;
+  }
 };
 
+template <typename TReader>
+struct ReaderHasDirectAccess<
+    TReader, typename enable_if<
+                 is_base_of<IteratorReader<const char*>, TReader>::value>::type>
+    : true_type {};
+
 template <typename T>
 struct void_ {
   typedef void type;
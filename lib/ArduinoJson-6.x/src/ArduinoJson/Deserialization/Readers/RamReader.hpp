@@ -35,8 +35,25 @@ struct Reader<TSource*,
     for (size_t i = 0; i < length; i++) buffer[i] = *_ptr++;
     return length;
   }
+
+  const char* cursor() const {
+    return _ptr;
+  }
+
+  const char* end() const {
+    return 0;  // null-terminated
+  }
+
+  void skip(size_t n) {
+    _ptr += n;
+  }
 };
 
+template <typename TSource>
+struct ReaderHasDirectAccess<
+    Reader<TSource*, typename enable_if<IsCharOrVoid<TSource>::value>::type> >
+    : true_type {};
+
 template <typename TSource>
 struct BoundedReader<TSource*,
                      typename enable_if<IsCharOrVoid<TSource>::value>::type>
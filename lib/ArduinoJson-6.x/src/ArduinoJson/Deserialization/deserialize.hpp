@@ -4,10 +4,13 @@
 
 #pragma once
 
+#include <ArduinoJson/Binding/ObjectBinding.hpp>
 #include <ArduinoJson/Deserialization/DeserializationError.hpp>
 #include <ArduinoJson/Deserialization/Filter.hpp>
 #include <ArduinoJson/Deserialization/NestingLimit.hpp>
 #include <ArduinoJson/Deserialization/Reader.hpp>
+#include <ArduinoJson/Json/JsonHandler.hpp>
+#include <ArduinoJson/Memory/ScratchBuffer.hpp>
 #include <ArduinoJson/StringStorage/StringStorage.hpp>
 
 namespace ARDUINOJSON_NAMESPACE {
@@ -43,12 +46,13 @@ deserialize(JsonDocument& doc, const TString& input, NestingLimit nestingLimit,
 // deserialize(JsonDocument&, char*, size_t, NestingLimit, Filter);
 // deserialize(JsonDocument&, const char*, size_t, NestingLimit, Filter);
 // deserialize(JsonDocument&, const __FlashStringHelper*, size_t, NL, Filter);
-template <template <typename, typename> class TDeserializer, typename TChar,
+// deserialize(JsonDocument&, Stream&, size_t, NestingLimit, Filter);
+template <template <typename, typename> class TDeserializer, typename TInput,
           typename TFilter>
-DeserializationError deserialize(JsonDocument& doc, TChar* input,
+DeserializationError deserialize(JsonDocument& doc, TInput& input,
                                  size_t inputSize, NestingLimit nestingLimit,
                                  TFilter filter) {
-  BoundedReader<TChar*> reader(input, inputSize);
+  BoundedReader<TInput> reader(input, inputSize);
   VariantData* data = VariantAttorney::getData(doc);
   MemoryPool* pool = VariantAttorney::getPool(doc);
   doc.clear();
@@ -72,4 +76,97 @@ DeserializationError deserialize(JsonDocument& doc, TStream& input,
       .parse(*data, filter, nestingLimit);
 }
 
+// deserialize(ObjectBinding<T>, const std::string&, NestingLimit);
+// deserialize(ObjectBinding<T>, const String&, NestingLimit);
+// deserialize(ObjectBinding<T>, char*, NestingLimit);
+// deserialize(ObjectBinding<T>, const char*, NestingLimit);
+// deserialize(ObjectBinding<T>, const __FlashStringHelper*, NestingLimit);
+template <template <typename, typename> class TDeserializer, typename T,
+          typename TString>
+typename enable_if<!is_array<TString>::value, DeserializationError>::type
+deserialize(ObjectBinding<T> binding, const TString& input,
+            NestingLimit nestingLimit) {
+  Reader<TString> reader(input);
+  ScratchBuffer buffer;
+  MemoryPool pool(reinterpret_cast<char*>(buffer.data), sizeof(buffer.data));
+  return makeDeserializer<TDeserializer>(&pool, reader,
+                                         makeStringStorage(input, &pool))
+      .bind(binding, nestingLimit);
+}
+//
+// deserialize(ObjectBinding<T>, char*, size_t, NestingLimit);
+// deserialize(ObjectBinding<T>, const char*, size_t, NestingLimit);
+// deserialize(ObjectBinding<T>, const __FlashStringHelper*, size_t, NL);
+// deserialize(ObjectBinding<T>, Stream&, size_t, NestingLimit);
+template <template <typename, typename> class TDeserializer, typename T,
+          typename TInput>
+DeserializationError deserialize(ObjectBinding<T> binding, TInput& input,
+                                 size_t inputSize, NestingLimit nestingLimit) {
+  BoundedReader<TInput> reader(input, inputSize);
+  ScratchBuffer buffer;
+  MemoryPool pool(reinterpret_cast<char*>(buffer.data), sizeof(buffer.data));
+  return makeDeserializer<TDeserializer>(&pool, reader,
+                                         makeStringStorage(input, &pool))
+      .bind(binding, nestingLimit);
+}
+//
+// deserialize(ObjectBinding<T>, std::istream&, NestingLimit);
+// deserialize(ObjectBinding<T>, Stream&, NestingLimit);
+template <template <typename, typename> class TDeserializer, typename T,
+          typename TStream>
+DeserializationError deserialize(ObjectBinding<T> binding, TStream& input,
+                                 NestingLimit nestingLimit) {
+  Reader<TStream> reader(input);
+  ScratchBuffer buffer;
+  MemoryPool pool(reinterpret_cast<char*>(buffer.data), sizeof(buffer.data));
+  return makeDeserializer<TDeserializer>(&pool, reader,
+                                         makeStringStorage(input, &pool))
+      .bind(binding, nestingLimit);
+}
+
+// deserialize(JsonHandler&, const std::string&, NestingLimit);
+// deserialize(JsonHandler&, const String&, NestingLimit);
+// deserialize(JsonHandler&, char*, NestingLimit);
+// deserialize(JsonHandler&, const char*, NestingLimit);
+// deserialize(JsonHandler&, const __FlashStringHelper*, NestingLimit);
+template <template <typename, typename> class TDeserializer, typename TString>
+typename enable_if<!is_array<TString>::value, DeserializationError>::type
+deserialize(JsonHandler& handler, const TString& input,
+            NestingLimit nestingLimit) {
+  Reader<TString> reader(input);
+  ScratchBuffer buffer;
+  MemoryPool pool(reinterpret_cast<char*>(buffer.data), sizeof(buffer.data));
+  return makeDeserializer<TDeserializer>(&pool, reader,
+                                         makeStringStorage(input, &pool))
+      .emit(handler, nestingLimit);
+}
+//
+// deserialize(JsonHandler&, char*, size_t, NestingLimit);
+// deserialize(JsonHandler&, const char*, size_t, NestingLimit);
+// deserialize(JsonHandler&, const __FlashStringHelper*, size_t, NestingLimit);
+// deserialize(JsonHandler&, Stream&, size_t, NestingLimit);
+template <template <typename, typename> class TDeserializer, typename TInput>
+DeserializationError deserialize(JsonHandler& handler, TInput& input,
+                                 size_t inputSize, NestingLimit nestingLimit) {
+  BoundedReader<TInput> reader(input, inputSize);
+  ScratchBuffer buffer;
+  MemoryPool pool(reinterpret_cast<char*>(buffer.data), sizeof(buffer.data));
+  return makeDeserializer<TDeserializer>(&pool, reader,
+                                         makeStringStorage(input, &pool))
+      .emit(handler, nestingLimit);
+}
+//
+// deserialize(JsonHandler&, std::istream&, NestingLimit);
+// deserialize(JsonHandler&, Stream&, NestingLimit);
+template <template <typename, typename> class TDeserializer, typename TStream>
+DeserializationError deserialize(JsonHandler& handler, TStream& input,
+                                 NestingLimit nestingLimit) {
+  Reader<TStream> reader(input);
+  ScratchBuffer buffer;
+  MemoryPool pool(reinterpret_cast<char*>(buffer.data), sizeof(buffer.data));
+  return makeDeserializer<TDeserializer>(&pool, reader,
+                                         makeStringStorage(input, &pool))
+      .emit(handler, nestingLimit);
+}
+
 }  // namespace ARDUINOJSON_NAMESPACE
@@ -0,0 +1,116 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Document/BasicJsonDocument.hpp>
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Allocates the blocks of the pool with TAllocator
+// (stored before JsonDocument, like AllocatorOwner)
+template <typename TAllocator>
+class BlockAllocatorOwner : public AllocatorOwner<TAllocator>,
+                            public MemoryBlockAllocator {
+ public:
+  BlockAllocatorOwner(TAllocator a)
+      : AllocatorOwner<TAllocator>(a),
+        MemoryBlockAllocator(callAllocate, callDeallocate) {}
+
+ private:
+  static void* callAllocate(MemoryBlockAllocator* self, size_t size) {
+    return static_cast<BlockAllocatorOwner*>(self)->allocate(size);
+  }
+
+  static void callDeallocate(MemoryBlockAllocator* self, void* block) {
+    static_cast<BlockAllocatorOwner*>(self)->deallocate(block);
+  }
+};
+
+// A JsonDocument whose memory pool grows by chaining blocks, instead of
+// having a fixed capacity.
+// Strings longer than a block get a block of their own.
+template <typename TAllocator>
+class BasicGrowableJsonDocument : BlockAllocatorOwner<TAllocator>,
+                                  public JsonDocument {
+ public:
+  explicit BasicGrowableJsonDocument(size_t blockSize,
+                                     TAllocator alloc = TAllocator())
+      : BlockAllocatorOwner<TAllocator>(alloc),
+        JsonDocument(MemoryPool(*this, blockSize)),
+        _blockSize(blockSize) {}
+
+  // Copy-constructor
+  BasicGrowableJsonDocument(const BasicGrowableJsonDocument& src)
+      : BlockAllocatorOwner<TAllocator>(src),
+        JsonDocument(MemoryPool(*this, src._blockSize)),
+        _blockSize(src._blockSize) {
+    set(src);
+  }
+
+  // Move-constructor
+#if ARDUINOJSON_HAS_RVALUE_REFERENCES
+  BasicGrowableJsonDocument(BasicGrowableJsonDocument&& src)
+      : BlockAllocatorOwner<TAllocator>(src), _blockSize(src._blockSize) {
+    moveAssignFrom(src);
+  }
+#endif
+
+  ~BasicGrowableJsonDocument() {
+    _pool.releaseBlocks();
+  }
+
+  BasicGrowableJsonDocument& operator=(const BasicGrowableJsonDocument& src) {
+    set(src);
+    return *this;
+  }
+
+#if ARDUINOJSON_HAS_RVALUE_REFERENCES
+  BasicGrowableJsonDocument& operator=(BasicGrowableJsonDocument&& src) {
+    moveAssignFrom(src);
+    return *this;
+  }
+#endif
+
+  template <typename T>
+  BasicGrowableJsonDocument& operator=(const T& src) {
+    set(src);
+    return *this;
+  }
+
+  size_t blockSize() const {
+    return _blockSize;
+  }
+
+  size_t blockCount() const {
+    return _pool.blockCount();
+  }
+
+  // Copies the values to new blocks, to reclaim the memory of the removed
+  // values
+  bool garbageCollect() {
+    BasicGrowableJsonDocument tmp(*this);
+    if (tmp.overflowed())
+      return false;
+    moveAssignFrom(tmp);
+    return true;
+  }
+
+  using AllocatorOwner<TAllocator>::allocator;
+
+ private:
+  void moveAssignFrom(BasicGrowableJsonDocument& src) {
+    _pool.releaseBlocks();
+    _data = src._data;
+    _pool = src._pool;
+    _pool.setAllocator(this);
+    _blockSize = src._blockSize;
+    src._data.setNull();
+    src._pool = MemoryPool(0, 0);
+  }
+
+  size_t _blockSize;
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
@@ -0,0 +1,14 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Document/BasicGrowableJsonDocument.hpp>
+#include <ArduinoJson/Document/DynamicJsonDocument.hpp>
+
+namespace ARDUINOJSON_NAMESPACE {
+
+typedef BasicGrowableJsonDocument<DefaultAllocator> GrowableJsonDocument;
+
+}  // namespace ARDUINOJSON_NAMESPACE
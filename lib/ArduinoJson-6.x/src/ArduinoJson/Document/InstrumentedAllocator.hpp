@@ -0,0 +1,127 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Document/DynamicJsonDocument.hpp>
+
+#if ARDUINOJSON_ENABLE_MEMORY_STATS
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Counters of an InstrumentedAllocator.
+// Lifetimes are measured in calls to the allocator, so they don't depend on
+// the speed of the platform.
+struct AllocatorStats {
+  AllocatorStats() : calls(0), currentBytes(0) {
+    reset();
+  }
+
+  // Resets the counters, except calls, which dates the blocks, and
+  // currentBytes, which still counts the blocks allocated before
+  void reset() {
+    allocations = deallocations = failures = 0;
+    totalBytes = largestBytes = longestLifetime = 0;
+    peakBytes = currentBytes;
+  }
+
+  size_t calls;            // calls to allocate(), reallocate() and deallocate()
+  size_t allocations;      // successful calls to allocate() and reallocate()
+  size_t deallocations;    // calls to deallocate()
+  size_t failures;         // calls that returned null
+  size_t totalBytes;       // sum of the sizes requested
+  size_t largestBytes;     // largest size requested
+  size_t currentBytes;     // bytes allocated and not released yet
+  size_t peakBytes;        // highest currentBytes
+  size_t longestLifetime;  // most calls between an allocation and its release
+};
+
+// Wraps an allocator to count its calls in an AllocatorStats, which stays
+// readable after the document is destroyed.
+// Each block is prefixed with a header that remembers its size and when it was
+// allocated, so the counters don't include the header.
+//
+// AllocatorStats stats;
+// BasicJsonDocument<InstrumentedAllocator<> > doc(1024, stats);
+template <typename TAllocator = DefaultAllocator>
+class InstrumentedAllocator {
+ public:
+  InstrumentedAllocator(AllocatorStats& stats,
+                        TAllocator allocator = TAllocator())
+      : _stats(&stats), _allocator(allocator) {}
+
+  void* allocate(size_t size) {
+    _stats->calls++;
+    Header* h = static_cast<Header*>(_allocator.allocate(headerSize + size));
+    if (!h)
+      return failed();
+    h->birth = _stats->calls;
+    return allocated(h, size);
+  }
+
+  void deallocate(void* ptr) {
+    _stats->calls++;
+    Header* h = header(ptr);
+    _stats->deallocations++;
+    _stats->currentBytes -= h->size;
+    size_t lifetime = _stats->calls - h->birth;
+    if (lifetime > _stats->longestLifetime)
+      _stats->longestLifetime = lifetime;
+    _allocator.deallocate(h);
+  }
+
+  void* reallocate(void* ptr, size_t new_size) {
+    if (!ptr)
+      return allocate(new_size);
+    _stats->calls++;
+    size_t oldSize = header(ptr)->size;
+    // the header moves with the block, so the birth is preserved
+    Header* h = static_cast<Header*>(
+        _allocator.reallocate(header(ptr), headerSize + new_size));
+    if (!h)
+      return failed();
+    _stats->currentBytes -= oldSize;
+    return allocated(h, new_size);
+  }
+
+  const AllocatorStats& stats() const {
+    return *_stats;
+  }
+
+ private:
+  struct Header {
+    size_t size;
+    size_t birth;
+  };
+
+  static const size_t headerSize = AddPadding<sizeof(Header)>::value;
+
+  static Header* header(void* ptr) {
+    return reinterpret_cast<Header*>(static_cast<char*>(ptr) - headerSize);
+  }
+
+  void* allocated(Header* h, size_t size) {
+    h->size = size;
+    _stats->allocations++;
+    _stats->totalBytes += size;
+    if (size > _stats->largestBytes)
+      _stats->largestBytes = size;
+    _stats->currentBytes += size;
+    if (_stats->currentBytes > _stats->peakBytes)
+      _stats->peakBytes = _stats->currentBytes;
+    return reinterpret_cast<char*>(h) + headerSize;
+  }
+
+  void* failed() {
+    _stats->failures++;
+    return 0;
+  }
+
+  AllocatorStats* _stats;
+  TAllocator _allocator;
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
+
+#endif
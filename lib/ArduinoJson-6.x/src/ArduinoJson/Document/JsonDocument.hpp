@@ -14,6 +14,14 @@
 
 namespace ARDUINOJSON_NAMESPACE {
 
+// State of a JsonDocument, as returned by JsonDocument::mark()
+class JsonDocumentMark {
+  friend class JsonDocument;
+
+  MemoryPoolMark _pool;
+  VariantData _data;
+};
+
 class JsonDocument : public VariantOperators<const JsonDocument&> {
   friend class VariantAttorney;
 
@@ -51,6 +59,47 @@ class JsonDocument : public VariantOperators<const JsonDocument&> {
     return _pool.size();
   }
 
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL || ARDUINOJSON_ENABLE_MEMORY_STATS
+  // Highest memoryUsage() since the creation of the document
+  size_t peakMemoryUsage() const {
+    return _pool.peakSize();
+  }
+#endif
+
+#if ARDUINOJSON_ENABLE_MEMORY_STATS
+  // Counters of the allocations in the memory pool, see MemoryPoolStats
+  MemoryPoolStats memoryStats() const {
+    return _pool.stats();
+  }
+
+  // Resets the counters, and peakMemoryUsage() to memoryUsage()
+  void resetMemoryStats() {
+    _pool.resetStats();
+  }
+#endif
+
+  // Remembers the current state, so that rewind() can discard what comes next.
+  // The values that exist at the mark must not change until rewind(), except
+  // the root array or object, which can receive new elements or members.
+  JsonDocumentMark mark() const {
+    JsonDocumentMark m;
+    m._pool = _pool.mark();
+    m._data.init();
+    m._data = _data;
+    return m;
+  }
+
+  // Discards the values and the strings added since the mark.
+  // The mark is no longer valid after a clear(), or a rewind() to an older
+  // mark.
+  void rewind(const JsonDocumentMark& m) {
+    _pool.rewind(m._pool);
+    _data = m._data;
+    CollectionData* root = _data.asCollection();
+    if (root)
+      root->truncate();
+  }
+
   bool overflowed() const {
     return _pool.overflowed();
   }
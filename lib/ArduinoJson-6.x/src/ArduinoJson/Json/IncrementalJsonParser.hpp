@@ -0,0 +1,541 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/DeserializationError.hpp>
+#include <ArduinoJson/Deserialization/NestingLimit.hpp>
+#include <ArduinoJson/Json/EscapeSequence.hpp>
+#include <ArduinoJson/Json/JsonDocumentBuilder.hpp>
+#include <ArduinoJson/Json/JsonHandler.hpp>
+#include <ArduinoJson/Json/Utf16.hpp>
+#include <ArduinoJson/Json/Utf8.hpp>
+#include <ArduinoJson/Numbers/parseNumber.hpp>
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Characters of the string being read, kept from one chunk to the next
+template <size_t capacity>
+class StaticStringBuffer {
+ public:
+  StaticStringBuffer() : _size(0), _overflowed(false) {}
+
+  void clear() {
+    _size = 0;
+    _overflowed = false;
+  }
+
+  void append(char c) {
+    if (_size + 1 < capacity)
+      _data[_size++] = c;
+    else
+      _overflowed = true;
+  }
+
+  bool overflowed() const {
+    return _overflowed;
+  }
+
+  String str() {
+    _data[_size] = 0;
+    return String(_data, _size, String::Copied);
+  }
+
+ private:
+  char _data[capacity];
+  size_t _size;
+  bool _overflowed;
+};
+
+// Parses a JSON document that arrives in chunks, and reports it to a
+// JsonHandler as it goes.
+// feed() consumes the chunk and returns IncompleteInput until the document is
+// complete; the parser keeps its state in between, so the caller never waits
+// for the input.
+// The keys and the string values are buffered in the parser, in
+// stringCapacity bytes: strings longer than stringCapacity - 1 (63 with the
+// default ARDUINOJSON_SCRATCH_BUFFER_SIZE) produce NoMemory.
+template <size_t stringCapacity = ARDUINOJSON_SCRATCH_BUFFER_SIZE>
+class IncrementalJsonParser {
+ public:
+  // The parser accepts strings of up to stringCapacity - 1 characters; raise
+  // the template argument for longer ones.
+  explicit IncrementalJsonParser(JsonHandler& handler,
+                                 NestingLimit nestingLimit = NestingLimit())
+      : _handler(&handler), _maxDepth(nestingLimit.value()) {
+    reset();
+  }
+
+  // Forgets the current document to parse a new one
+  void reset() {
+    _state = ExpectingValue;
+    _error = DeserializationError::Ok;
+    _depth = 0;
+    _done = false;
+    _foundSomething = false;
+  }
+
+  // Returns NoMemory as soon as a key or a string value is longer than
+  // stringCapacity - 1, even if the document has room for it.
+  template <typename TChar>
+  DeserializationError feed(TChar* input, size_t inputSize) {
+    const char* p = reinterpret_cast<const char*>(input);
+    for (size_t i = 0; i < inputSize && !_done && !_error; i++)
+      _error = parseChar(p[i]);
+    return status();
+  }
+
+  // Signals the end of the input; only a number at the root needs it
+  DeserializationError finish() {
+    if (!_error && !_done) {
+      if (_state == InNumber && _depth == 0)
+        _error = endNumber();
+      else
+        _error = _foundSomething ? DeserializationError::IncompleteInput
+                                 : DeserializationError::EmptyInput;
+    }
+    return status();
+  }
+
+ private:
+  enum State {
+    ExpectingValue,
+    ExpectingValueOrArrayEnd,
+    ExpectingKey,
+    ExpectingKeyOrObjectEnd,
+    ExpectingColon,
+    AfterValue,
+    InString,
+    InEscapeSequence,
+    InUnicodeEscape,
+    InNonQuotedKey,
+    InNumber,
+#if ARDUINOJSON_ENABLE_COMMENTS
+    InCommentStart,
+    InBlockComment,
+    InBlockCommentEnd,
+    InLineComment,
+#endif
+    InKeyword
+  };
+
+  DeserializationError status() const {
+    if (_error)
+      return _error;
+    return _done ? DeserializationError::Ok
+                 : DeserializationError::IncompleteInput;
+  }
+
+  DeserializationError::Code parseChar(char c) {
+    switch (_state) {
+      case InString:
+        return parseStringChar(c);
+
+      case InEscapeSequence:
+        return parseEscapeChar(c);
+
+      case InUnicodeEscape:
+        return parseUnicodeChar(c);
+
+      case InNonQuotedKey:
+        if (canBeInNonQuotedString(c)) {
+          _string.append(c);
+          return DeserializationError::Ok;
+        }
+        _state = ExpectingColon;
+        return parseChar(c);
+
+      case InNumber:
+        return parseNumberChar(c);
+
+      case InKeyword:
+        if (c != _keyword[_keywordSize])
+          return DeserializationError::InvalidInput;
+        if (_keyword[++_keywordSize] == 0)
+          return endKeyword();
+        return DeserializationError::Ok;
+
+#if ARDUINOJSON_ENABLE_COMMENTS
+      case InCommentStart:
+        if (c == '*')
+          _state = InBlockComment;
+        else if (c == '/')
+          _state = InLineComment;
+        else
+          return DeserializationError::InvalidInput;
+        return DeserializationError::Ok;
+
+      case InBlockComment:
+        if (c == '*')
+          _state = InBlockCommentEnd;
+        return DeserializationError::Ok;
+
+      case InBlockCommentEnd:
+        if (c == '/')
+          _state = _stateAfterComment;
+        else if (c != '*')
+          _state = InBlockComment;
+        return DeserializationError::Ok;
+
+      case InLineComment:
+        if (c == '\n')
+          _state = _stateAfterComment;
+        return DeserializationError::Ok;
+#endif
+
+      default:
+        break;
+    }
+
+    // The remaining states skip spaces and comments
+    switch (c) {
+      case ' ':
+      case '\t':
+      case '\r':
+      case '\n':
+        return DeserializationError::Ok;
+
+#if ARDUINOJSON_ENABLE_COMMENTS
+      case '/':
+        _stateAfterComment = _state;
+        _state = InCommentStart;
+        return DeserializationError::Ok;
+#endif
+
+      default:
+        _foundSomething = true;
+        break;
+    }
+
+    switch (_state) {
+      case ExpectingValueOrArrayEnd:
+        if (c == ']')
+          return endCollection();
+        return startValue(c);
+
+      case ExpectingKeyOrObjectEnd:
+        if (c == '}')
+          return endCollection();
+        return startKey(c);
+
+      case ExpectingKey:
+        return startKey(c);
+
+      case ExpectingColon:
+        if (c != ':')
+          return DeserializationError::InvalidInput;
+        if (_string.overflowed())
+          return DeserializationError::NoMemory;
+        _handler->key(_string.str());
+        _state = ExpectingValue;
+        return DeserializationError::Ok;
+
+      case AfterValue:
+        if (c == ',') {
+          _state = inObject() ? ExpectingKey : ExpectingValue;
+          return DeserializationError::Ok;
+        }
+        if (c == (inObject() ? '}' : ']'))
+          return endCollection();
+        return DeserializationError::InvalidInput;
+
+      default:
+        return startValue(c);
+    }
+  }
+
+  DeserializationError::Code startValue(char c) {
+    switch (c) {
+      case '[':
+      case '{':
+        return startCollection(c == '{');
+
+      case '\"':
+      case '\'':
+        return startString(c, false);
+
+      case 't':
+        return startKeyword("true");
+
+      case 'f':
+        return startKeyword("false");
+
+      case 'n':
+        return startKeyword("null");
+
+      default:
+        if (!canBeInNumber(c))
+          return DeserializationError::InvalidInput;
+        _number[0] = c;
+        _numberSize = 1;
+        _state = InNumber;
+        return DeserializationError::Ok;
+    }
+  }
+
+  DeserializationError::Code startKey(char c) {
+    if (isQuote(c))
+      return startString(c, true);
+    if (!canBeInNonQuotedString(c))
+      return DeserializationError::InvalidInput;
+    _string.clear();
+    _string.append(c);
+    _state = InNonQuotedKey;
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code startString(char stopChar, bool isKey) {
+    _string.clear();
+    _codepoint = Utf16::Codepoint();
+    _stopChar = stopChar;
+    _stringIsKey = isKey;
+    _state = InString;
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code parseStringChar(char c) {
+    if (c == _stopChar) {
+      if (_string.overflowed())
+        return DeserializationError::NoMemory;
+      if (_stringIsKey) {
+        _state = ExpectingColon;
+        return DeserializationError::Ok;
+      }
+      VariantData value;
+      value.init();
+      value.setString(_string.str());
+      return endValue(value);
+    }
+
+    if (c == '\0')
+      return DeserializationError::InvalidInput;
+
+    if (c == '\\')
+      _state = InEscapeSequence;
+    else
+      _string.append(c);
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code parseEscapeChar(char c) {
+    if (c == 'u') {
+#if ARDUINOJSON_DECODE_UNICODE
+      _codeunit = 0;
+      _hexDigits = 0;
+      _state = InUnicodeEscape;
+#else
+      _string.append('\\');
+      _string.append('u');
+      _state = InString;
+#endif
+      return DeserializationError::Ok;
+    }
+
+    // replace char
+    c = EscapeSequence::unescapeChar(c);
+    if (c == '\0')
+      return DeserializationError::InvalidInput;
+    _string.append(c);
+    _state = InString;
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code parseUnicodeChar(char c) {
+    uint8_t value = decodeHex(c);
+    if (value > 0x0F)
+      return DeserializationError::InvalidInput;
+    _codeunit = uint16_t((_codeunit << 4) | value);
+    if (++_hexDigits < 4)
+      return DeserializationError::Ok;
+    if (_codepoint.append(_codeunit))
+      Utf8::encodeCodepoint(_codepoint.value(), _string);
+    _state = InString;
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code startKeyword(const char* keyword) {
+    _keyword = keyword;
+    _keywordSize = 1;
+    _state = InKeyword;
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code endKeyword() {
+    VariantData value;
+    value.init();
+    if (_keyword[0] != 'n')
+      value.setBoolean(_keyword[0] == 't');
+    return endValue(value);
+  }
+
+  DeserializationError::Code parseNumberChar(char c) {
+    if (canBeInNumber(c) && _numberSize < sizeof(_number) - 1) {
+      _number[_numberSize++] = c;
+      return DeserializationError::Ok;
+    }
+
+    // We don't detect trailing characters earlier, so we need to check now
+    if (_depth == 0)
+      return DeserializationError::InvalidInput;
+
+    DeserializationError::Code err = endNumber();
+    if (err)
+      return err;
+    return parseChar(c);
+  }
+
+  DeserializationError::Code endNumber() {
+    _number[_numberSize] = 0;
+    VariantData value;
+    value.init();
+    if (!parseNumber(_number, value))
+      return DeserializationError::InvalidInput;
+    return endValue(value);
+  }
+
+  DeserializationError::Code endValue(const VariantData& value) {
+    _handler->value(VariantConstRef(&value));
+    return endValue();
+  }
+
+  DeserializationError::Code endValue() {
+    if (_depth == 0)
+      _done = true;
+    else
+      _state = AfterValue;
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code startCollection(bool isObject) {
+    if (_depth >= _maxDepth)
+      return DeserializationError::TooDeep;
+
+    uint8_t& bits = _objects[_depth / 8];
+    uint8_t mask = uint8_t(1 << (_depth % 8));
+    if (isObject) {
+      bits = uint8_t(bits | mask);
+      _handler->startObject();
+      _state = ExpectingKeyOrObjectEnd;
+    } else {
+      bits = uint8_t(bits & ~mask);
+      _handler->startArray();
+      _state = ExpectingValueOrArrayEnd;
+    }
+    _depth++;
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code endCollection() {
+    if (inObject())
+      _handler->endObject();
+    else
+      _handler->endArray();
+    _depth--;
+    return endValue();
+  }
+
+  bool inObject() const {
+    ARDUINOJSON_ASSERT(_depth > 0);
+    uint8_t i = uint8_t(_depth - 1);
+    return (_objects[i / 8] >> (i % 8)) & 1;
+  }
+
+  static inline bool isBetween(char c, char min, char max) {
+    return min <= c && c <= max;
+  }
+
+  static inline bool canBeInNumber(char c) {
+    return isBetween(c, '0', '9') || c == '+' || c == '-' || c == '.' ||
+#if ARDUINOJSON_ENABLE_NAN || ARDUINOJSON_ENABLE_INFINITY
+           isBetween(c, 'A', 'Z') || isBetween(c, 'a', 'z');
+#else
+           c == 'e' || c == 'E';
+#endif
+  }
+
+  static inline bool canBeInNonQuotedString(char c) {
+    return isBetween(c, '0', '9') || isBetween(c, '_', 'z') ||
+           isBetween(c, 'A', 'Z');
+  }
+
+  static inline bool isQuote(char c) {
+    return c == '\'' || c == '\"';
+  }
+
+  static inline uint8_t decodeHex(char c) {
+    if (c < 'A')
+      return uint8_t(c - '0');
+    c = char(c & ~0x20);  // uppercase
+    return uint8_t(c - 'A' + 10);
+  }
+
+  JsonHandler* _handler;
+  uint8_t _maxDepth;
+  uint8_t _depth;
+  uint8_t _objects[32];  // one bit per level: 1 = object, 0 = array
+  State _state;
+#if ARDUINOJSON_ENABLE_COMMENTS
+  State _stateAfterComment;
+#endif
+  DeserializationError::Code _error;
+  bool _done;
+  bool _foundSomething;
+
+  // String
+  StaticStringBuffer<stringCapacity> _string;
+  Utf16::Codepoint _codepoint;
+  uint16_t _codeunit;
+  uint8_t _hexDigits;
+  char _stopChar;
+  bool _stringIsKey;
+
+  // Number
+  char _number[64];
+  uint8_t _numberSize;
+
+  // Keyword
+  const char* _keyword;
+  uint8_t _keywordSize;
+};
+
+// Same as IncrementalJsonParser, but builds the document.
+// feed() returns NoMemory as soon as the document is full, or as soon as a
+// string is longer than stringCapacity - 1.
+template <size_t stringCapacity = ARDUINOJSON_SCRATCH_BUFFER_SIZE>
+class IncrementalJsonDeserializer {
+ public:
+  // Like IncrementalJsonParser, accepts strings of up to stringCapacity - 1
+  // characters, whatever the capacity of the document.
+  explicit IncrementalJsonDeserializer(
+      JsonDocument& doc, NestingLimit nestingLimit = NestingLimit())
+      : _builder(doc), _parser(_builder, nestingLimit) {}
+
+  // Clears the document to parse a new one
+  void reset() {
+    _builder.reset();
+    _parser.reset();
+  }
+
+  template <typename TChar>
+  DeserializationError feed(TChar* input, size_t inputSize) {
+    return check(_parser.feed(input, inputSize));
+  }
+
+  DeserializationError finish() {
+    return check(_parser.finish());
+  }
+
+ private:
+  DeserializationError check(DeserializationError err) const {
+    if (_builder.overflowed() &&
+        (!err || err == DeserializationError::IncompleteInput))
+      return DeserializationError::NoMemory;
+    return err;
+  }
+
+  JsonDocumentBuilder _builder;
+  IncrementalJsonParser<stringCapacity> _parser;
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
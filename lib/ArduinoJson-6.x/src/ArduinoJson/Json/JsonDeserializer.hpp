@@ -7,6 +7,7 @@
 #include <ArduinoJson/Deserialization/deserialize.hpp>
 #include <ArduinoJson/Json/EscapeSequence.hpp>
 #include <ArduinoJson/Json/Latch.hpp>
+#include <ArduinoJson/Json/StringScanner.hpp>
 #include <ArduinoJson/Json/Utf16.hpp>
 #include <ArduinoJson/Json/Utf8.hpp>
 #include <ArduinoJson/Memory/MemoryPool.hpp>
@@ -32,7 +33,11 @@ class JsonDeserializer {
                              NestingLimit nestingLimit) {
     DeserializationError::Code err;
 
+#if ARDUINOJSON_ENABLE_ITERATIVE_PARSING
+    err = parseNested(variant, filter, nestingLimit);
+#else
     err = parseVariant(variant, filter, nestingLimit);
+#endif
 
     if (!err && _latch.last() != 0 && !variant.isEnclosed()) {
       // We don't detect trailing characters earlier, so we need to check now
@@ -42,6 +47,86 @@ class JsonDeserializer {
     return err;
   }
 
+  // Parses the next value of a sequence: JSON Lines (NDJSON), or JSON text
+  // sequences (RFC 7464), where each value starts with a record separator.
+  // The reader and the pending character are kept from one value to the next.
+  // Returns EmptyInput when there are no more values.
+  template <typename TFilter>
+  DeserializationError parseNext(VariantData& variant, TFilter filter,
+                                 NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    _foundSomething = false;
+    while (isSequenceSeparator(current())) move();
+    if (current() == '\0')
+      return DeserializationError::EmptyInput;
+
+#if ARDUINOJSON_ENABLE_ITERATIVE_PARSING
+    err = parseNested(variant, filter, nestingLimit);
+#else
+    err = parseVariant(variant, filter, nestingLimit);
+#endif
+
+    // the value must end the line
+    if (!err && current() != '\0' && !isSequenceSeparator(current()))
+      return DeserializationError::InvalidInput;
+
+    return err;
+  }
+
+  // Skips the rest of the current line, to resume after an invalid value
+  void skipLine() {
+    for (;;) {
+      char c = current();
+      if (c == '\0')
+        return;
+      move();
+      if (c == '\n')
+        return;
+    }
+  }
+
+  template <typename T>
+  DeserializationError bind(ObjectBinding<T> binding,
+                            NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    if (current() != '{')
+      return DeserializationError::InvalidInput;
+
+    return bindObject(binding, nestingLimit);
+  }
+
+  template <typename THandler>
+  DeserializationError emit(THandler& handler, NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    if (current() == '[' || current() == '{')
+      return emitVariant(handler, nestingLimit);
+
+    VariantData value;
+    value.init();
+    err = parseVariant(value, ValueOnlyFilter(), nestingLimit);
+    if (err)
+      return err;
+
+    if (_latch.last() != 0 && !value.isEnclosed()) {
+      // We don't detect trailing characters earlier, so we need to check now
+      return DeserializationError::InvalidInput;
+    }
+
+    handler.value(VariantConstRef(&value));
+    return DeserializationError::Ok;
+  }
+
  private:
   char current() {
     return _latch.current();
@@ -111,6 +196,9 @@ class JsonDeserializer {
   }
 
   DeserializationError::Code skipVariant(NestingLimit nestingLimit) {
+#if ARDUINOJSON_ENABLE_ITERATIVE_PARSING
+    return skipNested(nestingLimit);
+#else
     DeserializationError::Code err;
 
     err = skipSpacesAndComments();
@@ -140,6 +228,7 @@ class JsonDeserializer {
       default:
         return skipNumericValue();
     }
+#endif
   }
 
   template <typename TFilter>
@@ -197,6 +286,9 @@ class JsonDeserializer {
   }
 
   DeserializationError::Code skipArray(NestingLimit nestingLimit) {
+#if ARDUINOJSON_ENABLE_ITERATIVE_PARSING
+    return skipNested(nestingLimit);
+#else
     DeserializationError::Code err;
 
     if (nestingLimit.reached())
@@ -224,6 +316,7 @@ class JsonDeserializer {
       if (!eat(','))
         return DeserializationError::InvalidInput;
     }
+#endif
   }
 
   template <typename TFilter>
@@ -249,41 +342,13 @@ class JsonDeserializer {
 
     // Read each key value pair
     for (;;) {
-      // Parse key
-      err = parseKey();
+      TFilter memberFilter = filter;
+      VariantData* variant;
+      err = parseMemberKey(object, filter, memberFilter, variant);
       if (err)
         return err;
 
-      // Skip spaces
-      err = skipSpacesAndComments();
-      if (err)
-        return err;
-
-      // Colon
-      if (!eat(':'))
-        return DeserializationError::InvalidInput;
-
-      String key = _stringStorage.str();
-
-      TFilter memberFilter = filter[key.c_str()];
-
-      if (memberFilter.allow()) {
-        VariantData* variant = object.getMember(adaptString(key.c_str()));
-        if (!variant) {
-          // Save key in memory pool.
-          // This MUST be done before adding the slot.
-          key = _stringStorage.save();
-
-          // Allocate slot in object
-          VariantSlot* slot = object.addSlot(_pool);
-          if (!slot)
-            return DeserializationError::NoMemory;
-
-          slot->setKey(key);
-
-          variant = slot->data();
-        }
-
+      if (variant) {
         // Parse value
         err = parseVariant(*variant, memberFilter, nestingLimit.decrement());
         if (err)
@@ -312,7 +377,60 @@ class JsonDeserializer {
     }
   }
 
+  // Parses a key and the colon that follows, then finds the member in the
+  // object, or adds it.
+  // Sets variant to null if the filter excludes the member.
+  template <typename TFilter>
+  DeserializationError::Code parseMemberKey(CollectionData& object,
+                                            const TFilter& filter,
+                                            TFilter& memberFilter,
+                                            VariantData*& variant) {
+    DeserializationError::Code err;
+    variant = 0;
+
+    // Parse key
+    err = parseKey();
+    if (err)
+      return err;
+
+    // Skip spaces
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    // Colon
+    if (!eat(':'))
+      return DeserializationError::InvalidInput;
+
+    String key = _stringStorage.str();
+
+    memberFilter = filter[key.c_str()];
+    if (!memberFilter.allow())
+      return DeserializationError::Ok;
+
+    variant = object.getMember(adaptString(key.c_str()));
+    if (variant)
+      return DeserializationError::Ok;
+
+    // Save key in memory pool.
+    // This MUST be done before adding the slot.
+    key = _stringStorage.save();
+
+    // Allocate slot in object
+    VariantSlot* slot = object.addSlot(_pool);
+    if (!slot)
+      return DeserializationError::NoMemory;
+
+    slot->setKey(key);
+
+    variant = slot->data();
+    return DeserializationError::Ok;
+  }
+
   DeserializationError::Code skipObject(NestingLimit nestingLimit) {
+#if ARDUINOJSON_ENABLE_ITERATIVE_PARSING
+    return skipNested(nestingLimit);
+#else
     DeserializationError::Code err;
 
     if (nestingLimit.reached())
@@ -367,6 +485,421 @@ class JsonDeserializer {
       if (err)
         return err;
     }
+#endif
+  }
+
+#if ARDUINOJSON_ENABLE_ITERATIVE_PARSING
+  template <typename TFilter>
+  struct ParsingFrame {
+    VariantData* collection;
+    TFilter filter;  // for an array, the filter of the elements
+  };
+
+  // Same as parseVariant(), but the arrays and objects are parsed by a loop
+  // with an explicit stack, instead of recursive calls
+  template <typename TFilter>
+  DeserializationError::Code parseNested(VariantData& root, TFilter filter,
+                                         NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+    ParsingFrame<TFilter> stack[ARDUINOJSON_ITERATIVE_PARSING_MAX_DEPTH];
+    uint8_t depth = 0;
+    VariantData* variant = &root;  // null if the value must be skipped
+
+    for (;;) {
+      NestingLimit limit(uint8_t(nestingLimit.value() - depth));
+      bool opened = false;
+
+      // 1 - Parse the value, or open an array or an object
+      if (variant) {
+        err = skipSpacesAndComments();
+        if (err)
+          return err;
+
+        bool isArray = current() == '[' && filter.allowArray();
+        bool isObject = current() == '{' && filter.allowObject();
+        if (isArray || isObject) {
+          if (isArray)
+            variant->toArray();
+          else
+            variant->toObject();
+          if (limit.reached() ||
+              depth >= ARDUINOJSON_ITERATIVE_PARSING_MAX_DEPTH)
+            return DeserializationError::TooDeep;
+          move();
+          stack[depth].collection = variant;
+          stack[depth].filter = isArray ? filter[0UL] : filter;
+          depth++;
+          opened = true;
+        } else if (current() == '[' || current() == '{') {
+          err = skipVariant(limit);
+        } else {
+          err = parseVariant(*variant, filter, limit);
+        }
+      } else {
+        err = skipVariant(limit);
+      }
+      if (err)
+        return err;
+
+      // 2 - Close the arrays and objects that end here
+      for (;;) {
+        if (depth == 0)
+          return DeserializationError::Ok;
+
+        err = skipSpacesAndComments();
+        if (err)
+          return err;
+
+        if (!eat(stack[depth - 1].collection->isObject() ? '}' : ']'))
+          break;
+        depth--;
+        opened = false;
+      }
+      if (!opened && !eat(','))
+        return DeserializationError::InvalidInput;
+
+      // 3 - Find where the next value goes
+      ParsingFrame<TFilter>& frame = stack[depth - 1];
+      variant = 0;
+
+      if (frame.collection->isObject()) {
+        err = skipSpacesAndComments();
+        if (err)
+          return err;
+
+        err = parseMemberKey(*frame.collection->asObject(), frame.filter,
+                             filter, variant);
+        if (err)
+          return err;
+      } else {
+        filter = frame.filter;
+        if (filter.allow()) {
+          variant = frame.collection->asArray()->addElement(_pool);
+          if (!variant)
+            return DeserializationError::NoMemory;
+        }
+      }
+    }
+  }
+
+  // Same as skipVariant(), but the arrays and objects are skipped by a loop
+  // that keeps one bit per level
+  DeserializationError::Code skipNested(NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+    uint8_t objects[32];  // one bit per level: 1 = object, 0 = array
+    uint8_t depth = 0;
+
+    for (;;) {
+      bool opened = false;
+
+      // 1 - Skip the value, or open an array or an object
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      switch (current()) {
+        case '[':
+        case '{': {
+          NestingLimit limit(uint8_t(nestingLimit.value() - depth));
+          if (limit.reached())
+            return DeserializationError::TooDeep;
+          uint8_t& bits = objects[depth / 8];
+          uint8_t mask = uint8_t(1 << (depth % 8));
+          bits = uint8_t(current() == '{' ? bits | mask : bits & ~mask);
+          move();
+          depth++;
+          opened = true;
+          break;
+        }
+
+        case '\"':
+        case '\'':
+          err = skipQuotedString();
+          break;
+
+        case 't':
+          err = skipKeyword("true");
+          break;
+
+        case 'f':
+          err = skipKeyword("false");
+          break;
+
+        case 'n':
+          err = skipKeyword("null");
+          break;
+
+        default:
+          err = skipNumericValue();
+          break;
+      }
+      if (err)
+        return err;
+
+      // 2 - Close the arrays and objects that end here, and move to the next
+      // value
+      for (;;) {
+        if (depth == 0)
+          return DeserializationError::Ok;
+
+        uint8_t level = uint8_t(depth - 1);
+        bool inObject = (objects[level / 8] >> (level % 8)) & 1;
+
+        // unlike objects, arrays don't look for the end right after '['
+        if (opened && !inObject)
+          break;
+
+        err = skipSpacesAndComments();
+        if (err)
+          return err;
+
+        if (eat(inObject ? '}' : ']')) {
+          depth--;
+          opened = false;
+          continue;
+        }
+
+        if (!opened && !eat(','))
+          return DeserializationError::InvalidInput;
+
+        if (inObject) {
+          err = skipSpacesAndComments();
+          if (err)
+            return err;
+
+          err = skipKey();
+          if (err)
+            return err;
+
+          err = skipSpacesAndComments();
+          if (err)
+            return err;
+
+          if (!eat(':'))
+            return DeserializationError::InvalidInput;
+        }
+        break;
+      }
+    }
+  }
+#endif
+
+  template <typename T>
+  DeserializationError::Code bindObject(ObjectBinding<T>& binding,
+                                        NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    // Skip opening brace
+    ARDUINOJSON_ASSERT(current() == '{');
+    move();
+
+    // Skip spaces
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    // Empty object?
+    if (eat('}'))
+      return DeserializationError::Ok;
+
+    // Read each key value pair
+    for (;;) {
+      // Nothing is kept in the pool from one member to the next
+      _pool->clear();
+
+      // Parse key; a key too long for the pool can't match any field
+      const JsonField<T>* field = 0;
+      err = parseKey();
+      if (err == DeserializationError::Ok)
+        field = binding.find(_stringStorage.str());
+      else if (err != DeserializationError::NoMemory)
+        return err;
+
+      // Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // Colon
+      if (!eat(':'))
+        return DeserializationError::InvalidInput;
+
+      if (field) {
+        VariantData value;
+        value.init();
+        err = parseVariant(value, ValueOnlyFilter(), nestingLimit.decrement());
+        if (err)
+          return err;
+        binding.assign(field, value);
+      } else {
+        err = skipVariant(nestingLimit.decrement());
+        if (err)
+          return err;
+      }
+
+      // Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // More keys/values?
+      if (eat('}'))
+        return DeserializationError::Ok;
+      if (!eat(','))
+        return DeserializationError::InvalidInput;
+
+      // Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+    }
+  }
+
+  template <typename THandler>
+  DeserializationError::Code emitVariant(THandler& handler,
+                                         NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    switch (current()) {
+      case '[':
+        return emitArray(handler, nestingLimit);
+
+      case '{':
+        return emitObject(handler, nestingLimit);
+
+      default: {
+        // Nothing is kept in the pool from one value to the next
+        _pool->clear();
+
+        VariantData value;
+        value.init();
+        err = parseVariant(value, ValueOnlyFilter(), nestingLimit);
+        if (err)
+          return err;
+        handler.value(VariantConstRef(&value));
+        return DeserializationError::Ok;
+      }
+    }
+  }
+
+  template <typename THandler>
+  DeserializationError::Code emitArray(THandler& handler,
+                                       NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    // Skip opening braket
+    ARDUINOJSON_ASSERT(current() == '[');
+    move();
+
+    handler.startArray();
+
+    // Skip spaces
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    // Read each value
+    if (!eat(']')) {
+      for (;;) {
+        // 1 - Emit value
+        err = emitVariant(handler, nestingLimit.decrement());
+        if (err)
+          return err;
+
+        // 2 - Skip spaces
+        err = skipSpacesAndComments();
+        if (err)
+          return err;
+
+        // 3 - More values?
+        if (eat(']'))
+          break;
+        if (!eat(','))
+          return DeserializationError::InvalidInput;
+      }
+    }
+
+    handler.endArray();
+    return DeserializationError::Ok;
+  }
+
+  template <typename THandler>
+  DeserializationError::Code emitObject(THandler& handler,
+                                        NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    // Skip opening brace
+    ARDUINOJSON_ASSERT(current() == '{');
+    move();
+
+    handler.startObject();
+
+    // Skip spaces
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    // Read each key value pair
+    if (!eat('}')) {
+      for (;;) {
+        // Nothing is kept in the pool from one key to the next
+        _pool->clear();
+
+        // Parse key
+        err = parseKey();
+        if (err)
+          return err;
+
+        // Skip spaces
+        err = skipSpacesAndComments();
+        if (err)
+          return err;
+
+        // Colon
+        if (!eat(':'))
+          return DeserializationError::InvalidInput;
+
+        // Saving the key keeps it intact when strings are decoded in place
+        handler.key(_stringStorage.save());
+
+        // Emit value
+        err = emitVariant(handler, nestingLimit.decrement());
+        if (err)
+          return err;
+
+        // Skip spaces
+        err = skipSpacesAndComments();
+        if (err)
+          return err;
+
+        // More keys/values?
+        if (eat('}'))
+          break;
+        if (!eat(','))
+          return DeserializationError::InvalidInput;
+
+        // Skip spaces
+        err = skipSpacesAndComments();
+        if (err)
+          return err;
+      }
+    }
+
+    handler.endObject();
+    return DeserializationError::Ok;
   }
 
   DeserializationError::Code parseKey() {
@@ -401,6 +934,8 @@ class JsonDeserializer {
 
     move();
     for (;;) {
+      copyPlainChars(stopChar, ReaderHasDirectAccess<TReader>());
+
       char c = current();
       move();
       if (c == stopChar)
@@ -426,6 +961,8 @@ class JsonDeserializer {
             Utf8::encodeCodepoint(codepoint.value(), _stringStorage);
 #else
           _stringStorage.append('\\');
+          _stringStorage.append('u');
+          move();
 #endif
           continue;
         }
@@ -479,6 +1016,8 @@ class JsonDeserializer {
 
     move();
     for (;;) {
+      skipPlainChars(stopChar, ReaderHasDirectAccess<TReader>());
+
       char c = current();
       move();
       if (c == stopChar)
@@ -486,14 +1025,40 @@ class JsonDeserializer {
       if (c == '\0')
         return DeserializationError::IncompleteInput;
       if (c == '\\') {
-        if (current() != '\0')
-          move();
+        if (current() == '\0')
+          return DeserializationError::IncompleteInput;
+        move();
       }
     }
 
     return DeserializationError::Ok;
   }
 
+  // Fast path for readers that give direct access to the input: plain
+  // characters are scanned a word at a time and copied in one call
+  void copyPlainChars(char stopChar, true_type) {
+    TReader& reader = _latch.reader();
+    size_t n = countPlainChars(reader, stopChar);
+    _stringStorage.append(reader.cursor(), n);
+    reader.skip(n);
+  }
+
+  void copyPlainChars(char, false_type) {}
+
+  void skipPlainChars(char stopChar, true_type) {
+    TReader& reader = _latch.reader();
+    reader.skip(countPlainChars(reader, stopChar));
+  }
+
+  void skipPlainChars(char, false_type) {}
+
+  static size_t countPlainChars(const TReader& reader, char stopChar) {
+    if (reader.end())
+      return scanPlainChars(reader.cursor(), reader.end(), stopChar);
+    else
+      return scanPlainChars(reader.cursor(), stopChar);
+  }
+
   DeserializationError::Code skipNonQuotedString() {
     char c = current();
     while (canBeInNonQuotedString(c)) {
@@ -639,6 +1204,10 @@ class JsonDeserializer {
     }
   }
 
+  static bool isSequenceSeparator(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\x1e';
+  }
+
   DeserializationError::Code skipKeyword(const char* s) {
     while (*s) {
       char c = current();
@@ -764,4 +1333,139 @@ DeserializationError deserializeJson(JsonDocument& doc, TChar* input,
                                        filter);
 }
 
+//
+// deserializeJson(JsonDocument&, Stream&, size_t, ...)
+//
+// ... = NestingLimit
+template <typename TStream>
+DeserializationError deserializeJson(
+    JsonDocument& doc, TStream& input, size_t inputSize,
+    NestingLimit nestingLimit = NestingLimit()) {
+  return deserialize<JsonDeserializer>(doc, input, inputSize, nestingLimit,
+                                       AllowAllFilter());
+}
+// ... = Filter, NestingLimit
+template <typename TStream>
+DeserializationError deserializeJson(
+    JsonDocument& doc, TStream& input, size_t inputSize, Filter filter,
+    NestingLimit nestingLimit = NestingLimit()) {
+  return deserialize<JsonDeserializer>(doc, input, inputSize, nestingLimit,
+                                       filter);
+}
+// ... = NestingLimit, Filter
+template <typename TStream>
+DeserializationError deserializeJson(JsonDocument& doc, TStream& input,
+                                     size_t inputSize,
+                                     NestingLimit nestingLimit, Filter filter) {
+  return deserialize<JsonDeserializer>(doc, input, inputSize, nestingLimit,
+                                       filter);
+}
+
+//
+// deserializeJson(T&, const JsonField<T> (&)[N], const std::string&, ...)
+//
+template <typename T, size_t N, typename TString>
+DeserializationError deserializeJson(
+    T& object, const JsonField<T> (&fields)[N], const TString& input,
+    NestingLimit nestingLimit = NestingLimit()) {
+  return deserialize<JsonDeserializer>(ObjectBinding<T>(object, fields, N),
+                                       input, nestingLimit);
+}
+
+//
+// deserializeJson(T&, const JsonField<T> (&)[N], std::istream&, ...)
+//
+template <typename T, size_t N, typename TStream>
+DeserializationError deserializeJson(
+    T& object, const JsonField<T> (&fields)[N], TStream& input,
+    NestingLimit nestingLimit = NestingLimit()) {
+  return deserialize<JsonDeserializer>(ObjectBinding<T>(object, fields, N),
+                                       input, nestingLimit);
+}
+
+//
+// deserializeJson(T&, const JsonField<T> (&)[N], char*, ...)
+//
+template <typename T, size_t N, typename TChar>
+DeserializationError deserializeJson(
+    T& object, const JsonField<T> (&fields)[N], TChar* input,
+    NestingLimit nestingLimit = NestingLimit()) {
+  return deserialize<JsonDeserializer>(ObjectBinding<T>(object, fields, N),
+                                       input, nestingLimit);
+}
+
+//
+// deserializeJson(T&, const JsonField<T> (&)[N], char*, size_t, ...)
+//
+template <typename T, size_t N, typename TChar>
+DeserializationError deserializeJson(
+    T& object, const JsonField<T> (&fields)[N], TChar* input,
+    size_t inputSize, NestingLimit nestingLimit = NestingLimit()) {
+  return deserialize<JsonDeserializer>(ObjectBinding<T>(object, fields, N),
+                                       input, inputSize, nestingLimit);
+}
+
+//
+// deserializeJson(T&, const JsonField<T> (&)[N], Stream&, size_t, ...)
+//
+template <typename T, size_t N, typename TStream>
+DeserializationError deserializeJson(
+    T& object, const JsonField<T> (&fields)[N], TStream& input,
+    size_t inputSize, NestingLimit nestingLimit = NestingLimit()) {
+  return deserialize<JsonDeserializer>(ObjectBinding<T>(object, fields, N),
+                                       input, inputSize, nestingLimit);
+}
+
+//
+// deserializeJson(JsonHandler&, const std::string&, ...)
+//
+template <typename TString>
+DeserializationError deserializeJson(
+    JsonHandler& handler, const TString& input,
+    NestingLimit nestingLimit = NestingLimit()) {
+  return deserialize<JsonDeserializer>(handler, input, nestingLimit);
+}
+
+//
+// deserializeJson(JsonHandler&, std::istream&, ...)
+//
+template <typename TStream>
+DeserializationError deserializeJson(
+    JsonHandler& handler, TStream& input,
+    NestingLimit nestingLimit = NestingLimit()) {
+  return deserialize<JsonDeserializer>(handler, input, nestingLimit);
+}
+
+//
+// deserializeJson(JsonHandler&, char*, ...)
+//
+template <typename TChar>
+DeserializationError deserializeJson(
+    JsonHandler& handler, TChar* input,
+    NestingLimit nestingLimit = NestingLimit()) {
+  return deserialize<JsonDeserializer>(handler, input, nestingLimit);
+}
+
+//
+// deserializeJson(JsonHandler&, char*, size_t, ...)
+//
+template <typename TChar>
+DeserializationError deserializeJson(
+    JsonHandler& handler, TChar* input, size_t inputSize,
+    NestingLimit nestingLimit = NestingLimit()) {
+  return deserialize<JsonDeserializer>(handler, input, inputSize,
+                                       nestingLimit);
+}
+
+//
+// deserializeJson(JsonHandler&, Stream&, size_t, ...)
+//
+template <typename TStream>
+DeserializationError deserializeJson(
+    JsonHandler& handler, TStream& input, size_t inputSize,
+    NestingLimit nestingLimit = NestingLimit()) {
+  return deserialize<JsonDeserializer>(handler, input, inputSize,
+                                       nestingLimit);
+}
+
 }  // namespace ARDUINOJSON_NAMESPACE
@@ -0,0 +1,118 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Document/JsonDocument.hpp>
+#include <ArduinoJson/Json/JsonHandler.hpp>
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Builds the events it receives into a JsonDocument.
+// A JsonHandler can forward the events of a subtree to a JsonDocumentBuilder to
+// materialize this subtree only.
+class JsonDocumentBuilder : public JsonHandler {
+ public:
+  explicit JsonDocumentBuilder(JsonDocument& doc)
+      : _root(VariantAttorney::getData(doc)),
+        _pool(VariantAttorney::getPool(doc)) {
+    reset();
+  }
+
+  // Clears the document to build a new value
+  void reset() {
+    _root->setNull();
+    _pool->clear();
+    _member = 0;
+    _depth = 0;
+    _rootDone = false;
+    _overflowed = false;
+  }
+
+  // true if the document was too small or the nesting was too deep
+  bool overflowed() const {
+    return _overflowed || _pool->overflowed();
+  }
+
+  virtual void startObject() {
+    VariantData* object = nextValue();
+    variantToObject(object);
+    push(object);
+  }
+
+  virtual void endObject() {
+    pop();
+  }
+
+  virtual void startArray() {
+    VariantData* array = nextValue();
+    variantToArray(array);
+    push(array);
+  }
+
+  virtual void endArray() {
+    pop();
+  }
+
+  virtual void key(String k) {
+    if (_depth > 0 && _depth <= maxDepth && _stack[_depth - 1])
+      _member = variantGetOrAddMember(_stack[_depth - 1], k, _pool);
+    else
+      _member = 0;
+    if (!_member)
+      _overflowed = true;
+  }
+
+  virtual void value(VariantConstRef v) {
+    VariantData* dst = nextValue();
+    if (!variantCopyFrom(dst, VariantAttorney::getData(v), _pool))
+      _overflowed = true;
+  }
+
+ private:
+  static const uint8_t maxDepth = ARDUINOJSON_DEFAULT_NESTING_LIMIT;
+
+  // Returns the variant that receives the next value, or null if it can't be
+  // stored
+  VariantData* nextValue() {
+    if (_depth == 0) {
+      if (_rootDone)
+        return 0;
+      _rootDone = true;
+      return _root;
+    }
+    if (_depth > maxDepth || !_stack[_depth - 1])
+      return 0;
+    VariantData* parent = _stack[_depth - 1];
+    if (parent->isObject()) {
+      VariantData* member = _member;
+      _member = 0;
+      return member;
+    }
+    return variantAddElement(parent, _pool);
+  }
+
+  void push(VariantData* collection) {
+    if (_depth < maxDepth)
+      _stack[_depth] = collection;
+    else
+      _overflowed = true;
+    _depth++;
+  }
+
+  void pop() {
+    if (_depth > 0)
+      _depth--;
+  }
+
+  VariantData* _root;
+  MemoryPool* _pool;
+  VariantData* _stack[maxDepth];
+  VariantData* _member;
+  uint8_t _depth;
+  bool _rootDone;
+  bool _overflowed;
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
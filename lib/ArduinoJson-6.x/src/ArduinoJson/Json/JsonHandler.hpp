@@ -0,0 +1,25 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Variant/VariantRef.hpp>
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Receives the events of deserializeJson(JsonHandler&, ...).
+// The strings passed to key() and value() are only valid during the call.
+class JsonHandler {
+ public:
+  virtual ~JsonHandler() {}
+
+  virtual void startObject() {}
+  virtual void endObject() {}
+  virtual void startArray() {}
+  virtual void endArray() {}
+  virtual void key(String) {}
+  virtual void value(VariantConstRef) {}
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
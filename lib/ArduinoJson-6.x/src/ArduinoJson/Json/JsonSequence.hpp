@@ -0,0 +1,104 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Document/JsonDocument.hpp>
+#include <ArduinoJson/Json/JsonDeserializer.hpp>
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// A stream, or a std::string, is read through its usual reader
+template <typename TInput, typename Enable = void>
+struct JsonSequenceReader {
+  typedef Reader<TInput> type;
+};
+
+// A buffer is read up to the specified size
+template <typename TChar>
+struct JsonSequenceReader<
+    TChar*, typename enable_if<IsCharOrVoid<TChar>::value>::type> {
+  typedef BoundedReader<TChar*> type;
+};
+
+// Reads a sequence of JSON values into the same document, one value per call:
+// JSON Lines (NDJSON), or JSON text sequences (RFC 7464).
+// The input is read only once, and the document is cleared before each value,
+// so its memory pool is reused instead of allocated again.
+//
+// DynamicJsonDocument doc(1024);
+// JsonSequence<std::istream> records(doc, file);
+// for (;;) {
+//   DeserializationError err = records.next();
+//   if (err == DeserializationError::EmptyInput)
+//     break;  // end of the input
+//   if (err)
+//     continue;  // the next call resumes at the next line
+//   ...
+// }
+//
+// A value that is not complete on its line can take the next line with it.
+template <typename TInput>
+class JsonSequence {
+  typedef typename JsonSequenceReader<TInput>::type reader_type;
+
+ public:
+  // Reads a stream, like std::istream and Stream, or a std::string
+  JsonSequence(JsonDocument& doc, TInput& input,
+               NestingLimit nestingLimit = NestingLimit())
+      : _doc(&doc),
+        _deserializer(VariantAttorney::getPool(doc), reader_type(input),
+                      StringCopier(VariantAttorney::getPool(doc))),
+        _nestingLimit(nestingLimit),
+        _count(0),
+        _failed(false) {}
+
+  // Reads a buffer of the specified size
+  JsonSequence(JsonDocument& doc, TInput input, size_t inputSize,
+               NestingLimit nestingLimit = NestingLimit())
+      : _doc(&doc),
+        _deserializer(VariantAttorney::getPool(doc),
+                      reader_type(input, inputSize),
+                      StringCopier(VariantAttorney::getPool(doc))),
+        _nestingLimit(nestingLimit),
+        _count(0),
+        _failed(false) {}
+
+  // Parses the next value into the document.
+  // Returns EmptyInput at the end of the input.
+  DeserializationError next() {
+    return parseNext(AllowAllFilter());
+  }
+
+  DeserializationError next(Filter filter) {
+    return parseNext(filter);
+  }
+
+  // Number of values parsed successfully
+  size_t count() const {
+    return _count;
+  }
+
+ private:
+  template <typename TFilter>
+  DeserializationError parseNext(TFilter filter) {
+    if (_failed)
+      _deserializer.skipLine();
+    _doc->clear();
+    DeserializationError err = _deserializer.parseNext(
+        *VariantAttorney::getData(*_doc), filter, _nestingLimit);
+    _failed = err && err != DeserializationError::EmptyInput;
+    if (!err)
+      _count++;
+    return err;
+  }
+
+  JsonDocument* _doc;
+  JsonDeserializer<reader_type, StringCopier> _deserializer;
+  NestingLimit _nestingLimit;
+  size_t _count;
+  bool _failed;
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
@@ -32,6 +32,13 @@ class Latch {
     return _current;
   }
 
+  // Gives access to the reader to consume several characters at once.
+  // Only allowed when no character is pending.
+  TReader& reader() {
+    ARDUINOJSON_ASSERT(!_loaded);
+    return _reader;
+  }
+
  private:
   void load() {
     ARDUINOJSON_ASSERT(!_ended);
@@ -0,0 +1,45 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Polyfills/swar.hpp>
+
+#include <stddef.h>  // size_t
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// A character that can be copied verbatim from a quoted string: not the
+// closing quote, not a backslash, and not a control character (which includes
+// the terminator)
+inline bool isPlainStringChar(char c, char stopChar) {
+  return c != stopChar && c != '\\' && static_cast<unsigned char>(c) >= 0x20;
+}
+
+// Returns the number of plain characters at the beginning of [s, end)
+inline size_t scanPlainChars(const char* s, const char* end, char stopChar) {
+  const char* p = s;
+  while (size_t(end - p) >= sizeof(swar_word_t)) {
+    swar_word_t w = swarLoad(p);
+    if (swarHasByte(w, static_cast<unsigned char>(stopChar)) ||
+        swarHasByte(w, '\\') || swarHasLess(w, 0x20))
+      break;
+    p += sizeof(swar_word_t);
+  }
+  while (p < end && isPlainStringChar(*p, stopChar))
+    p++;
+  return size_t(p - s);
+}
+
+// Returns the number of plain characters at the beginning of the
+// null-terminated string s.
+// The end of the input is unknown, so it never reads past the terminator.
+inline size_t scanPlainChars(const char* s, char stopChar) {
+  const char* p = s;
+  while (isPlainStringChar(*p, stopChar))
+    p++;
+  return size_t(p - s);
+}
+
+}  // namespace ARDUINOJSON_NAMESPACE
@@ -8,8 +8,11 @@
 #include <string.h>  // for strlen
 
 #include <ArduinoJson/Json/EscapeSequence.hpp>
+#include <ArduinoJson/Json/StringScanner.hpp>
+#include <ArduinoJson/Numbers/FloatDigits.hpp>
 #include <ArduinoJson/Numbers/FloatParts.hpp>
 #include <ArduinoJson/Numbers/Integer.hpp>
+#include <ArduinoJson/Numbers/IntegerDigits.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
 #include <ArduinoJson/Polyfills/attributes.hpp>
 #include <ArduinoJson/Polyfills/type_traits.hpp>
@@ -36,15 +39,24 @@ class TextFormatter {
 
   void writeString(const char* value) {
     ARDUINOJSON_ASSERT(value != NULL);
-    writeRaw('\"');
-    while (*value) writeChar(*value++);
-    writeRaw('\"');
+    writeString(value, strlen(value));
   }
 
+  // Writes the runs of characters that don't need to be escaped with a single
+  // call to the writer; the runs are found a word at a time.
   void writeString(const char* value, size_t n) {
     ARDUINOJSON_ASSERT(value != NULL);
+    const char* end = value + n;
     writeRaw('\"');
-    while (n--) writeChar(*value++);
+    while (value < end) {
+      size_t plain = scanPlainChars(value, end, '\"');
+      if (plain) {
+        writeRaw(value, plain);
+        value += plain;
+      }
+      if (value < end)
+        writeChar(*value++);
+    }
     writeRaw('\"');
   }
 
@@ -83,6 +95,9 @@ class TextFormatter {
     }
 #endif
 
+#if ARDUINOJSON_USE_SHORTEST_FLOAT_FORMAT
+    writeShortestFloat(value);
+#else
     FloatParts<T> parts(value);
 
     writeInteger(parts.integral);
@@ -93,6 +108,60 @@ class TextFormatter {
       writeRaw('e');
       writeInteger(parts.exponent);
     }
+#endif
+  }
+
+  template <typename T>
+  void writeShortestFloat(T value) {
+    if (value == 0)
+      return writeRaw('0');
+
+    // The variants store the floats as doubles, so a double that is exactly a
+    // float gets the digits of the float: 21.35 instead of 21.350000381469727
+    if (isWidenedFloat(value))
+      writeFloatDigits(FloatDigits<float>(float(value)), value);
+    else
+      writeFloatDigits(FloatDigits<T>(value), value);
+  }
+
+  template <typename TDigits, typename T>
+  void writeFloatDigits(const TDigits& parts, T value) {
+    const char* digits = parts.digits;
+    int length = parts.length;
+    int point = length + parts.exponent;  // position of the decimal point
+
+    if (value >= ARDUINOJSON_POSITIVE_EXPONENTIATION_THRESHOLD ||
+        value <= ARDUINOJSON_NEGATIVE_EXPONENTIATION_THRESHOLD) {
+      writeRaw(digits[0]);
+      if (length > 1) {
+        writeRaw('.');
+        writeRaw(digits + 1, size_t(length - 1));
+      }
+      writeRaw('e');
+      writeInteger(int16_t(point - 1));
+    } else if (point <= 0) {
+      writeRaw("0.");
+      for (; point < 0; point++)
+        writeRaw('0');
+      writeRaw(digits, size_t(length));
+    } else if (point >= length) {
+      writeRaw(digits, size_t(length));
+      for (; length < point; length++)
+        writeRaw('0');
+    } else {
+      writeRaw(digits, size_t(point));
+      writeRaw('.');
+      writeRaw(digits + point, size_t(length - point));
+    }
+  }
+
+  static bool isWidenedFloat(double value) {
+    return value <= FloatTraits<float>::highest() &&
+           double(float(value)) == value;
+  }
+
+  static bool isWidenedFloat(float) {
+    return false;
   }
 
   template <typename T>
@@ -110,6 +179,12 @@ class TextFormatter {
 
   template <typename T>
   typename enable_if<is_unsigned<T>::value>::type writeInteger(T value) {
+#if ARDUINOJSON_ENABLE_DIGIT_PAIRS
+    char buffer[20];
+    uint8_t length = countDigits(value);
+    writeDigitPairs(value, buffer + length);
+    writeRaw(buffer, length);
+#else
     char buffer[22];
     char* end = buffer + sizeof(buffer);
     char* begin = end;
@@ -122,11 +197,21 @@ class TextFormatter {
 
     // and dump it in the right order
     writeRaw(begin, end);
+#endif
   }
 
   void writeDecimals(uint32_t value, int8_t width) {
     // buffer should be big enough for all digits and the dot
     char buffer[16];
+#if ARDUINOJSON_ENABLE_DIGIT_PAIRS
+    ARDUINOJSON_ASSERT(countDigits(value) <= width);
+    buffer[0] = '.';
+    char* end = buffer + 1 + width;
+    char* begin = writeDigitPairs(value, end);
+    while (begin > buffer + 1)  // leading zeros
+      *--begin = '0';
+    writeRaw(buffer, end);
+#else
     char* end = buffer + sizeof(buffer);
     char* begin = end;
 
@@ -139,6 +224,7 @@ class TextFormatter {
 
     // and dump it in the right order
     writeRaw(begin, end);
+#endif
   }
 
   void writeRaw(const char* s) {
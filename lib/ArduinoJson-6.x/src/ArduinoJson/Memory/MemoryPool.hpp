@@ -8,14 +8,79 @@
 #include <ArduinoJson/Polyfills/assert.hpp>
 #include <ArduinoJson/Polyfills/mpl/max.hpp>
 #include <ArduinoJson/Strings/StringAdapters.hpp>
+#include <ArduinoJson/Strings/StringHasher.hpp>
 #include <ArduinoJson/Variant/VariantSlot.hpp>
 
-#include <string.h>  // memmove
+#include <string.h>  // memmove, memset, strlen
 
 #define JSON_STRING_SIZE(SIZE) (SIZE + 1)
 
 namespace ARDUINOJSON_NAMESPACE {
 
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+// Allocates and releases the blocks of a growable MemoryPool.
+// Uses function pointers rather than virtual functions, so that the documents
+// don't need a vtable.
+class MemoryBlockAllocator {
+ public:
+  void* allocateBlock(size_t size) {
+    return _allocate(this, size);
+  }
+
+  void deallocateBlock(void* block) {
+    _deallocate(this, block);
+  }
+
+ protected:
+  typedef void* (*AllocateFunction)(MemoryBlockAllocator*, size_t);
+  typedef void (*DeallocateFunction)(MemoryBlockAllocator*, void*);
+
+  MemoryBlockAllocator(AllocateFunction allocate, DeallocateFunction deallocate)
+      : _allocate(allocate), _deallocate(deallocate) {}
+
+ private:
+  AllocateFunction _allocate;
+  DeallocateFunction _deallocate;
+};
+
+// Header of each block of a growable MemoryPool; the strings and the variants
+// of the block follow the header.
+struct MemoryBlock {
+  MemoryBlock* next;
+  char* left;   // saved when the next block is chained
+  char* right;  // saved when the next block is chained
+  char* end;
+
+  char* begin() {
+    return reinterpret_cast<char*>(this) +
+           AddPadding<sizeof(MemoryBlock)>::value;
+  }
+};
+#endif
+
+// State of a MemoryPool, as returned by MemoryPool::mark()
+struct MemoryPoolMark {
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+  MemoryBlock* block;
+#endif
+  char* left;
+  char* right;
+  bool overflowed;
+};
+
+#if ARDUINOJSON_ENABLE_MEMORY_STATS
+// Counters of a MemoryPool, as returned by JsonDocument::memoryStats()
+struct MemoryPoolStats {
+  size_t slots;        // variants allocated
+  size_t strings;      // strings copied in the pool
+  size_t stringBytes;  // bytes of these strings, terminators included
+  size_t dedupHits;    // strings found in the pool instead of being copied
+  size_t overflows;    // times the pool became full
+  size_t blocks;       // blocks allocated by a growable pool
+  size_t peakSize;     // see MemoryPool::peakSize()
+};
+#endif
+
 // _begin                                   _end
 // v                                           v
 // +-------------+--------------+--------------+
@@ -23,6 +88,17 @@ namespace ARDUINOJSON_NAMESPACE {
 // +-------------+--------------+--------------+
 //               ^              ^
 //             _left          _right
+//
+// With ARDUINOJSON_ENABLE_STRING_HASH_INDEX, the right side also contains the
+// hash table of the strings, located by its distance to _end.
+//
+// With ARDUINOJSON_ENABLE_GROWABLE_POOL, a growable pool chains blocks of the
+// same layout when the current one is full, so it never needs to be
+// reallocated. The previous blocks are only read, to find the strings to
+// deduplicate; the hash table only covers the current block.
+// VariantSlot links the slots with a VariantSlotDiff, so all the blocks must
+// be within its range (512KB on 32-bit platforms); a block allocated farther
+// away counts as a failed allocation.
 
 class MemoryPool {
  public:
@@ -32,11 +108,61 @@ class MemoryPool {
         _right(buf ? buf + capa : 0),
         _end(buf ? buf + capa : 0),
         _overflowed(false) {
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    _allocator = 0;
+    _blockSize = 0;
+    _firstBlock = 0;
+#endif
+#if ARDUINOJSON_ENABLE_MEMORY_STATS
+    resetStats();
+#elif ARDUINOJSON_ENABLE_GROWABLE_POOL
+    _peak = 0;
+#endif
+#if ARDUINOJSON_ENABLE_STRING_HASH_INDEX
+    resetIndex();
+#endif
     ARDUINOJSON_ASSERT(isAligned(_begin));
     ARDUINOJSON_ASSERT(isAligned(_right));
     ARDUINOJSON_ASSERT(isAligned(_end));
   }
 
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+  // Creates a growable pool, which allocates blocks of blockSize bytes as
+  // needed. The capacity remains 0 if the first block can't be allocated.
+  MemoryPool(MemoryBlockAllocator& allocator, size_t blockSize)
+      : _begin(0),
+        _left(0),
+        _right(0),
+        _end(0),
+        _overflowed(false),
+        _allocator(&allocator),
+        _blockSize(addPadding(blockSize)),
+        _firstBlock(0),
+        _peak(0) {
+#  if ARDUINOJSON_ENABLE_MEMORY_STATS
+    resetStats();
+#  endif
+#  if ARDUINOJSON_ENABLE_STRING_HASH_INDEX
+    resetIndex();
+#  endif
+    chainBlock(_blockSize);
+  }
+
+  // Releases the blocks of a growable pool
+  void releaseBlocks() {
+    releaseBlocksAfter(0);
+    _begin = _left = _right = _end = 0;
+  }
+
+  void setAllocator(MemoryBlockAllocator* allocator) {
+    _allocator = allocator;
+  }
+
+  bool isGrowable() const {
+    return _allocator != 0;
+  }
+#endif
+
   void* buffer() {
     return _begin;  // NOLINT(clang-analyzer-unix.Malloc)
                     // movePointers() alters this pointer
@@ -44,19 +170,66 @@ class MemoryPool {
 
   // Gets the capacity of the memoryPool in bytes
   size_t capacity() const {
-    return size_t(_end - _begin);
+    size_t n = size_t(_end - _begin);
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    for (MemoryBlock* b = _firstBlock; b != currentBlock(); b = b->next)
+      n += size_t(b->end - b->begin());
+#endif
+    return n;
   }
 
   size_t size() const {
-    return size_t(_left - _begin + _end - _right);
+    size_t n = size_t(_left - _begin + _end - _right);
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    for (MemoryBlock* b = _firstBlock; b != currentBlock(); b = b->next)
+      n += size_t(b->left - b->begin() + b->end - b->right);
+#endif
+    return n;
   }
 
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL || ARDUINOJSON_ENABLE_MEMORY_STATS
+  // Gets the highest size() since the pool was created; clear() and rewind()
+  // don't reset it
+  size_t peakSize() const {
+    size_t n = size();
+    return n > _peak ? n : _peak;
+  }
+#endif
+
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+  size_t blockCount() const {
+    size_t n = 0;
+    for (MemoryBlock* b = _firstBlock; b; b = b->next)
+      n++;
+    return n;
+  }
+#endif
+
   bool overflowed() const {
     return _overflowed;
   }
 
+#if ARDUINOJSON_ENABLE_MEMORY_STATS
+  MemoryPoolStats stats() const {
+    MemoryPoolStats s = _stats;
+    s.peakSize = peakSize();
+    return s;
+  }
+
+  // Resets the counters, and the peak to the current size
+  void resetStats() {
+    memset(&_stats, 0, sizeof(_stats));
+    _peak = size();
+  }
+#endif
+
   VariantSlot* allocVariant() {
-    return allocRight<VariantSlot>();
+    VariantSlot* slot = allocRight<VariantSlot>();
+#if ARDUINOJSON_ENABLE_MEMORY_STATS
+    if (slot)
+      _stats.slots++;
+#endif
+    return slot;
   }
 
   template <typename TAdaptedString>
@@ -66,8 +239,12 @@ class MemoryPool {
 
 #if ARDUINOJSON_ENABLE_STRING_DEDUPLICATION
     const char* existingCopy = findString(str);
-    if (existingCopy)
+    if (existingCopy) {
+#  if ARDUINOJSON_ENABLE_MEMORY_STATS
+      _stats.dedupHits++;
+#  endif
       return existingCopy;
+    }
 #endif
 
     size_t n = str.size();
@@ -76,6 +253,12 @@ class MemoryPool {
     if (newCopy) {
       stringGetChars(str, newCopy, n);
       newCopy[n] = 0;  // force null-terminator
+#if ARDUINOJSON_ENABLE_MEMORY_STATS
+      countString(n);
+#endif
+#if ARDUINOJSON_ENABLE_STRING_HASH_INDEX
+      indexString(newCopy, n);
+#endif
     }
     return newCopy;
   }
@@ -85,28 +268,104 @@ class MemoryPool {
     *zoneSize = size_t(_right - _left);
   }
 
+  // Moves the string being written in the free zone to a new block, because
+  // it doesn't fit in the current one.
+  // Returns false if the pool isn't growable or the allocation failed.
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+  bool growFreeZone(char** zoneStart, size_t* zoneSize, size_t used) {
+    ARDUINOJSON_ASSERT(*zoneStart == _left);
+    char* oldString = _left;
+    if (!chainBlockFor(2 * size_t(_right - _left)))
+      return false;
+    memcpy(_left, oldString, used);
+    getFreeZone(zoneStart, zoneSize);
+    return true;
+  }
+#else
+  bool growFreeZone(char**, size_t*, size_t) {
+    return false;
+  }
+#endif
+
   const char* saveStringFromFreeZone(size_t len) {
 #if ARDUINOJSON_ENABLE_STRING_DEDUPLICATION
     const char* dup = findString(adaptString(_left, len));
-    if (dup)
+    if (dup) {
+#  if ARDUINOJSON_ENABLE_MEMORY_STATS
+      _stats.dedupHits++;
+#  endif
       return dup;
+    }
 #endif
 
-    const char* str = _left;
+    char* str = _left;
     _left += len;
     *_left++ = 0;
     checkInvariants();
+#if ARDUINOJSON_ENABLE_MEMORY_STATS
+    countString(len);
+#endif
+#if ARDUINOJSON_ENABLE_STRING_HASH_INDEX
+    indexString(str, len);
+#endif
     return str;
   }
 
   void markAsOverflowed() {
+#if ARDUINOJSON_ENABLE_MEMORY_STATS
+    // StringCopier calls this for each character that doesn't fit
+    if (!_overflowed)
+      _stats.overflows++;
+#endif
     _overflowed = true;
   }
 
+  // Releases the chained blocks, except the first one
   void clear() {
-    _left = _begin;
-    _right = _end;
-    _overflowed = false;
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    MemoryBlock* first = _firstBlock;
+    MemoryPoolMark start = {first, first ? first->begin() : _begin,
+                            first ? first->end : _end, false};
+#else
+    MemoryPoolMark start = {_begin, _end, false};
+#endif
+    rewind(start);
+  }
+
+  MemoryPoolMark mark() const {
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    MemoryPoolMark m = {currentBlock(), _left, _right, _overflowed};
+#else
+    MemoryPoolMark m = {_left, _right, _overflowed};
+#endif
+    return m;
+  }
+
+  // Discards everything allocated since the mark, and releases the blocks
+  // chained after it.
+  // The mark is no longer valid after a clear(), or a rewind() to an older
+  // mark.
+  void rewind(const MemoryPoolMark& m) {
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL || ARDUINOJSON_ENABLE_MEMORY_STATS
+    _peak = peakSize();
+#endif
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    if (isGrowable()) {
+      releaseBlocksAfter(m.block);
+      _begin = m.block ? m.block->begin() : 0;
+      _end = m.block ? m.block->end : 0;
+    }
+#endif
+    _left = m.left;
+    _right = m.right;
+    _overflowed = m.overflowed;
+#if ARDUINOJSON_ENABLE_STRING_HASH_INDEX
+    // the table may refer to discarded strings
+    if (_left == _begin && _right == _end)
+      resetIndex();
+    else
+      disableIndex();
+#endif
   }
 
   bool canAlloc(size_t bytes) const {
@@ -114,7 +373,16 @@ class MemoryPool {
   }
 
   bool owns(void* p) const {
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    if (_begin <= p && p < _end)
+      return true;
+    for (MemoryBlock* b = _firstBlock; b != currentBlock(); b = b->next)
+      if (b->begin() <= p && p < b->end)
+        return true;
+    return false;
+#else
     return _begin <= p && p < _end;
+#endif
   }
 
   // Workaround for missing placement new
@@ -134,6 +402,9 @@ class MemoryPool {
   //
   // This funcion is called before a realloc.
   ptrdiff_t squash() {
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    ARDUINOJSON_ASSERT(!isGrowable());
+#endif
     char* new_right = addPadding(_left);
     if (new_right >= _right)
       return 0;
@@ -164,11 +435,134 @@ class MemoryPool {
     ARDUINOJSON_ASSERT(isAligned(_right));
   }
 
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+  MemoryBlock* currentBlock() const {
+    if (!_allocator || !_begin)
+      return 0;
+    return reinterpret_cast<MemoryBlock*>(
+        _begin - AddPadding<sizeof(MemoryBlock)>::value);
+  }
+
+  bool chainBlockFor(size_t bytes) {
+    if (!_allocator)
+      return false;
+    return chainBlock(bytes > _blockSize ? addPadding(bytes) : _blockSize);
+  }
+
+  bool chainBlock(size_t capacity) {
+    const size_t headerSize = AddPadding<sizeof(MemoryBlock)>::value;
+    const size_t slotSize = sizeof(VariantSlot);
+    // the slots of all the blocks must be a whole number of slots apart,
+    // because VariantSlot stores the distance to the next slot
+    size_t margin = _end ? slotSize : 0;
+    MemoryBlock* block = reinterpret_cast<MemoryBlock*>(
+        _allocator->allocateBlock(headerSize + capacity + margin));
+    if (!block)
+      return false;
+    char* end = block->begin() + capacity + margin;
+    if (_end) {
+      end -= (address(end) % slotSize + slotSize - address(_end) % slotSize) %
+             slotSize;
+      if (!isWithinSlotRange(block->begin(), end)) {
+        _allocator->deallocateBlock(block);
+        return false;
+      }
+      MemoryBlock* current = currentBlock();
+      current->left = _left;
+      current->right = _right;
+      current->next = block;
+    } else {
+      _firstBlock = block;
+    }
+    block->next = 0;
+    block->end = end;
+    _begin = _left = block->begin();
+    _right = _end = end;
+#  if ARDUINOJSON_ENABLE_STRING_HASH_INDEX
+    resetIndex();
+#  endif
+#  if ARDUINOJSON_ENABLE_MEMORY_STATS
+    _stats.blocks++;
+#  endif
+    ARDUINOJSON_ASSERT(isAligned(_right));
+    return true;
+  }
+
+  // Checks that VariantSlotDiff can link any two slots of the pool
+  bool isWithinSlotRange(char* begin, char* end) const {
+    size_t lo = address(begin), hi = address(end);
+    for (MemoryBlock* b = _firstBlock; b; b = b->next) {
+      if (address(b->begin()) < lo)
+        lo = address(b->begin());
+      if (address(b->end) > hi)
+        hi = address(b->end);
+    }
+    return (hi - lo) / sizeof(VariantSlot) <=
+           size_t(numeric_limits<VariantSlotDiff>::highest());
+  }
+
+  void releaseBlocksAfter(MemoryBlock* last) {
+    MemoryBlock* block = last ? last->next : _firstBlock;
+    while (block) {
+      MemoryBlock* next = block->next;
+      _allocator->deallocateBlock(block);
+      block = next;
+    }
+    if (last)
+      last->next = 0;
+    else
+      _firstBlock = 0;
+  }
+
+  static size_t address(const char* p) {
+    return reinterpret_cast<size_t>(p);
+  }
+#else
+  bool chainBlockFor(size_t) {
+    return false;
+  }
+#endif
+
 #if ARDUINOJSON_ENABLE_STRING_DEDUPLICATION
   template <typename TAdaptedString>
   const char* findString(const TAdaptedString& str) const {
+#  if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    // oldest strings first, like in a single block
+    MemoryBlock* current = currentBlock();
+    for (MemoryBlock* b = _firstBlock; b != current; b = b->next) {
+      const char* existingCopy = findString(str, b->begin(), b->left);
+      if (existingCopy)
+        return existingCopy;
+    }
+#  endif
+#  if ARDUINOJSON_ENABLE_STRING_HASH_INDEX
+    // the table only covers the current block
+    if (_indexCapacity) {
+      size_t n = str.size();
+      bool hasNul;
+      size_t mask = _indexCapacity - 1;
+      uint32_t* index = indexTable();
+      // a NUL inside the string can match across stored strings, so these
+      // must use the linear scan below
+      for (size_t i = hashString(str, n, hasNul) & mask; !hasNul && index[i];
+           i = (i + 1) & mask) {
+        char* candidate = _begin + index[i] - 1;
+        if (candidate[n] == '\0' &&
+            stringEquals(str, adaptString(candidate, n)))
+          return candidate;
+      }
+      if (!hasNul)
+        return 0;
+    }
+#  endif
+    return findString(str, _begin, _left);
+  }
+
+  template <typename TAdaptedString>
+  static const char* findString(const TAdaptedString& str, char* begin,
+                                char* end) {
     size_t n = str.size();
-    for (char* next = _begin; next + n < _left; ++next) {
+    for (char* next = begin; next + n < end; ++next) {
       if (next[n] == '\0' && stringEquals(str, adaptString(next, n)))
         return next;
 
@@ -179,9 +573,16 @@ class MemoryPool {
   }
 #endif
 
+#if ARDUINOJSON_ENABLE_MEMORY_STATS
+  void countString(size_t n) {
+    _stats.strings++;
+    _stats.stringBytes += n + 1;
+  }
+#endif
+
   char* allocString(size_t n) {
-    if (!canAlloc(n)) {
-      _overflowed = true;
+    if (!canAlloc(n) && !chainBlockFor(n)) {
+      markAsOverflowed();
       return 0;
     }
     char* s = _left;
@@ -196,16 +597,117 @@ class MemoryPool {
   }
 
   void* allocRight(size_t bytes) {
-    if (!canAlloc(bytes)) {
-      _overflowed = true;
+    if (!canAlloc(bytes) && !chainBlockFor(bytes)) {
+      markAsOverflowed();
       return 0;
     }
     _right -= bytes;
     return _right;
   }
 
+#if ARDUINOJSON_ENABLE_STRING_HASH_INDEX
+  template <typename TAdaptedString>
+  static size_t hashString(const TAdaptedString& str, size_t n, bool& hasNul) {
+    StringHasher hasher;
+    hasNul = false;
+    for (size_t i = 0; i < n; i++) {
+      char c = str[i];
+      hasNul = hasNul || c == 0;
+      hasher.update(c);
+    }
+    return size_t(hasher.value());
+  }
+
+  uint32_t* indexTable() const {
+    return reinterpret_cast<uint32_t*>(_end - _indexOffset);
+  }
+
+  void resetIndex() {
+    _indexOffset = 0;
+    _indexCapacity = 0;
+    _indexCount = 0;
+    _indexDisabled = false;
+  }
+
+  // Once disabled, findString() falls back to the linear scan, which remains
+  // correct whatever was stored in the meantime.
+  void disableIndex() {
+    _indexCapacity = 0;
+    _indexDisabled = true;
+  }
+
+  void indexString(const char* s, size_t n) {
+    if (_indexDisabled)
+      return;
+
+    bool hasNul;
+    size_t hash = hashString(adaptString(s, n), n, hasNul);
+    if (hasNul)
+      return disableIndex();
+
+    // keep the load factor under 1/2
+    if (2 * (_indexCount + 1) > _indexCapacity &&
+        !growIndex(_indexCapacity ? 2 * _indexCapacity : 16))
+      return disableIndex();
+
+    size_t mask = _indexCapacity - 1;
+    uint32_t* index = indexTable();
+    size_t i = hash & mask;
+    while (index[i])
+      i = (i + 1) & mask;
+    index[i] = uint32_t(s - _begin + 1);
+    _indexCount++;
+  }
+
+  // The previous table stays in the pool, like the removed variants
+  bool growIndex(size_t capacity) {
+    size_t bytes = capacity * sizeof(uint32_t);
+    ARDUINOJSON_ASSERT(isAligned(bytes));
+    if (!canAlloc(bytes))
+      return false;
+    uint32_t* newIndex = reinterpret_cast<uint32_t*>(allocRight(bytes));
+    memset(newIndex, 0, bytes);
+
+    uint32_t* oldIndex = indexTable();
+    size_t oldCapacity = _indexCapacity;
+    _indexOffset = size_t(_end - reinterpret_cast<char*>(newIndex));
+    _indexCapacity = capacity;
+
+    size_t mask = capacity - 1;
+    for (size_t j = 0; j < oldCapacity; j++) {
+      if (!oldIndex[j])
+        continue;
+      const char* s = _begin + oldIndex[j] - 1;
+      size_t n = strlen(s);
+      bool hasNul;
+      size_t i = hashString(adaptString(s, n), n, hasNul) & mask;
+      while (newIndex[i])
+        i = (i + 1) & mask;
+      newIndex[i] = oldIndex[j];
+    }
+    return true;
+  }
+#endif
+
   char *_begin, *_left, *_right, *_end;
   bool _overflowed;
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+  MemoryBlockAllocator* _allocator;  // null unless the pool is growable
+  size_t _blockSize;
+  MemoryBlock* _firstBlock;
+#endif
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL || ARDUINOJSON_ENABLE_MEMORY_STATS
+  size_t _peak;
+#endif
+#if ARDUINOJSON_ENABLE_MEMORY_STATS
+  MemoryPoolStats _stats;
+#endif
+#if ARDUINOJSON_ENABLE_STRING_HASH_INDEX
+  size_t _indexOffset;  // distance between the table and _end
+  size_t _indexCapacity;
+  size_t _indexCount;
+  bool _indexDisabled;
+#endif
 };
 
 }  // namespace ARDUINOJSON_NAMESPACE
@@ -0,0 +1,20 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+
+#include <stddef.h>  // size_t
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Memory for the keys and the strings read by a deserializer that doesn't fill
+// a JsonDocument. The array of pointers ensures the alignment of the pool.
+struct ScratchBuffer {
+  void* data[(ARDUINOJSON_SCRATCH_BUFFER_SIZE + sizeof(void*) - 1) /
+             sizeof(void*)];
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
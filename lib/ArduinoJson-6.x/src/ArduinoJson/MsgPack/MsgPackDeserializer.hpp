@@ -11,6 +11,8 @@
 #include <ArduinoJson/Polyfills/type_traits.hpp>
 #include <ArduinoJson/Variant/VariantData.hpp>
 
+#include <string.h>  // memcpy
+
 namespace ARDUINOJSON_NAMESPACE {
 
 template <typename TReader, typename TStringStorage>
@@ -31,6 +33,33 @@ class MsgPackDeserializer {
     return _foundSomething ? err : DeserializationError::EmptyInput;
   }
 
+  template <typename T>
+  DeserializationError bind(ObjectBinding<T> binding,
+                            NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    uint8_t code = 0;
+    err = readByte(code);
+    if (err)
+      return DeserializationError::EmptyInput;
+
+    _foundSomething = true;
+
+    if ((code & 0xf0) == 0x80)
+      return bindObject(binding, code & 0x0F, nestingLimit);
+
+    switch (code) {
+      case 0xde:
+        return bindObject<uint16_t>(binding, nestingLimit);
+
+      case 0xdf:
+        return bindObject<uint32_t>(binding, nestingLimit);
+
+      default:
+        return DeserializationError::InvalidInput;
+    }
+  }
+
  private:
   template <typename TFilter>
   DeserializationError::Code parseVariant(VariantData* variant, TFilter filter,
@@ -231,6 +260,20 @@ class MsgPackDeserializer {
   }
 
   DeserializationError::Code readBytes(uint8_t* p, size_t n) {
+    return readBytes(p, n, ReaderHasDirectAccess<TReader>());
+  }
+
+  // Fast path for inputs in RAM: a single copy, which becomes a single load
+  // when n is a constant
+  DeserializationError::Code readBytes(uint8_t* p, size_t n, true_type) {
+    if (!canSkip(n))
+      return DeserializationError::IncompleteInput;
+    memcpy(p, _reader.cursor(), n);
+    _reader.skip(n);
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code readBytes(uint8_t* p, size_t n, false_type) {
     if (_reader.readBytes(reinterpret_cast<char*>(p), n) == n)
       return DeserializationError::Ok;
     return DeserializationError::IncompleteInput;
@@ -242,6 +285,17 @@ class MsgPackDeserializer {
   }
 
   DeserializationError::Code skipBytes(size_t n) {
+    return skipBytes(n, ReaderHasDirectAccess<TReader>());
+  }
+
+  DeserializationError::Code skipBytes(size_t n, true_type) {
+    if (!canSkip(n))
+      return DeserializationError::IncompleteInput;
+    _reader.skip(n);
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code skipBytes(size_t n, false_type) {
     for (; n; --n) {
       if (_reader.read() < 0)
         return DeserializationError::IncompleteInput;
@@ -249,6 +303,13 @@ class MsgPackDeserializer {
     return DeserializationError::Ok;
   }
 
+  // Tells if the input contains at least n more bytes.
+  // A null-terminated input has no known end, and may contain zeros, so the
+  // bytes are trusted, like the byte-by-byte path does.
+  bool canSkip(size_t n) const {
+    return !_reader.end() || n <= size_t(_reader.end() - _reader.cursor());
+  }
+
   template <typename T>
   DeserializationError::Code readInteger(T& value) {
     DeserializationError::Code err;
@@ -375,9 +436,27 @@ class MsgPackDeserializer {
   }
 
   DeserializationError::Code readString(size_t n) {
+    _stringStorage.startString();
+    return readString(n, ReaderHasDirectAccess<TReader>());
+  }
+
+  // Fast path for inputs in RAM: the payload is copied in one call
+  DeserializationError::Code readString(size_t n, true_type) {
+    if (!canSkip(n))
+      return DeserializationError::IncompleteInput;
+
+    _stringStorage.append(_reader.cursor(), n);
+    _reader.skip(n);
+
+    if (!_stringStorage.isValid())
+      return DeserializationError::NoMemory;
+
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code readString(size_t n, false_type) {
     DeserializationError::Code err;
 
-    _stringStorage.startString();
     for (; n; --n) {
       uint8_t c;
 
@@ -500,6 +579,56 @@ class MsgPackDeserializer {
     return DeserializationError::Ok;
   }
 
+  template <typename TSize, typename T>
+  DeserializationError::Code bindObject(ObjectBinding<T>& binding,
+                                        NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+    TSize size;
+
+    err = readInteger(size);
+    if (err)
+      return err;
+
+    return bindObject(binding, size, nestingLimit);
+  }
+
+  template <typename T>
+  DeserializationError::Code bindObject(ObjectBinding<T>& binding, size_t n,
+                                        NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    for (; n; --n) {
+      // Nothing is kept in the pool from one member to the next
+      _pool->clear();
+
+      // A key too long for the pool can't match any field
+      const JsonField<T>* field = 0;
+      err = readKey();
+      if (err == DeserializationError::Ok)
+        field = binding.find(_stringStorage.str());
+      else if (err != DeserializationError::NoMemory)
+        return err;
+
+      if (field) {
+        VariantData value;
+        value.init();
+        err = parseVariant(&value, ValueOnlyFilter(), nestingLimit.decrement());
+        if (err)
+          return err;
+        binding.assign(field, value);
+      } else {
+        err = parseVariant(0, ValueOnlyFilter(false), nestingLimit.decrement());
+        if (err)
+          return err;
+      }
+    }
+
+    return DeserializationError::Ok;
+  }
+
   DeserializationError::Code readKey() {
     DeserializationError::Code err;
     uint8_t code;
@@ -651,4 +780,88 @@ DeserializationError deserializeMsgPack(JsonDocument& doc, TChar* input,
                                           filter);
 }
 
+//
+// deserializeMsgPack(JsonDocument&, Stream&, size_t, ...)
+//
+// ... = NestingLimit
+template <typename TStream>
+DeserializationError deserializeMsgPack(
+    JsonDocument& doc, TStream& input, size_t inputSize,
+    NestingLimit nestingLimit = NestingLimit()) {
+  return deserialize<MsgPackDeserializer>(doc, input, inputSize, nestingLimit,
+                                          AllowAllFilter());
+}
+// ... = Filter, NestingLimit
+template <typename TStream>
+DeserializationError deserializeMsgPack(
+    JsonDocument& doc, TStream& input, size_t inputSize, Filter filter,
+    NestingLimit nestingLimit = NestingLimit()) {
+  return deserialize<MsgPackDeserializer>(doc, input, inputSize, nestingLimit,
+                                          filter);
+}
+// ... = NestingLimit, Filter
+template <typename TStream>
+DeserializationError deserializeMsgPack(JsonDocument& doc, TStream& input,
+                                        size_t inputSize,
+                                        NestingLimit nestingLimit,
+                                        Filter filter) {
+  return deserialize<MsgPackDeserializer>(doc, input, inputSize, nestingLimit,
+                                          filter);
+}
+
+//
+// deserializeMsgPack(T&, const JsonField<T> (&)[N], const std::string&, ...)
+//
+template <typename T, size_t N, typename TString>
+DeserializationError deserializeMsgPack(
+    T& object, const JsonField<T> (&fields)[N], const TString& input,
+    NestingLimit nestingLimit = NestingLimit()) {
+  return deserialize<MsgPackDeserializer>(ObjectBinding<T>(object, fields, N),
+                                          input, nestingLimit);
+}
+
+//
+// deserializeMsgPack(T&, const JsonField<T> (&)[N], std::istream&, ...)
+//
+template <typename T, size_t N, typename TStream>
+DeserializationError deserializeMsgPack(
+    T& object, const JsonField<T> (&fields)[N], TStream& input,
+    NestingLimit nestingLimit = NestingLimit()) {
+  return deserialize<MsgPackDeserializer>(ObjectBinding<T>(object, fields, N),
+                                          input, nestingLimit);
+}
+
+//
+// deserializeMsgPack(T&, const JsonField<T> (&)[N], char*, ...)
+//
+template <typename T, size_t N, typename TChar>
+DeserializationError deserializeMsgPack(
+    T& object, const JsonField<T> (&fields)[N], TChar* input,
+    NestingLimit nestingLimit = NestingLimit()) {
+  return deserialize<MsgPackDeserializer>(ObjectBinding<T>(object, fields, N),
+                                          input, nestingLimit);
+}
+
+//
+// deserializeMsgPack(T&, const JsonField<T> (&)[N], char*, size_t, ...)
+//
+template <typename T, size_t N, typename TChar>
+DeserializationError deserializeMsgPack(
+    T& object, const JsonField<T> (&fields)[N], TChar* input,
+    size_t inputSize, NestingLimit nestingLimit = NestingLimit()) {
+  return deserialize<MsgPackDeserializer>(ObjectBinding<T>(object, fields, N),
+                                          input, inputSize, nestingLimit);
+}
+
+//
+// deserializeMsgPack(T&, const JsonField<T> (&)[N], Stream&, size_t, ...)
+//
+template <typename T, size_t N, typename TStream>
+DeserializationError deserializeMsgPack(
+    T& object, const JsonField<T> (&fields)[N], TStream& input,
+    size_t inputSize, NestingLimit nestingLimit = NestingLimit()) {
+  return deserialize<MsgPackDeserializer>(ObjectBinding<T>(object, fields, N),
+                                          input, inputSize, nestingLimit);
+}
+
 }  // namespace ARDUINOJSON_NAMESPACE
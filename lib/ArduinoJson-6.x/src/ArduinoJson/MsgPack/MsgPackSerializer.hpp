@@ -12,6 +12,8 @@
 #include <ArduinoJson/Serialization/serialize.hpp>
 #include <ArduinoJson/Variant/VariantData.hpp>
 
+#include <string.h>  // memcpy
+
 namespace ARDUINOJSON_NAMESPACE {
 
 template <typename TWriter>
@@ -28,8 +30,7 @@ class MsgPackSerializer : public Visitor<size_t> {
       if (value32 == T(truncatedValue))
         return visitSignedInteger(truncatedValue);
     }
-    writeByte(0xCA);
-    writeInteger(value32);
+    writeInteger(0xCA, value32);
     return bytesWritten();
   }
 
@@ -39,8 +40,7 @@ class MsgPackSerializer : public Visitor<size_t> {
     float value32 = float(value64);
     if (value32 == value64)
       return visitFloat(value32);
-    writeByte(0xCB);
-    writeInteger(value64);
+    writeInteger(0xCB, value64);
     return bytesWritten();
   }
 
@@ -49,11 +49,9 @@ class MsgPackSerializer : public Visitor<size_t> {
     if (n < 0x10) {
       writeByte(uint8_t(0x90 + array.size()));
     } else if (n < 0x10000) {
-      writeByte(0xDC);
-      writeInteger(uint16_t(n));
+      writeInteger(0xDC, uint16_t(n));
     } else {
-      writeByte(0xDD);
-      writeInteger(uint32_t(n));
+      writeInteger(0xDD, uint32_t(n));
     }
     for (const VariantSlot* slot = array.head(); slot; slot = slot->next()) {
       slot->data()->accept(*this);
@@ -66,11 +64,9 @@ class MsgPackSerializer : public Visitor<size_t> {
     if (n < 0x10) {
       writeByte(uint8_t(0x80 + n));
     } else if (n < 0x10000) {
-      writeByte(0xDE);
-      writeInteger(uint16_t(n));
+      writeInteger(0xDE, uint16_t(n));
     } else {
-      writeByte(0xDF);
-      writeInteger(uint32_t(n));
+      writeInteger(0xDF, uint32_t(n));
     }
     for (const VariantSlot* slot = object.head(); slot; slot = slot->next()) {
       visitString(slot->key());
@@ -89,14 +85,11 @@ class MsgPackSerializer : public Visitor<size_t> {
     if (n < 0x20) {
       writeByte(uint8_t(0xA0 + n));
     } else if (n < 0x100) {
-      writeByte(0xD9);
-      writeInteger(uint8_t(n));
+      writeInteger(0xD9, uint8_t(n));
     } else if (n < 0x10000) {
-      writeByte(0xDA);
-      writeInteger(uint16_t(n));
+      writeInteger(0xDA, uint16_t(n));
     } else {
-      writeByte(0xDB);
-      writeInteger(uint32_t(n));
+      writeInteger(0xDB, uint32_t(n));
     }
     writeBytes(reinterpret_cast<const uint8_t*>(value), n);
     return bytesWritten();
@@ -113,11 +106,9 @@ class MsgPackSerializer : public Visitor<size_t> {
     } else if (value >= -0x20) {
       writeInteger(int8_t(value));
     } else if (value >= -0x80) {
-      writeByte(0xD0);
-      writeInteger(int8_t(value));
+      writeInteger(0xD0, int8_t(value));
     } else if (value >= -0x8000) {
-      writeByte(0xD1);
-      writeInteger(int16_t(value));
+      writeInteger(0xD1, int16_t(value));
     }
 #if ARDUINOJSON_USE_LONG_LONG
     else if (value >= -0x80000000LL)
@@ -125,13 +116,11 @@ class MsgPackSerializer : public Visitor<size_t> {
     else
 #endif
     {
-      writeByte(0xD2);
-      writeInteger(int32_t(value));
+      writeInteger(0xD2, int32_t(value));
     }
 #if ARDUINOJSON_USE_LONG_LONG
     else {
-      writeByte(0xD3);
-      writeInteger(int64_t(value));
+      writeInteger(0xD3, int64_t(value));
     }
 #endif
     return bytesWritten();
@@ -141,11 +130,9 @@ class MsgPackSerializer : public Visitor<size_t> {
     if (value <= 0x7F) {
       writeInteger(uint8_t(value));
     } else if (value <= 0xFF) {
-      writeByte(0xCC);
-      writeInteger(uint8_t(value));
+      writeInteger(0xCC, uint8_t(value));
     } else if (value <= 0xFFFF) {
-      writeByte(0xCD);
-      writeInteger(uint16_t(value));
+      writeInteger(0xCD, uint16_t(value));
     }
 #if ARDUINOJSON_USE_LONG_LONG
     else if (value <= 0xFFFFFFFF)
@@ -153,13 +140,11 @@ class MsgPackSerializer : public Visitor<size_t> {
     else
 #endif
     {
-      writeByte(0xCE);
-      writeInteger(uint32_t(value));
+      writeInteger(0xCE, uint32_t(value));
     }
 #if ARDUINOJSON_USE_LONG_LONG
     else {
-      writeByte(0xCF);
-      writeInteger(uint64_t(value));
+      writeInteger(0xCF, uint64_t(value));
     }
 #endif
     return bytesWritten();
@@ -194,6 +179,16 @@ class MsgPackSerializer : public Visitor<size_t> {
     writeBytes(reinterpret_cast<uint8_t*>(&value), sizeof(value));
   }
 
+  // Writes the type marker and the value in a single call to the writer
+  template <typename T>
+  void writeInteger(uint8_t marker, T value) {
+    uint8_t buffer[1 + sizeof(T)];
+    buffer[0] = marker;
+    fixEndianess(value);
+    memcpy(buffer + 1, &value, sizeof(value));
+    writeBytes(buffer, sizeof(buffer));
+  }
+
   CountingDecorator<TWriter> _writer;
 };
 
@@ -6,9 +6,36 @@
 
 #include <ArduinoJson/Polyfills/type_traits.hpp>
 
+#include <stdint.h>
+#include <string.h>  // memcpy
+
 namespace ARDUINOJSON_NAMESPACE {
 
 #if ARDUINOJSON_LITTLE_ENDIAN
+#  if ARDUINOJSON_HAS_BUILTIN_BSWAP
+// The copies are optimized away: each function compiles to a single byte swap
+// instruction on most CPUs, including the ESP32
+inline void fixEndianess(uint8_t* p, integral_constant<size_t, 8>) {
+  uint64_t value;
+  memcpy(&value, p, 8);
+  value = __builtin_bswap64(value);
+  memcpy(p, &value, 8);
+}
+
+inline void fixEndianess(uint8_t* p, integral_constant<size_t, 4>) {
+  uint32_t value;
+  memcpy(&value, p, 4);
+  value = __builtin_bswap32(value);
+  memcpy(p, &value, 4);
+}
+
+inline void fixEndianess(uint8_t* p, integral_constant<size_t, 2>) {
+  uint16_t value;
+  memcpy(&value, p, 2);
+  value = __builtin_bswap16(value);
+  memcpy(p, &value, 2);
+}
+#  else
 inline void swapBytes(uint8_t& a, uint8_t& b) {
   uint8_t t(a);
   a = b;
@@ -30,6 +57,7 @@ inline void fixEndianess(uint8_t* p, integral_constant<size_t, 4>) {
 inline void fixEndianess(uint8_t* p, integral_constant<size_t, 2>) {
   swapBytes(p[0], p[1]);
 }
+#  endif
 
 inline void fixEndianess(uint8_t*, integral_constant<size_t, 1>) {}
 
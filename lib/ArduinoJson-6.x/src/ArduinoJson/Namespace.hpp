@@ -10,17 +10,27 @@
 
 #ifndef ARDUINOJSON_NAMESPACE
 
-#  define ARDUINOJSON_NAMESPACE                                               \
-    ARDUINOJSON_CONCAT4(                                                      \
-        ARDUINOJSON_CONCAT4(ArduinoJson, ARDUINOJSON_VERSION_MAJOR,           \
-                            ARDUINOJSON_VERSION_MINOR,                        \
-                            ARDUINOJSON_VERSION_REVISION),                    \
-        _,                                                                    \
-        ARDUINOJSON_HEX_DIGIT(                                                \
-            ARDUINOJSON_ENABLE_PROGMEM, ARDUINOJSON_USE_LONG_LONG,            \
-            ARDUINOJSON_USE_DOUBLE, ARDUINOJSON_ENABLE_STRING_DEDUPLICATION), \
-        ARDUINOJSON_HEX_DIGIT(                                                \
-            ARDUINOJSON_ENABLE_NAN, ARDUINOJSON_ENABLE_INFINITY,              \
-            ARDUINOJSON_ENABLE_COMMENTS, ARDUINOJSON_DECODE_UNICODE))
+#  define ARDUINOJSON_NAMESPACE                                                \
+    ARDUINOJSON_CONCAT4(                                                       \
+        ARDUINOJSON_CONCAT4(ArduinoJson, ARDUINOJSON_VERSION_MAJOR,            \
+                            ARDUINOJSON_VERSION_MINOR,                         \
+                            ARDUINOJSON_VERSION_REVISION),                     \
+        _,                                                                     \
+        ARDUINOJSON_HEX_DIGIT(                                                 \
+            ARDUINOJSON_ENABLE_PROGMEM, ARDUINOJSON_USE_LONG_LONG,             \
+            ARDUINOJSON_USE_DOUBLE, ARDUINOJSON_ENABLE_STRING_DEDUPLICATION),  \
+        ARDUINOJSON_CONCAT2(                                                   \
+            ARDUINOJSON_HEX_DIGIT(                                             \
+                ARDUINOJSON_ENABLE_NAN, ARDUINOJSON_ENABLE_INFINITY,           \
+                ARDUINOJSON_ENABLE_COMMENTS, ARDUINOJSON_DECODE_UNICODE),      \
+            ARDUINOJSON_CONCAT2(                                               \
+                ARDUINOJSON_HEX_DIGIT(ARDUINOJSON_ENABLE_FAST_FLOAT_PARSING,   \
+                                      ARDUINOJSON_USE_SHORTEST_FLOAT_FORMAT,   \
+                                      ARDUINOJSON_ENABLE_STRING_HASH_INDEX,    \
+                                      ARDUINOJSON_ENABLE_KEY_HASH),            \
+                ARDUINOJSON_HEX_DIGIT(ARDUINOJSON_ENABLE_ITERATIVE_PARSING,    \
+                                      ARDUINOJSON_ENABLE_MEMORY_STATS,         \
+                                      ARDUINOJSON_ENABLE_DIGIT_PAIRS,          \
+                                      ARDUINOJSON_ENABLE_GROWABLE_POOL))))
 
 #endif
@@ -8,6 +8,7 @@
 #include <stdint.h>
 
 #include <ArduinoJson/Configuration.hpp>
+#include <ArduinoJson/Numbers/decimalToDouble.hpp>
 #include <ArduinoJson/Polyfills/alias_cast.hpp>
 #include <ArduinoJson/Polyfills/math.hpp>
 #include <ArduinoJson/Polyfills/preprocessor.hpp>
@@ -48,6 +49,16 @@ struct FloatTraits<T, 8 /*64bits*/> {
     return m;
   }
 
+  // Computes w * 10^e, correctly rounded.
+  // Returns false if the result can't be decided quickly.
+  static bool make_float_exact(uint64_t w, int e, T& result) {
+    uint64_t bits;
+    if (!decimalToDouble(w, e, bits))
+      return false;
+    result = alias_cast<T>(bits);
+    return true;
+  }
+
   static T positiveBinaryPowerOfTen(int index) {
     ARDUINOJSON_DEFINE_STATIC_ARRAY(  //
         uint32_t, factors,
@@ -174,6 +185,10 @@ struct FloatTraits<T, 4 /*32bits*/> {
     return m;
   }
 
+  static bool make_float_exact(uint64_t, int, T&) {
+    return false;  // only implemented for binary64
+  }
+
   static T positiveBinaryPowerOfTen(int index) {
     ARDUINOJSON_DEFINE_STATIC_ARRAY(uint32_t, factors,
                                     ARDUINOJSON_EXPAND6({
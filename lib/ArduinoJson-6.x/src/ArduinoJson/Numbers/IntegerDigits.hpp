@@ -0,0 +1,99 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+#include <ArduinoJson/Polyfills/static_array.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+
+#include <stdint.h>
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Number of decimal digits of value, found with a fixed number of comparisons
+// instead of a division per digit
+inline uint8_t countDigits(uint32_t value) {
+  if (value < 100000) {
+    if (value < 100)
+      return value < 10 ? 1 : 2;
+    if (value < 10000)
+      return value < 1000 ? 3 : 4;
+    return 5;
+  }
+  if (value < 10000000)
+    return value < 1000000 ? 6 : 7;
+  if (value < 1000000000)
+    return value < 100000000 ? 8 : 9;
+  return 10;
+}
+
+template <typename T>
+typename enable_if<(sizeof(T) <= 4), uint8_t>::type countDigits(T value) {
+  return countDigits(uint32_t(value));
+}
+
+template <typename T>
+typename enable_if<(sizeof(T) > 4), uint8_t>::type countDigits(T value) {
+  if (value <= T(0xFFFFFFFF))
+    return countDigits(uint32_t(value));
+  const T tenDigits = T(100000) * 100000;
+  if (value < tenDigits)
+    return 10;
+  return uint8_t(10 + countDigits(uint32_t(value / tenDigits)));
+}
+
+// Writes the digits of value before end, and returns a pointer to the first
+// digit.
+// Each division by 100 produces two digits, copied from a 200-byte table.
+inline char* writeDigitPairs(uint32_t value, char* end) {
+  ARDUINOJSON_DEFINE_STATIC_ARRAY(char, digitPairs,
+                                  "00010203040506070809"
+                                  "10111213141516171819"
+                                  "20212223242526272829"
+                                  "30313233343536373839"
+                                  "40414243444546474849"
+                                  "50515253545556575859"
+                                  "60616263646566676869"
+                                  "70717273747576777879"
+                                  "80818283848586878889"
+                                  "90919293949596979899");
+  while (value >= 100) {
+    uint32_t pair = 2 * (value % 100);
+    value /= 100;
+    *--end = ARDUINOJSON_READ_STATIC_ARRAY(char, digitPairs, pair + 1);
+    *--end = ARDUINOJSON_READ_STATIC_ARRAY(char, digitPairs, pair);
+  }
+  if (value >= 10) {
+    *--end = ARDUINOJSON_READ_STATIC_ARRAY(char, digitPairs, 2 * value + 1);
+    *--end = ARDUINOJSON_READ_STATIC_ARRAY(char, digitPairs, 2 * value);
+  } else {
+    *--end = char('0' + value);
+  }
+  return end;
+}
+
+template <typename T>
+typename enable_if<(sizeof(T) <= 4), char*>::type writeDigitPairs(T value,
+                                                                  char* end) {
+  return writeDigitPairs(uint32_t(value), end);
+}
+
+// 64-bit divisions are slow on 32-bit microcontrollers, so the value is split
+// in chunks of 8 digits, which are written with 32-bit divisions
+template <typename T>
+typename enable_if<(sizeof(T) > 4), char*>::type writeDigitPairs(T value,
+                                                                 char* end) {
+  const uint32_t eightDigits = 100000000;
+  while (value > T(0xFFFFFFFF)) {
+    char* chunkEnd = end;
+    end = writeDigitPairs(uint32_t(value % eightDigits), end);
+    value = T(value / eightDigits);
+    while (end > chunkEnd - 8)
+      *--end = '0';
+  }
+  return writeDigitPairs(uint32_t(value), end);
+}
+
+}  // namespace ARDUINOJSON_NAMESPACE
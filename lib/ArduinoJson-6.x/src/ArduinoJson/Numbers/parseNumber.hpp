@@ -18,6 +18,100 @@ namespace ARDUINOJSON_NAMESPACE {
 template <typename A, typename B>
 struct choose_largest : conditional<(sizeof(A) > sizeof(B)), A, B> {};
 
+#if ARDUINOJSON_ENABLE_FAST_FLOAT_PARSING
+// Parses an unsigned decimal number (digits, fraction, exponent) as w * 10^q
+// and converts it with FloatTraits::make_float_exact().
+// Returns false if the input isn't a plain decimal number or if the result
+// can't be decided quickly; the caller must then use the slow path.
+template <typename T>
+inline bool parseFloatFast(const char* s, T& result) {
+  typedef FloatTraits<T> traits;
+
+  const int maxDigits = 19;  // 10^19 < 2^64
+  uint64_t w = 0;
+  int q = 0;
+  int digits = 0;
+  bool foundDigit = false;
+  bool truncated = false;
+
+  while (*s == '0') {
+    foundDigit = true;
+    s++;
+  }
+
+  for (; isdigit(*s); s++) {
+    foundDigit = true;
+    if (digits < maxDigits) {
+      w = w * 10 + uint8_t(*s - '0');
+      digits++;
+    } else {
+      q++;
+      if (*s != '0')
+        truncated = true;
+    }
+  }
+
+  if (*s == '.') {
+    s++;
+    if (digits == 0) {
+      while (*s == '0') {
+        foundDigit = true;
+        q--;
+        s++;
+      }
+    }
+    for (; isdigit(*s); s++) {
+      foundDigit = true;
+      if (digits < maxDigits) {
+        w = w * 10 + uint8_t(*s - '0');
+        digits++;
+        q--;
+      } else if (*s != '0') {
+        truncated = true;
+      }
+    }
+  }
+
+  if (!foundDigit)
+    return false;
+
+  if (*s == 'e' || *s == 'E') {
+    s++;
+    bool negativeExponent = false;
+    if (*s == '-') {
+      negativeExponent = true;
+      s++;
+    } else if (*s == '+') {
+      s++;
+    }
+    if (!isdigit(*s))
+      return false;
+    int exponent = 0;
+    for (; isdigit(*s); s++) {
+      if (exponent < 10000)  // way out of range anyway
+        exponent = exponent * 10 + (*s - '0');
+    }
+    q += negativeExponent ? -exponent : exponent;
+  }
+
+  if (*s != '\0')
+    return false;
+
+  if (!traits::make_float_exact(w, q, result))
+    return false;
+
+  // Digits were dropped: the value is between w and w+1, both must round to
+  // the same float
+  if (truncated) {
+    T upper;
+    if (!traits::make_float_exact(w + 1, q, upper) || upper != result)
+      return false;
+  }
+
+  return true;
+}
+#endif
+
 inline bool parseNumber(const char* s, VariantData& result) {
   typedef FloatTraits<Float> traits;
   typedef choose_largest<traits::mantissa_type, UInt>::type mantissa_t;
@@ -53,6 +147,10 @@ inline bool parseNumber(const char* s, VariantData& result) {
   if (!isdigit(*s) && *s != '.')
     return false;
 
+#if ARDUINOJSON_ENABLE_FAST_FLOAT_PARSING
+  const char* digits = s;
+#endif
+
   mantissa_t mantissa = 0;
   exponent_t exponent_offset = 0;
   const mantissa_t maxUint = UInt(-1);
@@ -82,6 +180,14 @@ inline bool parseNumber(const char* s, VariantData& result) {
     }
   }
 
+#if ARDUINOJSON_ENABLE_FAST_FLOAT_PARSING
+  Float fastResult;
+  if (parseFloatFast(digits, fastResult)) {
+    result.setFloat(is_negative ? -fastResult : fastResult);
+    return true;
+  }
+#endif
+
   // avoid mantissa overflow
   while (mantissa > traits::mantissa_max) {
     mantissa /= 10;
@@ -27,7 +27,7 @@ class PairPtr {
 
 class ObjectIterator {
  public:
-  ObjectIterator() : _slot(0) {}
+  ObjectIterator() : _pool(0), _slot(0) {}
 
   explicit ObjectIterator(MemoryPool* pool, VariantSlot* slot)
       : _pool(pool), _slot(slot) {}
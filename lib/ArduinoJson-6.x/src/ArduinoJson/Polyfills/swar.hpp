@@ -0,0 +1,53 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+
+#include <stdint.h>  // uint32_t, uint64_t
+#include <string.h>  // memcpy
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// SIMD-within-a-register helpers: process several bytes in a single integer
+
+#if defined(__SIZEOF_POINTER__) && __SIZEOF_POINTER__ >= 8 || \
+    defined(_WIN64) && _WIN64
+typedef uint64_t swar_word_t;
+#else
+typedef uint32_t swar_word_t;
+#endif
+
+const swar_word_t swarOnes = swar_word_t(~swar_word_t(0)) / 0xFF;  // 0x0101...
+const swar_word_t swarHighs = swarOnes * 0x80;                      // 0x8080...
+
+// Loads a word from a potentially unaligned address
+inline swar_word_t swarLoad(const char* p) {
+  swar_word_t w;
+  memcpy(&w, p, sizeof(w));
+  return w;
+}
+
+// Returns a word with the given byte in every lane
+inline swar_word_t swarBroadcast(unsigned char c) {
+  return swarOnes * c;
+}
+
+// Tells if at least one byte of the word is zero
+inline bool swarHasZero(swar_word_t w) {
+  return ((w - swarOnes) & ~w & swarHighs) != 0;
+}
+
+// Tells if at least one byte of the word is equal to c
+inline bool swarHasByte(swar_word_t w, unsigned char c) {
+  return swarHasZero(w ^ swarBroadcast(c));
+}
+
+// Tells if at least one byte of the word is less than n (n <= 128)
+inline bool swarHasLess(swar_word_t w, unsigned char n) {
+  return ((w - swarBroadcast(n)) & ~w & swarHighs) != 0;
+}
+
+}  // namespace ARDUINOJSON_NAMESPACE
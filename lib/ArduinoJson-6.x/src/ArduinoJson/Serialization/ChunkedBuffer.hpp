@@ -0,0 +1,171 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Document/DynamicJsonDocument.hpp>
+
+#include <string.h>  // memcpy
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// A chunk of a ChunkedBuffer; the bytes follow the header
+struct BufferChunk {
+  BufferChunk* next;
+  size_t size;
+
+  const char* data() const {
+    return reinterpret_cast<const char*>(this) +
+           AddPadding<sizeof(BufferChunk)>::value;
+  }
+
+  char* data() {
+    return reinterpret_cast<char*>(this) +
+           AddPadding<sizeof(BufferChunk)>::value;
+  }
+};
+
+// A growable output made of chunks of the same capacity, so that the
+// serialization runs in a single pass, instead of measureJson() followed by
+// serializeJson(). The chunks form a scatter list that can be sent as is:
+//
+// ChunkedBuffer output(512);
+// size_t length = serializeJson(doc, output);  // the Content-Length
+// for (const BufferChunk* c = output.firstChunk(); c; c = output.next(c))
+//   client.write(c->data(), c->size);
+//
+// clear() keeps the chunks, so the next serialization reuses them.
+template <typename TAllocator>
+class BasicChunkedBuffer : AllocatorOwner<TAllocator> {
+ public:
+  explicit BasicChunkedBuffer(size_t chunkCapacity,
+                              TAllocator alloc = TAllocator())
+      : AllocatorOwner<TAllocator>(alloc),
+        _chunkCapacity(chunkCapacity),
+        _first(0),
+        _current(0),
+        _size(0),
+        _overflowed(false) {}
+
+  ~BasicChunkedBuffer() {
+    while (_first) {
+      BufferChunk* next = _first->next;
+      this->deallocate(_first);
+      _first = next;
+    }
+  }
+
+  size_t write(uint8_t c) {
+    if (!reserve())
+      return 0;
+    _current->data()[_current->size++] = static_cast<char>(c);
+    _size++;
+    return 1;
+  }
+
+  size_t write(const uint8_t* s, size_t n) {
+    size_t written = 0;
+    while (written < n && reserve()) {
+      size_t chunk = _chunkCapacity - _current->size;
+      if (chunk > n - written)
+        chunk = n - written;
+      memcpy(_current->data() + _current->size, s + written, chunk);
+      _current->size += chunk;
+      written += chunk;
+    }
+    _size += written;
+    return written;
+  }
+
+  // Rewinds the buffer, but keeps the chunks for the next serialization
+  void clear() {
+    for (BufferChunk* c = _first; c; c = c->next)
+      c->size = 0;
+    _current = _first;
+    _size = 0;
+    _overflowed = false;
+  }
+
+  // Total number of bytes in the chunks
+  size_t size() const {
+    return _size;
+  }
+
+  size_t chunkCapacity() const {
+    return _chunkCapacity;
+  }
+
+  // Number of chunks that contain data
+  size_t chunkCount() const {
+    size_t n = 0;
+    for (const BufferChunk* c = firstChunk(); c; c = next(c))
+      n++;
+    return n;
+  }
+
+  // Tells if an allocation failed, in which case the output is truncated
+  bool overflowed() const {
+    return _overflowed;
+  }
+
+  const BufferChunk* firstChunk() const {
+    return _size ? _first : 0;
+  }
+
+  // Returns the chunk after c, or null if c is the last chunk with data
+  const BufferChunk* next(const BufferChunk* c) const {
+    return c == _current ? 0 : c->next;
+  }
+
+  // Sends the chunks to a destination that has a write(buffer, size)
+  // function, like Print, and returns the number of bytes written
+  template <typename TDestination>
+  size_t writeTo(TDestination& destination) const {
+    size_t n = 0;
+    for (const BufferChunk* c = firstChunk(); c; c = next(c))
+      n += destination.write(reinterpret_cast<const uint8_t*>(c->data()),
+                             c->size);
+    return n;
+  }
+
+ private:
+  BasicChunkedBuffer(const BasicChunkedBuffer&);
+  BasicChunkedBuffer& operator=(const BasicChunkedBuffer&);
+
+  // Makes sure the current chunk has room for at least one byte
+  bool reserve() {
+    if (_current && _current->size < _chunkCapacity)
+      return true;
+    if (_current && _current->next) {  // reuse a chunk kept by clear()
+      _current = _current->next;
+      return true;
+    }
+    if (_overflowed || !_chunkCapacity)
+      return false;
+    BufferChunk* chunk = reinterpret_cast<BufferChunk*>(this->allocate(
+        AddPadding<sizeof(BufferChunk)>::value + _chunkCapacity));
+    if (!chunk) {
+      _overflowed = true;
+      return false;
+    }
+    chunk->next = 0;
+    chunk->size = 0;
+    if (_current)
+      _current->next = chunk;
+    else
+      _first = chunk;
+    _current = chunk;
+    return true;
+  }
+
+  size_t _chunkCapacity;
+  BufferChunk* _first;
+  BufferChunk* _current;  // the chunk being written
+  size_t _size;
+  bool _overflowed;
+};
+
+typedef BasicChunkedBuffer<DefaultAllocator> ChunkedBuffer;
+
+}  // namespace ARDUINOJSON_NAMESPACE
@@ -6,6 +6,8 @@
 
 #include <Arduino.h>
 
+#include <string.h>  // memcpy
+
 namespace ARDUINOJSON_NAMESPACE {
 
 template <>
@@ -29,11 +31,22 @@ class Writer< ::String, void> {
     return 1;
   }
 
+  // Copies the bytes by chunks; String::concat(const char*, size_t) is
+  // protected in most cores, so the buffer is still needed
   size_t write(const uint8_t* s, size_t n) {
-    for (size_t i = 0; i < n; i++) {
-      write(s[i]);
+    size_t written = 0;
+    while (written < n) {
+      if (_size + 1 >= bufferCapacity)
+        if (flush() != 0)
+          break;
+      size_t chunk = bufferCapacity - 1 - _size;
+      if (chunk > n - written)
+        chunk = n - written;
+      memcpy(_buffer + _size, s + written, chunk);
+      _size += chunk;
+      written += chunk;
     }
-    return n;
+    return written;
   }
 
   size_t flush() {
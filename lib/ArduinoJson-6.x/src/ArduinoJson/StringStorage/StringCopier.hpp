@@ -15,7 +15,7 @@ class StringCopier {
   void startString() {
     _pool->getFreeZone(&_ptr, &_capacity);
     _size = 0;
-    if (_capacity == 0)
+    if (_capacity == 0 && !_pool->growFreeZone(&_ptr, &_capacity, 0))
       _pool->markAsOverflowed();
   }
 
@@ -30,11 +30,17 @@ class StringCopier {
   }
 
   void append(const char* s, size_t n) {
-    while (n-- > 0) append(*s++);
+    if (_size + n < _capacity) {
+      memcpy(_ptr + _size, s, n);
+      _size += n;
+    } else {
+      while (n-- > 0) append(*s++);
+    }
   }
 
   void append(char c) {
-    if (_size + 1 < _capacity)
+    if (_size + 1 < _capacity ||
+        _pool->growFreeZone(&_ptr, &_capacity, _size))
       _ptr[_size++] = c;
     else
       _pool->markAsOverflowed();
@@ -7,11 +7,13 @@
 #include <ArduinoJson/Namespace.hpp>
 #include <ArduinoJson/Strings/String.hpp>
 
+#include <string.h>  // memmove
+
 namespace ARDUINOJSON_NAMESPACE {
 
 class StringMover {
  public:
-  StringMover(char* ptr) : _writePtr(ptr) {}
+  StringMover(char* ptr) : _writePtr(ptr), _startPtr(0) {}
 
   void startString() {
     _startPtr = _writePtr;
@@ -27,6 +29,13 @@ class StringMover {
     *_writePtr++ = c;
   }
 
+  void append(const char* s, size_t n) {
+    // The source is further in the same buffer, the ranges may overlap
+    if (s != _writePtr)
+      memmove(_writePtr, s, n);
+    _writePtr += n;
+  }
+
   bool isValid() const {
     return true;
   }
@@ -0,0 +1,47 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2022, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+
+#include <stddef.h>  // size_t
+#include <stdint.h>
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// FNV-1a
+class StringHasher {
+ public:
+  StringHasher() : _hash(2166136261UL) {}
+
+  void update(char c) {
+    _hash ^= static_cast<uint8_t>(c);
+    _hash *= 16777619UL;
+  }
+
+  uint32_t value() const {
+    return _hash;
+  }
+
+ private:
+  uint32_t _hash;
+};
+
+// 8-bit hash of a key, stops at the first NUL like the keys stored in slots
+template <typename TAdaptedString>
+inline uint8_t hashKey(const TAdaptedString& key) {
+  StringHasher hasher;
+  size_t n = key.size();
+  for (size_t i = 0; i < n; i++) {
+    char c = key[i];
+    if (!c)
+      break;
+    hasher.update(c);
+  }
+  uint32_t hash = hasher.value();
+  return uint8_t(hash ^ (hash >> 8) ^ (hash >> 16) ^ (hash >> 24));
+}
+
+}  // namespace ARDUINOJSON_NAMESPACE
@@ -216,6 +216,8 @@ class MemoryPoolPrint : public Print {
   }
 
   size_t write(uint8_t c) {
+    if (_size + 1 >= _capacity)
+      grow();
     if (_size >= _capacity)
       return 0;
 
@@ -224,9 +226,11 @@ class MemoryPoolPrint : public Print {
   }
 
   size_t write(const uint8_t* buffer, size_t size) {
-    if (_size + size >= _capacity) {
-      _size = _capacity;  // mark as overflowed
-      return 0;
+    while (_size + size >= _capacity) {
+      if (!grow()) {
+        _size = _capacity;  // mark as overflowed
+        return 0;
+      }
     }
     memcpy(&_string[_size], buffer, size);
     _size += size;
@@ -238,6 +242,11 @@ class MemoryPoolPrint : public Print {
   }
 
  private:
+  // Makes room in a growable pool
+  bool grow() {
+    return _pool->growFreeZone(&_string, &_capacity, _size);
+  }
+
   MemoryPool* _pool;
   size_t _size;
   char* _string;
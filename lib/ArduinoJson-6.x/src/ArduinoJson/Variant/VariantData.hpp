@@ -96,6 +96,10 @@ class VariantData {
     return const_cast<VariantData*>(this)->asArray();
   }
 
+  CollectionData* asCollection() {
+    return isCollection() ? &_content.asCollection : 0;
+  }
+
   const CollectionData* asCollection() const {
     return isCollection() ? &_content.asCollection : 0;
   }
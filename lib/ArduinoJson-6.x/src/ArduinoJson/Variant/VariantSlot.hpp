@@ -7,6 +7,8 @@
 #include <ArduinoJson/Polyfills/integer.hpp>
 #include <ArduinoJson/Polyfills/limits.hpp>
 #include <ArduinoJson/Polyfills/type_traits.hpp>
+#include <ArduinoJson/Strings/Adapters/RamString.hpp>
+#include <ArduinoJson/Strings/StringHasher.hpp>
 #include <ArduinoJson/Variant/VariantContent.hpp>
 
 namespace ARDUINOJSON_NAMESPACE {
@@ -19,6 +21,9 @@ class VariantSlot {
   // (+20% on ESP8266 for example)
   VariantContent _content;
   uint8_t _flags;
+#if ARDUINOJSON_ENABLE_KEY_HASH
+  uint8_t _keyHash;  // fits in the padding, except on 8-bit platforms
+#endif
   VariantSlotDiff _next;
   const char* _key;
 
@@ -83,12 +88,21 @@ class VariantSlot {
     else
       _flags |= OWNED_KEY_BIT;
     _key = k.c_str();
+#if ARDUINOJSON_ENABLE_KEY_HASH
+    _keyHash = hashKey(SizedRamString(k.c_str(), k.size()));
+#endif
   }
 
   const char* key() const {
     return _key;
   }
 
+#if ARDUINOJSON_ENABLE_KEY_HASH
+  uint8_t keyHash() const {
+    return _keyHash;
+  }
+#endif
+
   bool ownsKey() const {
     return (_flags & OWNED_KEY_BIT) != 0;
   }
@@ -97,6 +111,9 @@ class VariantSlot {
     _next = 0;
     _flags = 0;
     _key = 0;
+#if ARDUINOJSON_ENABLE_KEY_HASH
+    _keyHash = 0;
+#endif
   }
 
   void movePointers(ptrdiff_t stringDistance, ptrdiff_t variantDistance) {
@@ -37,6 +37,11 @@
 
 #include "OLEDDisplay.h"
 
+// Masks selecting the bits of a page from a given row on (head) and below a
+// given row (tail). A tail index of 0 means the span runs to the page end.
+static const uint8_t spanHeadMask[8] = { 0xFF, 0xFE, 0xFC, 0xF8, 0xF0, 0xE0, 0xC0, 0x80 };
+static const uint8_t spanTailMask[8] = { 0xFF, 0x01, 0x03, 0x07, 0x0F, 0x1F, 0x3F, 0x7F };
+
 OLEDDisplay::OLEDDisplay() {
 
 	displayWidth = 128;
@@ -213,8 +218,28 @@ void OLEDDisplay::drawRect(int16_t x, int16_t y, int16_t width, int16_t height)
 }
 
 void OLEDDisplay::fillRect(int16_t xMove, int16_t yMove, int16_t width, int16_t height) {
-  for (int16_t x = xMove; x < xMove + width; x++) {
-    drawVerticalLine(x, yMove, height);
+  int16_t xEnd = xMove + width;
+  int16_t yEnd = yMove + height;
+
+  if (xMove < 0) xMove = 0;
+  if (yMove < 0) yMove = 0;
+  if (xEnd > this->width())  xEnd = this->width();
+  if (yEnd > this->height()) yEnd = this->height();
+
+  if (xMove >= xEnd || yMove >= yEnd) return;
+
+  // Fill page by page: each page is one horizontal span with a constant mask
+  uint8_t *bufferPtr = buffer + (yMove >> 3) * this->width() + xMove;
+  uint16_t length    = xEnd - xMove;
+  int16_t  lastPage  = (yEnd - 1) >> 3;
+
+  for (int16_t page = yMove >> 3; page <= lastPage; page++) {
+    uint8_t drawBit = 0xFF;
+    if (page == (yMove >> 3)) drawBit &= spanHeadMask[yMove & 7];
+    if (page == lastPage)     drawBit &= spanTailMask[yEnd & 7];
+
+    fillSpan(bufferPtr, length, drawBit);
+    bufferPtr += this->width();
   }
 }
 
@@ -406,19 +431,7 @@ void OLEDDisplay::drawHorizontalLine(int16_t x, int16_t y, int16_t length) {
   bufferPtr += (y >> 3) * this->width();
   bufferPtr += x;
 
-  uint8_t drawBit = 1 << (y & 7);
-
-  switch (color) {
-    case WHITE:   while (length--) {
-        *bufferPtr++ |= drawBit;
-      }; break;
-    case BLACK:   drawBit = ~drawBit;   while (length--) {
-        *bufferPtr++ &= drawBit;
-      }; break;
-    case INVERSE: while (length--) {
-        *bufferPtr++ ^= drawBit;
-      }; break;
-  }
+  fillSpan(bufferPtr, length, 1 << (y & 7));
 }
 
 void OLEDDisplay::drawVerticalLine(int16_t x, int16_t y, int16_t length) {
@@ -436,20 +449,17 @@ void OLEDDisplay::drawVerticalLine(int16_t x, int16_t y, int16_t length) {
   if (length <= 0) return;
 
 
-  uint8_t yOffset = y & 7;
-  uint8_t drawBit;
   uint8_t *bufferPtr = buffer;
-
   bufferPtr += (y >> 3) * this->width();
   bufferPtr += x;
 
-  if (yOffset) {
-    yOffset = 8 - yOffset;
-    drawBit = ~(0xFF >> (yOffset));
+  int16_t yEnd     = y + length;
+  int16_t page     = y >> 3;
+  int16_t lastPage = (yEnd - 1) >> 3;
+  uint8_t drawBit  = spanHeadMask[y & 7];
 
-    if (length < yOffset) {
-      drawBit &= (0xFF >> (yOffset - length));
-    }
+  for (; page <= lastPage; page++) {
+    if (page == lastPage) drawBit &= spanTailMask[yEnd & 7];
 
     switch (color) {
       case WHITE:   *bufferPtr |=  drawBit; break;
@@ -457,40 +467,8 @@ void OLEDDisplay::drawVerticalLine(int16_t x, int16_t y, int16_t length) {
       case INVERSE: *bufferPtr ^=  drawBit; break;
     }
 
-    if (length < yOffset) return;
-
-    length -= yOffset;
     bufferPtr += this->width();
-  }
-
-  if (length >= 8) {
-    switch (color) {
-      case WHITE:
-      case BLACK:
-        drawBit = (color == WHITE) ? 0xFF : 0x00;
-        do {
-          *bufferPtr = drawBit;
-          bufferPtr += this->width();
-          length -= 8;
-        } while (length >= 8);
-        break;
-      case INVERSE:
-        do {
-          *bufferPtr = ~(*bufferPtr);
-          bufferPtr += this->width();
-          length -= 8;
-        } while (length >= 8);
-        break;
-    }
-  }
-
-  if (length > 0) {
-    drawBit = (1 << (length & 7)) - 1;
-    switch (color) {
-      case WHITE:   *bufferPtr |=  drawBit; break;
-      case BLACK:   *bufferPtr &= ~drawBit; break;
-      case INVERSE: *bufferPtr ^=  drawBit; break;
-    }
+    drawBit = 0xFF;
   }
 }
 
@@ -520,18 +498,41 @@ void OLEDDisplay::drawFastImage(int16_t xMove, int16_t yMove, int16_t width, int
 
 void OLEDDisplay::drawXbm(int16_t xMove, int16_t yMove, int16_t width, int16_t height, const uint8_t *xbm) {
   int16_t widthInXbm = (width + 7) / 8;
-  uint8_t data = 0;
-
-  for(int16_t y = 0; y < height; y++) {
-    for(int16_t x = 0; x < width; x++ ) {
-      if (x & 7) {
-        data >>= 1; // Move a bit
-      } else {  // Read new data every 8 bit
-        data = pgm_read_byte(xbm + (x / 8) + y * widthInXbm);
-      }
-      // if there is a bit draw it
-      if (data & 0x01) {
-        setPixel(xMove + x, yMove + y);
+
+  // Clip once against the screen instead of per pixel
+  int16_t xStart = xMove < 0 ? -xMove : 0;
+  int16_t yStart = yMove < 0 ? -yMove : 0;
+  int16_t xEnd   = width;
+  int16_t yEnd   = height;
+  if (xMove + xEnd > this->width())  xEnd = this->width() - xMove;
+  if (yMove + yEnd > this->height()) yEnd = this->height() - yMove;
+
+  if (xStart >= xEnd || yStart >= yEnd) return;
+
+  int16_t firstByte = xStart >> 3;
+  int16_t lastByte  = (xEnd - 1) >> 3;
+
+  for (int16_t y = yStart; y < yEnd; y++) {
+    int16_t screenY     = yMove + y;
+    uint8_t drawBit     = 1 << (screenY & 7);
+    uint8_t *bufferPtr  = buffer + (screenY >> 3) * this->width() + xMove;
+    const uint8_t *line = xbm + y * widthInXbm;
+
+    for (int16_t i = firstByte; i <= lastByte; i++) {
+      uint8_t data = pgm_read_byte(line + i);
+      // Mask out the bits that fall outside of the clipped area
+      if (i == firstByte) data &= spanHeadMask[xStart & 7];
+      if (i == lastByte)  data &= spanTailMask[xEnd & 7];
+
+      // Only visit the bits that are set, lowest bit is the leftmost pixel
+      while (data) {
+        uint8_t *pixel = bufferPtr + (i << 3) + __builtin_ctz(data);
+        switch (color) {
+          case WHITE:   *pixel |=  drawBit; break;
+          case BLACK:   *pixel &= ~drawBit; break;
+          case INVERSE: *pixel ^=  drawBit; break;
+        }
+        data &= data - 1;
       }
     }
   }
@@ -662,11 +663,13 @@ void OLEDDisplay::drawStringf( int16_t x, int16_t y, char* buffer, String format
 }
 
 uint16_t OLEDDisplay::drawStringMaxWidth(int16_t xMove, int16_t yMove, uint16_t maxLineWidth, const String &strUser) {
+  return drawStringMaxWidth(xMove, yMove, maxLineWidth, strUser.c_str());
+}
+
+uint16_t OLEDDisplay::drawStringMaxWidth(int16_t xMove, int16_t yMove, uint16_t maxLineWidth, const char *text) {
   uint16_t firstChar  = pgm_read_byte(fontData + FIRST_CHAR_POS);
   uint16_t lineHeight = pgm_read_byte(fontData + HEIGHT_POS);
 
-  const char* text = strUser.c_str();
-
   uint16_t length = strlen(text);
   uint16_t lastDrawnPos = 0;
   uint16_t lineNumber = 0;
@@ -819,6 +822,43 @@ void OLEDDisplay::clear(void) {
   memset(buffer, 0, displayBufferSize);
 }
 
+void OLEDDisplay::fillSpan(uint8_t *bufferPtr, uint16_t length, uint8_t drawBit) {
+  // Whole bytes can be set or cleared in bulk
+  if (drawBit == 0xFF && color != INVERSE) {
+    memset(bufferPtr, color == WHITE ? 0xFF : 0x00, length);
+    return;
+  }
+
+  // Process single bytes until the pointer is word aligned, then 4 bytes at once
+  uint32_t drawWord = drawBit * 0x01010101UL;
+  uint32_t word;
+
+  switch (color) {
+    case WHITE:
+      for (; length && ((uintptr_t)bufferPtr & 3); length--) *bufferPtr++ |= drawBit;
+      for (; length >= 4; length -= 4, bufferPtr += 4) {
+        memcpy(&word, bufferPtr, 4); word |= drawWord; memcpy(bufferPtr, &word, 4);
+      }
+      while (length--) *bufferPtr++ |= drawBit;
+      break;
+    case BLACK:
+      drawBit = ~drawBit; drawWord = ~drawWord;
+      for (; length && ((uintptr_t)bufferPtr & 3); length--) *bufferPtr++ &= drawBit;
+      for (; length >= 4; length -= 4, bufferPtr += 4) {
+        memcpy(&word, bufferPtr, 4); word &= drawWord; memcpy(bufferPtr, &word, 4);
+      }
+      while (length--) *bufferPtr++ &= drawBit;
+      break;
+    case INVERSE:
+      for (; length && ((uintptr_t)bufferPtr & 3); length--) *bufferPtr++ ^= drawBit;
+      for (; length >= 4; length -= 4, bufferPtr += 4) {
+        memcpy(&word, bufferPtr, 4); word ^= drawWord; memcpy(bufferPtr, &word, 4);
+      }
+      while (length--) *bufferPtr++ ^= drawBit;
+      break;
+  }
+}
+
 void OLEDDisplay::drawLogBuffer(uint16_t xMove, uint16_t yMove) {
   uint16_t lineHeight = pgm_read_byte(fontData + HEIGHT_POS);
   // Always align left
@@ -255,6 +255,9 @@ class OLEDDisplay : public Stream {
     // first line if not
     uint16_t drawStringMaxWidth(int16_t x, int16_t y, uint16_t maxLineWidth, const String &text);
 
+    // Convencience method for the const char version, it doesn't copy the text
+    uint16_t drawStringMaxWidth(int16_t x, int16_t y, uint16_t maxLineWidth, const char *text);
+
     // Returns the width of the const char* with the current
     // font settings
     uint16_t getStringWidth(const char* text, uint16_t length, bool utf8 = false);
@@ -382,6 +385,9 @@ class OLEDDisplay : public Stream {
     // converts utf8 characters to extended ascii
     char* utf8ascii(const String &s);
 
+    // Apply drawBit to length consecutive bytes of one page with the current color
+    void fillSpan(uint8_t *bufferPtr, uint16_t length, uint8_t drawBit);
+
     void inline drawInternal(int16_t xMove, int16_t yMove, int16_t width, int16_t height, const uint8_t *data, uint16_t offset, uint16_t bytesInData) __attribute__((always_inline));
 
     uint16_t drawStringInternal(int16_t xMove, int16_t yMove, const char* text, uint16_t textLength, uint16_t textWidth, bool utf8);
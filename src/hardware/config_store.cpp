@@ -0,0 +1,57 @@
+#include "config_store.h"
+#include "crc32.h"
+#include <stddef.h>
+#include <string.h>
+
+static uint32_t configCrc(const StationConfig &config)
+{
+  return calculateCrc32(&config, offsetof(StationConfig, crc));
+}
+
+void clearConfig(StationConfig &config)
+{
+  // the padding bytes are covered by the CRC as well
+  memset(&config, 0, sizeof(config));
+  config.version = CONFIG_VERSION;
+}
+
+void sealConfig(StationConfig &config)
+{
+  config.version = CONFIG_VERSION;
+  // the strings always end in the blob, even if the caller filled them up
+  config.WIFI_SSID[sizeof(config.WIFI_SSID) - 1] = 0;
+  config.WIFI_PASS[sizeof(config.WIFI_PASS) - 1] = 0;
+  config.SERVER_IP[sizeof(config.SERVER_IP) - 1] = 0;
+  config.crc = configCrc(config);
+}
+
+bool isConfigValid(const StationConfig &config)
+{
+  return config.version == CONFIG_VERSION && config.crc == configCrc(config);
+}
+
+bool setConfigString(char *field, size_t size, const char *value)
+{
+  size_t length = strlen(value);
+  if (length >= size)
+  {
+    return false;
+  }
+  memcpy(field, value, length + 1);
+  return true;
+}
+
+bool migrateNetworkSettings(StationConfig &config, const char *ssid, const char *pass, const char *ip)
+{
+  // a value cut to fit would be another network or another server, without any error
+  StationConfig migrated = config;
+  if (!setConfigString(migrated.WIFI_SSID, sizeof(migrated.WIFI_SSID), ssid) ||
+      (pass != NULL && !setConfigString(migrated.WIFI_PASS, sizeof(migrated.WIFI_PASS), pass)) ||
+      (ip != NULL && !setConfigString(migrated.SERVER_IP, sizeof(migrated.SERVER_IP), ip)))
+  {
+    return false;
+  }
+  migrated.flags |= CONFIG_HAS_WIFI;
+  config = migrated;
+  return true;
+}
@@ -0,0 +1,66 @@
+#ifndef CONFIG_STORE_H
+#define CONFIG_STORE_H
+#include <stddef.h>
+#include <stdint.h>
+
+// StationConfig is a single flat struct, saved as one blob and checked with its version and a CRC32.
+// nvs_fkt reads and writes it on the station.
+
+// Version of the layout of StationConfig, a config of another version is not loaded
+#define CONFIG_VERSION 1
+
+// Bits of StationConfig::flags
+#define CONFIG_HAS_WIFI 0x0001            // the network settings were entered in the access point
+#define CONFIG_HAS_SERVER_SETTINGS 0x0002 // the settings below were fetched from the server
+
+// Size of the URLs built from SERVER_IP: "http://", the host, the port and the longest path
+#define SERVER_URL_SIZE 128
+
+/// @brief Configuration of the station, saved as a single blob in NVS
+struct StationConfig
+{
+  uint16_t version;
+  uint16_t flags;
+  char WIFI_SSID[33];
+  char WIFI_PASS[65];
+  char SERVER_IP[100];
+  // settings fetched from the server, as in fetch_settings()
+  int32_t seeing_thr;
+  int32_t SLEEPTIME_s;
+  int32_t DISPLAY_TIMEOUT_s;
+  int32_t DISPLAY_ON;
+  double SP1;
+  double SP2;
+  double MAX_LUX;
+  double SQM_LIMIT;
+  uint32_t crc; // CRC-32 of the fields above
+};
+
+/// @brief Reset the configuration: no network settings, no server settings
+/// @param config the configuration
+void clearConfig(StationConfig &config);
+
+/// @brief Set the version and the CRC of the configuration before it is saved
+/// @param config the configuration
+void sealConfig(StationConfig &config);
+
+/// @brief Check the version and the CRC of a configuration read from the flash
+/// @param config the configuration
+/// @return true if the configuration can be used, false otherwise
+bool isConfigValid(const StationConfig &config);
+
+/// @brief Copy a string into a field of the configuration, if it fits
+/// @param field the field, e.g. config.SERVER_IP
+/// @param size the size of the field
+/// @param value the string
+/// @return true if the string was copied, false if it is too long: the field is then unchanged
+bool setConfigString(char *field, size_t size, const char *value);
+
+/// @brief Take the network settings of older firmware, read from /ssid.txt, /pass.txt and /ip.txt
+/// @param config the configuration
+/// @param ssid the SSID
+/// @param pass the password, NULL if there is no file
+/// @param ip the address of the server, NULL if there is no file
+/// @return true if all the values fit, false otherwise: the configuration is then unchanged
+bool migrateNetworkSettings(StationConfig &config, const char *ssid, const char *pass, const char *ip);
+#endif
@@ -0,0 +1,12 @@
+#ifndef CRC32_H
+#define CRC32_H
+#include <stddef.h>
+#include <stdint.h>
+
+/// @brief Compute the CRC-32 (IEEE 802.3) of a block of data
+/// @param data the data
+/// @param length the number of bytes
+/// @param crc the CRC-32 of the previous blocks, to compute the CRC-32 of several blocks as if they were one
+/// @return the CRC-32 of all the blocks
+uint32_t calculateCrc32(const void *data, size_t length, uint32_t crc = 0);
+#endif
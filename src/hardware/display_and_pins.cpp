@@ -1,7 +1,6 @@
 #include <Arduino.h>
 #include "SSD1306Wire.h"
 #include "settings.h"
-#include <vector>
 
 // for 128x64 displays:
 static SSD1306Wire display(0x3c, SDA, SCL); // ADDRESS, SDA, SCL
@@ -21,6 +20,7 @@ void DisplayStatusMessage(bool hasWIFI, bool hasServerError, bool settingsLoaded
   // Set the font and text alignment
   display.setFont(ArialMT_Plain_10);
   display.setTextAlignment(TEXT_ALIGN_LEFT);
+  char line[32];
   if (sleepForever)
   {
     display.drawStringMaxWidth(0, 0, 128, "WIFI Dead -> AP");
@@ -33,12 +33,14 @@ void DisplayStatusMessage(bool hasWIFI, bool hasServerError, bool settingsLoaded
     if (hasWIFI)
     {
       display.drawStringMaxWidth(0, 0, 128, "Connected to Wifi");
-      display.drawStringMaxWidth(0, 12, 128, "send count: " + String(sendCount));
+      snprintf(line, sizeof(line), "send count: %d", sendCount);
+      display.drawStringMaxWidth(0, 12, 128, line);
     }
     else
     {
       display.drawStringMaxWidth(0, 0, 128, "NO Wifi");
-      display.drawStringMaxWidth(0, 12, 128, "retry count: " + String(noWifiCount));
+      snprintf(line, sizeof(line), "retry count: %d", noWifiCount);
+      display.drawStringMaxWidth(0, 12, 128, line);
     }
     // Settings status
     display.drawStringMaxWidth(0, 24, 128, settingsLoaded ? "settings loaded" : "settings NOT loaded");
@@ -0,0 +1,36 @@
+#include "heap_fkt.h"
+
+#ifdef ARDUINO
+#include <Arduino.h>
+
+void sampleHeap(HeapSample &sample)
+{
+  sample.freeHeap = ESP.getFreeHeap();
+  sample.largestFreeBlock = ESP.getMaxAllocHeap();
+  sample.minFreeHeap = ESP.getMinFreeHeap();
+  for (int t = 0; t < HEAP_TASKS; t++)
+  {
+    // on the ESP32 the high-water mark is in bytes
+    TaskHandle_t task = xTaskGetHandle(heapTaskNames[t]);
+    if (task == NULL)
+    {
+      sample.stackFree[t] = HEAP_NO_TASK;
+      continue;
+    }
+    UBaseType_t stackFree = uxTaskGetStackHighWaterMark(task);
+    sample.stackFree[t] = stackFree < HEAP_NO_TASK ? stackFree : HEAP_NO_TASK - 1;
+  }
+}
+#else
+#include <string.h>
+
+// Host builds have neither the heap of the ESP32 nor its tasks: an empty sample, the checks make up their own
+void sampleHeap(HeapSample &sample)
+{
+  memset(&sample, 0, sizeof(sample));
+  for (int t = 0; t < HEAP_TASKS; t++)
+  {
+    sample.stackFree[t] = HEAP_NO_TASK;
+  }
+}
+#endif
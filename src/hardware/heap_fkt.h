@@ -0,0 +1,9 @@
+#ifndef HEAP_FKT_H
+#define HEAP_FKT_H
+#include "heap_telemetry.h"
+
+/// @brief Sample the free heap, the largest free block, the lowest free heap and the stacks of the watched tasks
+/// On a host, the sample is empty and no task is running.
+/// @param sample the sample
+void sampleHeap(HeapSample &sample);
+#endif
@@ -0,0 +1,71 @@
+#include "heap_telemetry.h"
+
+// loopTask runs setup() and loop(), tiT is the TCP/IP stack, wifi the WiFi driver, async_tcp serves the access point
+const char *const heapTaskNames[HEAP_TASKS] = {"loopTask", "tiT", "wifi", "async_tcp"};
+
+HeapHistory::HeapHistory() : _next(0), _count(0)
+{
+}
+
+void HeapHistory::add(const HeapSample &sample)
+{
+  _samples[_next] = sample;
+  _next = (_next + 1) % HEAP_HISTORY_SIZE;
+  if (_count < HEAP_HISTORY_SIZE)
+  {
+    _count++;
+  }
+}
+
+const HeapSample &HeapHistory::sample(size_t i) const
+{
+  return _samples[(_next + HEAP_HISTORY_SIZE - _count + i) % HEAP_HISTORY_SIZE];
+}
+
+bool HeapHistory::summarize(HeapSummary &summary) const
+{
+  if (_count == 0)
+  {
+    return false;
+  }
+  const HeapSample &latest = sample(_count - 1);
+  summary.samples = _count;
+  summary.freeHeap = latest.freeHeap;
+  summary.minFreeHeap = latest.minFreeHeap;
+  summary.largestFreeBlock = latest.largestFreeBlock;
+  summary.fragmentation = latest.freeHeap > 0 && latest.largestFreeBlock < latest.freeHeap ? 100 - (uint8_t)((uint64_t)latest.largestFreeBlock * 100 / latest.freeHeap) : 0;
+  for (int t = 0; t < HEAP_TASKS; t++)
+  {
+    summary.stackFree[t] = HEAP_NO_TASK;
+  }
+
+  // least squares slope of the free heap over the cycles, a leak shows as a steady negative trend
+  double meanCycle = (_count - 1) / 2.0;
+  double meanFree = 0;
+  for (size_t i = 0; i < _count; i++)
+  {
+    meanFree += sample(i).freeHeap;
+  }
+  meanFree /= _count;
+  double covariance = 0;
+  double variance = 0;
+  for (size_t i = 0; i < _count; i++)
+  {
+    const HeapSample &s = sample(i);
+    covariance += (i - meanCycle) * (s.freeHeap - meanFree);
+    variance += (i - meanCycle) * (i - meanCycle);
+    if (s.largestFreeBlock < summary.largestFreeBlock)
+    {
+      summary.largestFreeBlock = s.largestFreeBlock;
+    }
+    for (int t = 0; t < HEAP_TASKS; t++)
+    {
+      if (s.stackFree[t] < summary.stackFree[t])
+      {
+        summary.stackFree[t] = s.stackFree[t];
+      }
+    }
+  }
+  summary.freeHeapTrend = variance > 0 ? covariance / variance : 0;
+  return true;
+}
@@ -0,0 +1,69 @@
+#ifndef HEAP_TELEMETRY_H
+#define HEAP_TELEMETRY_H
+#include <stddef.h>
+#include <stdint.h>
+
+// The history is a ring of the last samples, summarized into minima and a trend for the reports.
+// heap_fkt takes the samples on the station.
+
+// Samples kept by the history, one per cycle: at least HEAP_REPORT_CYCLES, so that a report covers every cycle since the last one
+#define HEAP_HISTORY_SIZE 64
+// Tasks whose stacks are watched, named in heapTaskNames
+#define HEAP_TASKS 4
+// Stack high-water mark of a task that isn't running
+#define HEAP_NO_TASK 0xFFFF
+
+// Names of the watched FreeRTOS tasks, also used as keys in the upload
+extern const char *const heapTaskNames[HEAP_TASKS];
+
+/// @brief The state of the heap and of the task stacks at the start of a cycle, in bytes
+struct HeapSample
+{
+  uint32_t freeHeap;
+  uint32_t largestFreeBlock;        // the biggest allocation that can still succeed
+  uint32_t minFreeHeap;             // the lowest free heap since the boot
+  uint16_t stackFree[HEAP_TASKS];   // stack never used by each task since it started, HEAP_NO_TASK if not running
+};
+
+/// @brief What the history says about the heap, sent with the measurements every HEAP_REPORT_CYCLES cycles
+struct HeapSummary
+{
+  uint32_t samples;
+  uint32_t freeHeap;                // latest sample
+  uint32_t minFreeHeap;             // lowest since the boot
+  uint32_t largestFreeBlock;        // lowest of the history
+  uint8_t fragmentation;            // percent of the free heap not in the largest block, latest sample
+  float freeHeapTrend;              // bytes per cycle over the history, negative if the heap shrinks
+  uint16_t stackFree[HEAP_TASKS];   // lowest of the history, HEAP_NO_TASK if the task never ran
+};
+
+/// @brief The last HEAP_HISTORY_SIZE samples, in a ring
+class HeapHistory
+{
+public:
+  HeapHistory();
+
+  /// @brief Add a sample, the oldest is dropped when the history is full
+  /// @param sample the sample
+  void add(const HeapSample &sample);
+
+  /// @brief Get the number of samples in the history
+  /// @return the number of samples
+  size_t size() const { return _count; }
+
+  /// @brief Get a sample
+  /// @param i the index of the sample, 0 is the oldest
+  /// @return the sample
+  const HeapSample &sample(size_t i) const;
+
+  /// @brief Summarize the history
+  /// @param summary the summary
+  /// @return true if there is a sample, false otherwise
+  bool summarize(HeapSummary &summary) const;
+
+private:
+  HeapSample _samples[HEAP_HISTORY_SIZE];
+  size_t _next;
+  size_t _count;
+};
+#endif
@@ -0,0 +1,485 @@
+#include "measurement_log.h"
+#include "crc32.h"
+#include <math.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#define LOG_SEGMENT_MAGIC 0x4c4d5153 // "SQML"
+#define LOG_INDEX_MAGIC 0x494d5153   // "SQMI"
+#define LOG_VERSION 1
+#define LOG_INDEX_PATH "/tslog.idx"
+
+// Header of a segment file, as long as a record so that the records stay aligned
+struct LogSegmentHeader
+{
+  uint32_t magic;
+  uint16_t version;
+  uint16_t recordSize;
+  uint32_t id;
+  uint32_t firstSequence;
+  uint8_t reserved[12];
+  uint32_t crc;
+};
+
+// Header of the index file, followed by the summaries of the full segments, oldest first
+struct LogIndexHeader
+{
+  uint32_t magic;
+  uint16_t version;
+  uint8_t slots; // number of segment files, a segment is written to the file id % slots
+  uint8_t count;
+  uint32_t activeId;
+  uint32_t crc; // CRC-32 of the fields above and of the summaries
+};
+
+static_assert(sizeof(LogRecord) == 32, "the log format expects 32-byte records");
+static_assert(sizeof(LogSegmentHeader) == sizeof(LogRecord), "the segment header must be as long as a record");
+static_assert(sizeof(LogSegmentInfo) == 24, "the index format expects 24-byte summaries");
+static_assert(sizeof(LogIndexHeader) == 16, "the index format expects a 16-byte header");
+
+static uint32_t recordCrc(const LogRecord &record)
+{
+  return calculateCrc32(&record, offsetof(LogRecord, crc));
+}
+
+// Reset the summary of a segment that has no record yet
+static void clearInfo(LogSegmentInfo &info, uint32_t id, uint32_t firstSequence)
+{
+  info.id = id;
+  info.firstSequence = firstSequence;
+  info.count = 0;
+  info.minTime = UINT32_MAX;
+  info.maxTime = 0;
+  info.minSqm = LOG_MISSING;
+  info.maxSqm = LOG_MISSING;
+}
+
+// Add the time and the SQM value of a record to the summary of its segment
+static void addToInfo(LogSegmentInfo &info, const LogRecord &record)
+{
+  if (record.time < info.minTime)
+  {
+    info.minTime = record.time;
+  }
+  if (record.time > info.maxTime)
+  {
+    info.maxTime = record.time;
+  }
+  if (record.sqm != LOG_MISSING)
+  {
+    if (info.minSqm == LOG_MISSING || record.sqm < info.minSqm)
+    {
+      info.minSqm = record.sqm;
+    }
+    if (info.maxSqm == LOG_MISSING || record.sqm > info.maxSqm)
+    {
+      info.maxSqm = record.sqm;
+    }
+  }
+}
+
+MeasurementLog::MeasurementLog(LogStorage &storage, uint16_t recordsPerSegment, uint8_t maxSegments)
+    : _storage(storage),
+      _recordsPerSegment(recordsPerSegment > 0 ? recordsPerSegment : 1),
+      _maxSegments(maxSegments > LOG_MAX_SEGMENTS ? LOG_MAX_SEGMENTS : maxSegments),
+      _closedCount(0),
+      _buffered(0),
+      _ready(false),
+      _nextSequence(0),
+      _corrupted(0)
+{
+  clearInfo(_active, 0, 0);
+}
+
+// Load the index, or rebuild it from the segment files, then resume the last segment
+bool MeasurementLog::begin()
+{
+  _ready = false;
+  _buffered = 0;
+  if (!loadIndex())
+  {
+    rebuildIndex();
+  }
+  _nextSequence = _active.firstSequence;
+  _ready = resumeSegment();
+  return _ready;
+}
+
+// Read the index file, return false if it is missing or damaged
+bool MeasurementLog::loadIndex()
+{
+  LogIndexHeader header;
+  if (_storage.read(LOG_INDEX_PATH, 0, &header, sizeof(header)) != sizeof(header))
+  {
+    return false;
+  }
+  // another layout of the files can't be read, start again from scratch
+  if (header.magic != LOG_INDEX_MAGIC || header.version != LOG_VERSION || header.slots != _maxSegments + 1 || header.count > _maxSegments)
+  {
+    return false;
+  }
+  size_t length = header.count * sizeof(LogSegmentInfo);
+  if (_storage.read(LOG_INDEX_PATH, sizeof(header), _closed, length) != length)
+  {
+    return false;
+  }
+  uint32_t crc = calculateCrc32(_closed, length, calculateCrc32(&header, offsetof(LogIndexHeader, crc)));
+  if (crc != header.crc)
+  {
+    return false;
+  }
+  _closedCount = header.count;
+  // the active segment follows the last full one
+  uint32_t firstSequence = 0;
+  if (_closedCount > 0)
+  {
+    firstSequence = _closed[_closedCount - 1].firstSequence + _closed[_closedCount - 1].count;
+  }
+  clearInfo(_active, header.activeId, firstSequence);
+  return true;
+}
+
+// Find the segments from the headers of the segment files, and count their records again
+void MeasurementLog::rebuildIndex()
+{
+  LogSegmentHeader headers[LOG_MAX_SEGMENTS + 1];
+  bool found[LOG_MAX_SEGMENTS + 1];
+  uint8_t slots = _maxSegments + 1;
+  bool hasActive = false;
+  uint32_t activeId = 0;
+
+  // the segment with the highest id is the one that was being written
+  for (uint8_t slot = 0; slot < slots; slot++)
+  {
+    char path[16];
+    segmentPath(path, slot);
+    LogSegmentHeader &header = headers[slot];
+    found[slot] = _storage.read(path, 0, &header, sizeof(header)) == sizeof(header) &&
+                  header.magic == LOG_SEGMENT_MAGIC && header.version == LOG_VERSION &&
+                  header.recordSize == sizeof(LogRecord) && header.id % slots == slot &&
+                  header.crc == calculateCrc32(&header, offsetof(LogSegmentHeader, crc));
+    if (found[slot] && (!hasActive || header.id > activeId))
+    {
+      activeId = header.id;
+      hasActive = true;
+    }
+  }
+
+  // the full segments are the ones just before it, oldest first
+  _closedCount = 0;
+  for (uint32_t id = activeId >= _maxSegments ? activeId - _maxSegments : 0; hasActive && id < activeId; id++)
+  {
+    uint8_t slot = id % slots;
+    if (!found[slot] || headers[slot].id != id)
+    {
+      continue;
+    }
+    LogSegmentInfo &info = _closed[_closedCount];
+    clearInfo(info, id, headers[slot].firstSequence);
+    scanSegment(info);
+    if (info.count > 0)
+    {
+      _closedCount++;
+    }
+  }
+  clearInfo(_active, activeId, hasActive ? headers[activeId % slots].firstSequence : 0);
+  saveIndex(activeId);
+}
+
+// Replace the index file with the summaries of the full segments
+bool MeasurementLog::saveIndex(uint32_t activeId)
+{
+  uint8_t buffer[sizeof(LogIndexHeader) + LOG_MAX_SEGMENTS * sizeof(LogSegmentInfo)];
+  LogIndexHeader header;
+  size_t length = _closedCount * sizeof(LogSegmentInfo);
+  header.magic = LOG_INDEX_MAGIC;
+  header.version = LOG_VERSION;
+  header.slots = _maxSegments + 1;
+  header.count = _closedCount;
+  header.activeId = activeId;
+  header.crc = calculateCrc32(_closed, length, calculateCrc32(&header, offsetof(LogIndexHeader, crc)));
+  memcpy(buffer, &header, sizeof(header));
+  memcpy(buffer + sizeof(header), _closed, length);
+  return _storage.write(LOG_INDEX_PATH, buffer, sizeof(header) + length);
+}
+
+// Count the records of the active segment, and go on after the last one
+bool MeasurementLog::resumeSegment()
+{
+  char path[16];
+  LogSegmentHeader header;
+  segmentPath(path, _active.id);
+  bool valid = _storage.read(path, 0, &header, sizeof(header)) == sizeof(header) &&
+               header.magic == LOG_SEGMENT_MAGIC && header.id == _active.id &&
+               header.crc == calculateCrc32(&header, offsetof(LogSegmentHeader, crc));
+  // the file still holds an old segment: the log stopped before the new one was started
+  if (!valid)
+  {
+    return startSegment(_active.id);
+  }
+  _active.firstSequence = header.firstSequence;
+  bool complete = scanSegment(_active);
+  _nextSequence = _active.firstSequence + _active.count;
+  // a record was cut by a power loss: never append after it, the next records would be misaligned
+  if (!complete || _active.count >= _recordsPerSegment)
+  {
+    return rotate();
+  }
+  return true;
+}
+
+// Write the header of a new segment to its file, which drops the segment stored there before
+bool MeasurementLog::startSegment(uint32_t id)
+{
+  char path[16];
+  LogSegmentHeader header;
+  memset(&header, 0, sizeof(header));
+  header.magic = LOG_SEGMENT_MAGIC;
+  header.version = LOG_VERSION;
+  header.recordSize = sizeof(LogRecord);
+  header.id = id;
+  header.firstSequence = _nextSequence;
+  header.crc = calculateCrc32(&header, offsetof(LogSegmentHeader, crc));
+  clearInfo(_active, id, _nextSequence);
+  segmentPath(path, id);
+  return _storage.write(path, &header, sizeof(header));
+}
+
+// Move the active segment to the index, and start the next one in place of the oldest
+bool MeasurementLog::rotate()
+{
+  uint32_t id = _active.id;
+  if (_active.count > 0)
+  {
+    if (_closedCount == _maxSegments && _closedCount > 0)
+    {
+      memmove(_closed, _closed + 1, (_closedCount - 1) * sizeof(LogSegmentInfo));
+      _closedCount--;
+    }
+    if (_closedCount < _maxSegments)
+    {
+      _closed[_closedCount++] = _active;
+    }
+    id++;
+  }
+  // the index is written first: if the power fails in between, begin() starts the new segment again
+  if (!saveIndex(id) || !startSegment(id))
+  {
+    _ready = false;
+    return false;
+  }
+  return true;
+}
+
+// Count the records of a segment and update its summary with the valid ones
+// return true if the file ends with a whole valid record, false if the last write was cut
+bool MeasurementLog::scanSegment(LogSegmentInfo &info)
+{
+  char path[16];
+  LogRecord page[LOG_PAGE_RECORDS];
+  bool lastValid = true;
+  clearInfo(info, info.id, info.firstSequence);
+  segmentPath(path, info.id);
+  size_t fileSize = _storage.size(path);
+  for (;;)
+  {
+    size_t offset = sizeof(LogSegmentHeader) + info.count * sizeof(LogRecord);
+    size_t length = _storage.read(path, offset, page, sizeof(page));
+    size_t n = length / sizeof(LogRecord);
+    for (size_t i = 0; i < n; i++)
+    {
+      // a damaged record keeps its place, so that the following ones are still found
+      lastValid = page[i].crc == recordCrc(page[i]) && page[i].sequence == info.firstSequence + info.count;
+      if (lastValid)
+      {
+        addToInfo(info, page[i]);
+      }
+      info.count++;
+    }
+    if (length < sizeof(page))
+    {
+      return lastValid && offset + length == fileSize && length % sizeof(LogRecord) == 0;
+    }
+  }
+}
+
+// Visit the records of a segment that are in the range, return false if the visitor stopped
+bool MeasurementLog::visitSegment(const LogSegmentInfo &info, uint32_t fromTime, uint32_t toTime, LogVisitor visitor, void *context, size_t &visited)
+{
+  char path[16];
+  LogRecord page[LOG_PAGE_RECORDS];
+  segmentPath(path, info.id);
+  for (uint32_t index = 0; index < info.count; index += LOG_PAGE_RECORDS)
+  {
+    uint32_t n = info.count - index < LOG_PAGE_RECORDS ? info.count - index : LOG_PAGE_RECORDS;
+    size_t offset = sizeof(LogSegmentHeader) + index * sizeof(LogRecord);
+    uint32_t read = _storage.read(path, offset, page, n * sizeof(LogRecord)) / sizeof(LogRecord);
+    for (uint32_t i = 0; i < read; i++)
+    {
+      if (page[i].crc != recordCrc(page[i]) || page[i].sequence != info.firstSequence + index + i)
+      {
+        _corrupted++;
+        continue;
+      }
+      if (page[i].time < fromTime || page[i].time > toTime)
+      {
+        continue;
+      }
+      visited++;
+      if (!visitor(page[i], context))
+      {
+        return false;
+      }
+    }
+    // the file is shorter than the index says: count the rest as lost
+    if (read < n)
+    {
+      _corrupted += info.count - index - read;
+      return true;
+    }
+  }
+  return true;
+}
+
+// Number the record, and write the page when it is full
+bool MeasurementLog::append(const LogRecord &record)
+{
+  if (!_ready)
+  {
+    return false;
+  }
+  LogRecord &buffered = _buffer[_buffered++];
+  buffered = record;
+  buffered.sequence = _nextSequence++;
+  buffered.crc = recordCrc(buffered);
+  if (_buffered == LOG_PAGE_RECORDS || _active.count + _buffered >= _recordsPerSegment)
+  {
+    return flush();
+  }
+  return true;
+}
+
+// Write the buffered records in one append, SPIFFS then rewrites the last page of the file once instead of once per record
+bool MeasurementLog::flush()
+{
+  if (!_ready || _buffered == 0)
+  {
+    return _ready;
+  }
+  char path[16];
+  segmentPath(path, _active.id);
+  bool written = _storage.append(path, _buffer, _buffered * sizeof(LogRecord));
+  if (written)
+  {
+    for (uint8_t i = 0; i < _buffered; i++)
+    {
+      addToInfo(_active, _buffer[i]);
+    }
+    _active.count += _buffered;
+  }
+  _buffered = 0;
+  // after a failed write the end of the file is unknown: continue in the next segment
+  if (!written)
+  {
+    _nextSequence = _active.firstSequence + _active.count;
+    rotate();
+    return false;
+  }
+  if (_active.count >= _recordsPerSegment)
+  {
+    return rotate();
+  }
+  return true;
+}
+
+// Skip the segments out of the range with the index, then read the others page by page
+size_t MeasurementLog::query(uint32_t fromTime, uint32_t toTime, LogVisitor visitor, void *context)
+{
+  size_t visited = 0;
+  _corrupted = 0;
+  for (uint8_t i = 0; i <= _closedCount; i++)
+  {
+    const LogSegmentInfo &info = segment(i);
+    if (info.count == 0 || info.maxTime < fromTime || info.minTime > toTime)
+    {
+      continue;
+    }
+    if (!visitSegment(info, fromTime, toTime, visitor, context, visited))
+    {
+      return visited;
+    }
+  }
+  // the records not written yet are the most recent ones
+  for (uint8_t i = 0; i < _buffered; i++)
+  {
+    if (_buffer[i].time < fromTime || _buffer[i].time > toTime)
+    {
+      continue;
+    }
+    visited++;
+    if (!visitor(_buffer[i], context))
+    {
+      break;
+    }
+  }
+  return visited;
+}
+
+uint32_t MeasurementLog::size() const
+{
+  uint32_t count = _active.count + _buffered;
+  for (uint8_t i = 0; i < _closedCount; i++)
+  {
+    count += _closed[i].count;
+  }
+  return count;
+}
+
+uint32_t MeasurementLog::corrupted() const
+{
+  return _corrupted;
+}
+
+uint8_t MeasurementLog::segmentCount() const
+{
+  return _closedCount + 1;
+}
+
+const LogSegmentInfo &MeasurementLog::segment(uint8_t index) const
+{
+  return index < _closedCount ? _closed[index] : _active;
+}
+
+// The segments are written to a ring of files: /tslog0.bin to /tslogN.bin
+void MeasurementLog::segmentPath(char *path, uint32_t id) const
+{
+  snprintf(path, 16, "/tslog%u.bin", (unsigned)(id % (_maxSegments + 1)));
+}
+
+int16_t logFixed(double value, double scale)
+{
+  if (value <= -333)
+  {
+    return LOG_MISSING;
+  }
+  double fixed = round(value * scale);
+  if (fixed > 32767)
+  {
+    return 32767;
+  }
+  if (fixed < -32767)
+  {
+    return -32767;
+  }
+  return (int16_t)fixed;
+}
+
+double logValue(int16_t fixed, double scale)
+{
+  if (fixed == LOG_MISSING)
+  {
+    return -333;
+  }
+  return fixed / scale;
+}
@@ -0,0 +1,154 @@
+#ifndef MEASUREMENT_LOG_H
+#define MEASUREMENT_LOG_H
+#include <stddef.h>
+#include <stdint.h>
+
+// The log reaches the flash only through a LogStorage: SpiffsLogStorage in spiffs_fkt on the station.
+// Records are stored in the byte order of the CPU: little-endian on the ESP32 as on x86 and ARM hosts.
+
+// Records written by a single append() of the storage
+#define LOG_PAGE_RECORDS 8
+// Upper bound for the number of closed segments kept in memory by the index
+#define LOG_MAX_SEGMENTS 32
+
+// Fixed-point value of a sensor that couldn't be read
+#define LOG_MISSING (-32768)
+
+// Bits of LogRecord::flags
+#define LOG_FLAG_RAINING 0x0001
+#define LOG_FLAG_SEEING_ENABLED 0x0002
+#define LOG_FLAG_SENSOR_ERROR 0x0004
+#define LOG_FLAG_TIME_UNSYNCED 0x0008 // the time is the clock of the station, not UTC
+
+/// @brief One measurement, as stored in the log: 32 bytes, so that a page of LOG_PAGE_RECORDS is one 256-byte write.
+/// The sensor values are fixed point: hundredths of mag/arcsec², of a magnitude, of an arcsecond and of a °C,
+/// whole particles and kilometers for the concentration and the lightning distance, LOG_MISSING if unknown.
+struct LogRecord
+{
+  uint32_t time;     // seconds since the epoch
+  uint32_t sequence; // set by the log, numbers every record ever appended
+  float lux;
+  int16_t sqm;
+  int16_t nelm;
+  int16_t seeing;
+  int16_t objectTemp;
+  int16_t ambientTemp;
+  int16_t concentration;
+  int16_t lightningDistance;
+  uint16_t flags;
+  uint32_t crc; // set by the log, CRC-32 of the fields above
+};
+
+/// @brief Summary of a segment, kept in the index file so that queries can skip the segments they don't need
+struct LogSegmentInfo
+{
+  uint32_t id;            // segments are numbered in the order they are written
+  uint32_t firstSequence; // sequence of the first record of the segment
+  uint32_t count;         // records in the segment, including the damaged ones
+  uint32_t minTime;
+  uint32_t maxTime;
+  int16_t minSqm; // LOG_MISSING if no record of the segment has a SQM value
+  int16_t maxSqm;
+};
+
+/// @brief Files used by the log: SpiffsLogStorage on the station, anything else on a host
+class LogStorage
+{
+public:
+  virtual ~LogStorage() {}
+
+  /// @brief Get the size of a file
+  /// @return the size of the file in bytes, 0 if it doesn't exist
+  virtual size_t size(const char *path) = 0;
+
+  /// @brief Read a part of a file
+  /// @return the number of bytes read
+  virtual size_t read(const char *path, size_t offset, void *buffer, size_t length) = 0;
+
+  /// @brief Write at the end of a file, create it if it doesn't exist
+  /// @return true if all the bytes were written, false otherwise
+  virtual bool append(const char *path, const void *data, size_t length) = 0;
+
+  /// @brief Replace the content of a file as a whole, without leaving it half-written after a power loss
+  /// @return true if all the bytes were written, false otherwise
+  virtual bool write(const char *path, const void *data, size_t length) = 0;
+};
+
+/// @brief Called for every record found by MeasurementLog::query()
+/// @return true to continue, false to stop the query
+typedef bool (*LogVisitor)(const LogRecord &record, void *context);
+
+/// @brief Append-only log of measurements, split in segment files that are recycled oldest first
+class MeasurementLog
+{
+public:
+  /// @param storage the files of the log
+  /// @param recordsPerSegment the number of records after which a new segment is started
+  /// @param maxSegments the number of full segments kept besides the one being written, at most LOG_MAX_SEGMENTS
+  MeasurementLog(LogStorage &storage, uint16_t recordsPerSegment, uint8_t maxSegments);
+
+  /// @brief Load the index and resume writing after the last valid record
+  /// @return true if the log can be written, false otherwise
+  bool begin();
+
+  /// @brief Add a record to the log, the records are written by pages of LOG_PAGE_RECORDS
+  /// @param record the measurement, its sequence and crc are set by the log
+  /// @return true if the record was buffered or written, false otherwise
+  bool append(const LogRecord &record);
+
+  /// @brief Write the buffered records, to call before a reboot or a deep sleep
+  /// @return true if the records were written, false otherwise
+  bool flush();
+
+  /// @brief Visit the valid records between two times, oldest first
+  /// @param fromTime the first time, included
+  /// @param toTime the last time, included
+  /// @return the number of records visited
+  size_t query(uint32_t fromTime, uint32_t toTime, LogVisitor visitor, void *context);
+
+  /// @brief Get the number of records in the log, including the buffered and the damaged ones
+  uint32_t size() const;
+
+  /// @brief Get the number of records skipped by the last query because of a wrong CRC or a short read
+  uint32_t corrupted() const;
+
+  /// @brief Get the number of segments, including the one being written
+  uint8_t segmentCount() const;
+
+  /// @brief Get the summary of a segment, oldest first; the last one is being written
+  const LogSegmentInfo &segment(uint8_t index) const;
+
+private:
+  bool loadIndex();
+  void rebuildIndex();
+  bool saveIndex(uint32_t activeId);
+  bool resumeSegment();
+  bool startSegment(uint32_t id);
+  bool rotate();
+  bool scanSegment(LogSegmentInfo &info);
+  bool visitSegment(const LogSegmentInfo &info, uint32_t fromTime, uint32_t toTime, LogVisitor visitor, void *context, size_t &visited);
+  void segmentPath(char *path, uint32_t id) const;
+
+  LogStorage &_storage;
+  uint16_t _recordsPerSegment;
+  uint8_t _maxSegments;
+  uint8_t _closedCount;
+  uint8_t _buffered;
+  bool _ready;
+  uint32_t _nextSequence;
+  uint32_t _corrupted;
+  LogSegmentInfo _closed[LOG_MAX_SEGMENTS]; // oldest first
+  LogSegmentInfo _active;
+  LogRecord _buffer[LOG_PAGE_RECORDS];
+};
+
+/// @brief Convert a sensor value to the fixed point of a record
+/// @param value the value, -333 or less if the sensor couldn't be read
+/// @param scale 100 for hundredths, 1 for whole units
+/// @return the rounded value, clamped to the range of int16_t, LOG_MISSING for a missing value
+int16_t logFixed(double value, double scale);
+
+/// @brief Convert a fixed-point value of a record back to a sensor value
+/// @return the value, -333 for LOG_MISSING as in the rest of the firmware
+double logValue(int16_t fixed, double scale);
+#endif
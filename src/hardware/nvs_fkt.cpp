@@ -0,0 +1,76 @@
+#include <Arduino.h>
+#include <Preferences.h>
+#include <SPIFFS.h>
+#include <string.h>
+#include "nvs_fkt.h"
+#include "spiffs_fkt.h"
+#include "settings.h"
+
+// NVS namespace and key of the configuration blob
+#define CONFIG_NAMESPACE "sqm"
+#define CONFIG_KEY "config"
+
+// Read the files written by older firmware, save them in NVS and delete them
+static bool migrateConfig(StationConfig &config)
+{
+  if (!initSPIFFS() || !SPIFFS.exists(ssidPath))
+  {
+    return false;
+  }
+  bool hasPass = SPIFFS.exists(passPath);
+  bool hasIp = SPIFFS.exists(ipPath);
+  String ssid = readLineOfFile(SPIFFS, ssidPath);
+  String pass = hasPass ? readLineOfFile(SPIFFS, passPath) : String();
+  String ip = hasIp ? readLineOfFile(SPIFFS, ipPath) : String();
+  // values too long for the configuration keep their files, the access point asks for them again
+  if (!migrateNetworkSettings(config, ssid.c_str(), hasPass ? pass.c_str() : NULL, hasIp ? ip.c_str() : NULL))
+  {
+    return false;
+  }
+  // the files are only deleted once NVS holds their content
+  if (saveConfig(config))
+  {
+    SPIFFS.remove(ssidPath);
+    SPIFFS.remove(passPath);
+    SPIFFS.remove(ipPath);
+  }
+  return true;
+}
+
+// Read the blob in one call, a missing, old or damaged blob counts as no configuration
+bool loadConfig(StationConfig &config)
+{
+  Preferences preferences;
+  bool found = false;
+  if (preferences.begin(CONFIG_NAMESPACE, true))
+  {
+    found = preferences.getBytes(CONFIG_KEY, &config, sizeof(config)) == sizeof(config) && isConfigValid(config);
+    preferences.end();
+  }
+  if (found)
+  {
+    return true;
+  }
+  clearConfig(config);
+  return migrateConfig(config);
+}
+
+// NVS writes the new blob before it erases the old one, a power loss keeps one of them
+bool saveConfig(StationConfig &config)
+{
+  sealConfig(config);
+  Preferences preferences;
+  if (!preferences.begin(CONFIG_NAMESPACE, false))
+  {
+    return false;
+  }
+  // don't wear the flash if nothing changed, e.g. when the server sends the same settings again
+  StationConfig saved;
+  bool ret = preferences.getBytes(CONFIG_KEY, &saved, sizeof(saved)) == sizeof(saved) && memcmp(&saved, &config, sizeof(config)) == 0;
+  if (!ret)
+  {
+    ret = preferences.putBytes(CONFIG_KEY, &config, sizeof(config)) == sizeof(config);
+  }
+  preferences.end();
+  return ret;
+}
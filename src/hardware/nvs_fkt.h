@@ -0,0 +1,14 @@
+#ifndef NVS_FKT_H
+#define NVS_FKT_H
+#include "config_store.h"
+
+/// @brief Load the configuration from NVS in one read; the first time, migrate it from the SPIFFS files of older firmware
+/// @param config the configuration, cleared if there is none
+/// @return true if a configuration was found, false otherwise
+bool loadConfig(StationConfig &config);
+
+/// @brief Save the configuration to NVS in one write, if it changed
+/// @param config the configuration, its version and CRC are set
+/// @return true if the configuration is saved, false otherwise
+bool saveConfig(StationConfig &config);
+#endif
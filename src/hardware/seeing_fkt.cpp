@@ -2,6 +2,7 @@
 #include <settings.h>
 #include <cstdlib>
 #include <hardware\display_and_pins.h>
+#include <sensors/measurement.h>
 
 #define SKYCLEAR 1
 #define SKYPCLOUDY 2
@@ -26,10 +27,10 @@ HardwareSerial SerialPort(2); // use UART2
 // calculate if cloudy/clear sky
 int get_cloud_state(float ambient, float object, double SP1, double SP2)
 {
-  Serial.println("ambient: " + String(ambient));
-  Serial.println("object: " + String(object));
-  Serial.println("SP1: " + String(SP1));
-  Serial.println("SP2: " + String(SP2));
+  Serial.printf("ambient: %.2f\n", ambient);
+  Serial.printf("object: %.2f\n", object);
+  Serial.printf("SP1: %.2f\n", SP1);
+  Serial.printf("SP2: %.2f\n", SP2);
   float TempDiff = ambient - object;
   int CLOUD_STATE = SKYUNKNOWN;
   // determine if clear or cloudy
@@ -71,27 +72,30 @@ bool UART_shutdown_Seeing()
 }
 
 // get Seeing value over UART
-bool UART_get_Seeing(String &seeing)
+bool UART_get_Seeing(int32_t &seeing)
 {
   // initialize the serial port with a baud rate of 9600
   SerialPort.begin(9600, 134217756U, MYPORT_RX, MYPORT_TX, false);
   // Send the "get" command
   SerialPort.println("get");
-  String teststr = "";
   SerialPort.flush();
-  
-  teststr = SerialPort.readString();
-  // trim the string
-  teststr.trim();
+
+  // read the answer line into a fixed buffer, a line that fills it is longer than any seeing value
+  char response[32];
+  size_t length = SerialPort.readBytesUntil('\n', response, sizeof(response));
   SerialPort.end();
-  if (teststr.length() > 2 && teststr.toFloat() > 0)
+  if (length == sizeof(response))
+  {
+    // the start of a longer line could still read as a number
+    return false;
+  }
+  response[length] = 0;
+  // if the answer is a positive number, set seeing
+  if (parseSeeing(response, seeing))
   {
-    // if string is not empty, set seeing
-    seeing = teststr;
-    Serial.println("seeing: " + seeing);
+    Serial.printf("seeing: %s\n", response);
     return true;
   }
-  // check if string is empty
   return false;
 }
 
@@ -100,12 +104,12 @@ void check_seeing_threshhold(int seeing_thr, int &GOOD_SKY_STATE_COUNT, int &BAD
 {
   // check if sensor values are good and if seeing should be enabled
   // good sky state
-  Serial.println("CLOUD_STATE: " + String(CLOUD_STATE));
-  Serial.println("lux: " + String(lux));
-  Serial.println("MAX_LUX: " + String(MAX_LUX));
+  Serial.printf("CLOUD_STATE: %d\n", CLOUD_STATE);
+  Serial.printf("lux: %.2f\n", lux);
+  Serial.printf("MAX_LUX: %.2f\n", MAX_LUX);
   for (int i = 0; i < 5; i++)
   {
-    Serial.println("lastSeeingChecks[" + String(i) + "]: " + String(lastSeeingChecks[i]));
+    Serial.printf("lastSeeingChecks[%d]: %d\n", i, lastSeeingChecks[i]);
   }
   if ((CLOUD_STATE == SKYCLEAR && lux < MAX_LUX))
   {
@@ -184,6 +188,6 @@ void check_seeing_threshhold(int seeing_thr, int &GOOD_SKY_STATE_COUNT, int &BAD
       high_hold_Pin(EN_SEEING);
     }
   }
-  Serial.println("GOOD_SKY_STATE_COUNT: " + String(GOOD_SKY_STATE_COUNT));
-  Serial.println("BAD_SKY_STATE_COUNT: " + String(BAD_SKY_STATE_COUNT));
+  Serial.printf("GOOD_SKY_STATE_COUNT: %d\n", GOOD_SKY_STATE_COUNT);
+  Serial.printf("BAD_SKY_STATE_COUNT: %d\n", BAD_SKY_STATE_COUNT);
 }
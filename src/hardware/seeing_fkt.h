@@ -14,10 +14,10 @@ int get_cloud_state(float ambient, float object, double SP1, double SP2);
 /// @return true if the command was sent successfully, false otherwise
 bool UART_shutdown_Seeing();
 
-/// @brief Send the "see" command over UART to get the current seeing value
-/// @param seeing the current seeing value
+/// @brief Send the "get" command over UART to get the current seeing value
+/// @param seeing the current seeing value, in hundredths of an arcsecond
 /// @return true if the seeing value was received successfully, false otherwise
-bool UART_get_Seeing(String &seeing);
+bool UART_get_Seeing(int32_t &seeing);
 
 /// @brief Check wheter to enable or disable the seeing based on the current sky state
 void check_seeing_threshhold(int seeing_thr, int &GOOD_SKY_STATE_COUNT, int &BAD_SKY_STATE_COUNT, int CLOUD_STATE, float lux, double MAX_LUX, bool &SEEING_ENABLED, int SLEEPTIME_s);
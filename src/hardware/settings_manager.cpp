@@ -0,0 +1,98 @@
+#include "settings_manager.h"
+#include <stddef.h>
+#include <string.h>
+
+uint8_t compareSettings(const StationSettings &current, const StationSettings &fetched)
+{
+  uint8_t changes = 0;
+  if (current.SLEEPTIME_s != fetched.SLEEPTIME_s || current.DISPLAY_TIMEOUT_s != fetched.DISPLAY_TIMEOUT_s)
+  {
+    changes |= SETTINGS_CHANGED_TIMING;
+  }
+  if (current.DISPLAY_ON != fetched.DISPLAY_ON)
+  {
+    changes |= SETTINGS_CHANGED_DISPLAY;
+  }
+  if (current.seeing_thr != fetched.seeing_thr || current.MAX_LUX != fetched.MAX_LUX)
+  {
+    changes |= SETTINGS_CHANGED_SEEING;
+  }
+  if (current.SP1 != fetched.SP1 || current.SP2 != fetched.SP2 || current.SQM_LIMIT != fetched.SQM_LIMIT)
+  {
+    changes |= SETTINGS_CHANGED_SKY;
+  }
+  return changes;
+}
+
+int fetchSettings(SettingsClient &client, SettingsFetchState &state, uint32_t cycle, StationSettings &settings, uint8_t &changes)
+{
+  changes = 0;
+  // The server answers 304 without a body if the settings still have this ETag
+  int status = client.get(state.etag[0] != 0 ? state.etag : NULL);
+
+  int result = FETCH_FAILED;
+  if (status == 304)
+  {
+    result = FETCH_NOT_MODIFIED;
+  }
+  else if (status == 200)
+  {
+    // Start from the current values, so that keys missing from the response keep their value
+    StationSettings fetched = settings;
+
+    // Use the settings only if the whole response was read
+    if (client.readSettings(fetched))
+    {
+      changes = compareSettings(settings, fetched);
+      settings = fetched;
+      // An ETag too long to be kept is dropped, the next fetch is then unconditional
+      const char *etag = client.etag();
+      size_t length = strlen(etag);
+      if (length < sizeof(state.etag))
+      {
+        memcpy(state.etag, etag, length + 1);
+      }
+      else
+      {
+        state.etag[0] = 0;
+      }
+      result = FETCH_UPDATED;
+    }
+  }
+  if (result != FETCH_FAILED)
+  {
+    state.lastFetchCycle = cycle;
+  }
+  return result;
+}
+
+// The cycle counter may wrap around, the difference stays right
+bool isSettingsFetchDue(const SettingsFetchState &state, uint32_t cycle, uint32_t interval)
+{
+  return cycle - state.lastFetchCycle >= interval;
+}
+
+void settingsFromConfig(const StationConfig &config, StationSettings &settings)
+{
+  settings.seeing_thr = config.seeing_thr;
+  settings.SP1 = config.SP1;
+  settings.SP2 = config.SP2;
+  settings.MAX_LUX = config.MAX_LUX;
+  settings.SLEEPTIME_s = config.SLEEPTIME_s;
+  settings.DISPLAY_TIMEOUT_s = config.DISPLAY_TIMEOUT_s;
+  settings.DISPLAY_ON = config.DISPLAY_ON;
+  settings.SQM_LIMIT = config.SQM_LIMIT;
+}
+
+void settingsToConfig(const StationSettings &settings, StationConfig &config)
+{
+  config.seeing_thr = settings.seeing_thr;
+  config.SP1 = settings.SP1;
+  config.SP2 = settings.SP2;
+  config.MAX_LUX = settings.MAX_LUX;
+  config.SLEEPTIME_s = settings.SLEEPTIME_s;
+  config.DISPLAY_TIMEOUT_s = settings.DISPLAY_TIMEOUT_s;
+  config.DISPLAY_ON = settings.DISPLAY_ON;
+  config.SQM_LIMIT = settings.SQM_LIMIT;
+  config.flags |= CONFIG_HAS_SERVER_SETTINGS;
+}
@@ -0,0 +1,87 @@
+#ifndef SETTINGS_MANAGER_H
+#define SETTINGS_MANAGER_H
+#include <stdint.h>
+#include "config_store.h"
+
+// fetchSettings() holds the protocol: If-None-Match with the stored ETag, and the bits of the settings that changed.
+// fetch_settings() in wifi_fkt talks to the server through a SettingsClient.
+
+// Results of fetchSettings()
+#define FETCH_FAILED 0       // no answer, or an answer that couldn't be read
+#define FETCH_NOT_MODIFIED 1 // the server answered 304, the settings are the same
+#define FETCH_UPDATED 2      // the server sent the settings
+
+// Bits returned by compareSettings(), for the parts of the station that use the changed settings
+#define SETTINGS_CHANGED_TIMING 0x01  // SLEEPTIME_s, DISPLAY_TIMEOUT_s
+#define SETTINGS_CHANGED_DISPLAY 0x02 // DISPLAY_ON, the display supply has to be switched
+#define SETTINGS_CHANGED_SEEING 0x04  // seeing_thr, MAX_LUX
+#define SETTINGS_CHANGED_SKY 0x08     // SP1, SP2, SQM_LIMIT
+
+/// @brief Settings sent by the server
+struct StationSettings
+{
+  int seeing_thr;
+  double SP1;
+  double SP2;
+  double MAX_LUX;
+  int SLEEPTIME_s;
+  int DISPLAY_TIMEOUT_s;
+  int DISPLAY_ON;
+  double SQM_LIMIT;
+};
+
+/// @brief State of the conditional fetch of the settings, kept across deep sleep
+struct SettingsFetchState
+{
+  char etag[64];           // ETag of the last settings received, sent back in If-None-Match, empty if none
+  uint32_t lastFetchCycle; // cycle of the last answer of the server
+};
+
+/// @brief The HTTP request for the settings: HTTPClient on the station, anything else on a host
+class SettingsClient
+{
+public:
+  virtual ~SettingsClient() {}
+
+  /// @brief Send the GET request for the settings
+  /// @param ifNoneMatch the ETag to send in If-None-Match, NULL to send none
+  /// @return the HTTP status of the answer, 0 or less if there was no answer
+  virtual int get(const char *ifNoneMatch) = 0;
+
+  /// @brief Get the ETag header of the answer
+  /// @return the ETag, empty if the answer has none
+  virtual const char *etag() = 0;
+
+  /// @brief Read the body of the answer into the settings, the keys missing from the body keep their value
+  /// @return true if the whole body was read, false otherwise
+  virtual bool readSettings(StationSettings &settings) = 0;
+};
+
+/// @brief Fetch the settings, with If-None-Match so that unchanged settings cost an empty answer
+/// @param client the HTTP request
+/// @param state the ETag of the last settings received, updated with the new one, and the cycle of the last answer
+/// @param cycle the current cycle
+/// @param settings the settings in use, replaced by the new settings if the server sent them
+/// @param changes the SETTINGS_CHANGED_ bits of the settings that changed, 0 unless the result is FETCH_UPDATED
+/// @return FETCH_UPDATED if the server sent the settings, FETCH_NOT_MODIFIED if they didn't change, FETCH_FAILED otherwise
+int fetchSettings(SettingsClient &client, SettingsFetchState &state, uint32_t cycle, StationSettings &settings, uint8_t &changes);
+
+/// @brief Find which settings changed
+/// @param current the settings in use
+/// @param fetched the settings sent by the server
+/// @return the SETTINGS_CHANGED_ bits of the changed settings, 0 if none changed
+uint8_t compareSettings(const StationSettings &current, const StationSettings &fetched);
+
+/// @brief Check whether the settings should be fetched again
+/// @param state the state of the fetch
+/// @param cycle the current cycle
+/// @param interval the number of cycles between two fetches
+/// @return true if the last answer is at least interval cycles old, false otherwise
+bool isSettingsFetchDue(const SettingsFetchState &state, uint32_t cycle, uint32_t interval);
+
+/// @brief Copy the server settings saved in the configuration
+void settingsFromConfig(const StationConfig &config, StationSettings &settings);
+
+/// @brief Copy the settings into the configuration, to save them in NVS
+void settingsToConfig(const StationSettings &settings, StationConfig &config);
+#endif
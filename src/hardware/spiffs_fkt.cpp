@@ -1,6 +1,7 @@
 #include <Arduino.h>
 #include "SPIFFS.h"
 #include "FS.h"
+#include "spiffs_fkt.h"
 #include "settings.h"
 
 // Initialize SPIFFS
@@ -57,4 +58,75 @@ bool writeLineOfFile(fs::FS &fs, const char *path, const char *message)
   file.close();
   // return whether the message was written or not
   return ret;
-}
\ No newline at end of file
+}
+
+SpiffsLogStorage::SpiffsLogStorage(fs::FS &fs) : _fs(fs)
+{
+}
+
+// Get the size of the file, 0 if it doesn't exist
+size_t SpiffsLogStorage::size(const char *path)
+{
+  if (!_fs.exists(path))
+  {
+    return 0;
+  }
+  File file = _fs.open(path, FILE_READ);
+  size_t fileSize = file ? file.size() : 0;
+  file.close();
+  return fileSize;
+}
+
+// Read a part of the file, return the number of bytes read
+size_t SpiffsLogStorage::read(const char *path, size_t offset, void *buffer, size_t length)
+{
+  if (!_fs.exists(path))
+  {
+    return 0;
+  }
+  File file = _fs.open(path, FILE_READ);
+  size_t n = 0;
+  if (file && file.seek(offset))
+  {
+    n = file.read((uint8_t *)buffer, length);
+  }
+  file.close();
+  return n;
+}
+
+// Write the data at the end of the file in one call
+bool SpiffsLogStorage::append(const char *path, const void *data, size_t length)
+{
+  File file = _fs.open(path, FILE_APPEND);
+  if (!file)
+  {
+    return false;
+  }
+  bool ret = file.write((const uint8_t *)data, length) == length;
+  file.close();
+  return ret;
+}
+
+// Replace the file through a temporary one, a power loss never leaves it half-written
+bool SpiffsLogStorage::write(const char *path, const void *data, size_t length)
+{
+  String temp = String(path) + ".tmp";
+  File file = _fs.open(temp, FILE_WRITE);
+  if (!file)
+  {
+    return false;
+  }
+  bool ret = file.write((const uint8_t *)data, length) == length;
+  file.close();
+  if (!ret)
+  {
+    _fs.remove(temp);
+    return false;
+  }
+  // SPIFFS can't rename over an existing file
+  if (_fs.exists(path))
+  {
+    _fs.remove(path);
+  }
+  return _fs.rename(temp, path);
+}
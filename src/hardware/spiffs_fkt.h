@@ -1,6 +1,7 @@
 #ifndef SPIFFS_FKT_H
 #define SPIFFS_FKT_H
 #include "FS.h"
+#include "measurement_log.h"
 
 /// @brief Initialize the SPIFFS file system
 /// @return true if the SPIFFS file system was initialized successfully, false otherwise
@@ -17,4 +18,22 @@ String readLineOfFile(fs::FS &fs, const char *path);
 /// @param path the path to the file
 /// @param message the message to write to the file
 bool writeLineOfFile(fs::FS &fs, const char *path, const char *message);
+
+/// @brief Files of the measurement log in the SPIFFS file system
+class SpiffsLogStorage : public LogStorage
+{
+public:
+  /// @param fs the SPIFFS file system, mounted with initSPIFFS()
+  SpiffsLogStorage(fs::FS &fs);
+
+  size_t size(const char *path) override;
+  size_t read(const char *path, size_t offset, void *buffer, size_t length) override;
+  bool append(const char *path, const void *data, size_t length) override;
+
+  /// @brief Write to a temporary file first, then rename it over the old one
+  bool write(const char *path, const void *data, size_t length) override;
+
+private:
+  fs::FS &_fs;
+};
 #endif
\ No newline at end of file
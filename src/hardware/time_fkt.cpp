@@ -0,0 +1,70 @@
+#include <Arduino.h>
+#include <WiFiUdp.h>
+#include <sys/time.h>
+#include "time_fkt.h"
+#include "settings.h"
+
+int64_t readClockUs()
+{
+  struct timeval now;
+  gettimeofday(&now, NULL);
+  return (int64_t)now.tv_sec * 1000000 + now.tv_usec;
+}
+
+static void setClockUs(int64_t clockUs)
+{
+  struct timeval now = {(time_t)(clockUs / 1000000), (suseconds_t)(clockUs % 1000000)};
+  settimeofday(&now, NULL);
+}
+
+bool syncTime(TimeState &state, const char *server, int64_t &stepUs)
+{
+  WiFiUDP udp;
+  uint8_t packet[NTP_PACKET_SIZE];
+  noteTimeSyncAttempt(state, readClockUs());
+  if (!udp.begin(NTP_LOCAL_PORT))
+  {
+    return false;
+  }
+
+  // send the request and wait for the answer
+  int64_t requestUs = readClockUs();
+  buildNtpRequest(packet, requestUs);
+  if (!udp.beginPacket(server, 123) || udp.write(packet, sizeof(packet)) != sizeof(packet) || !udp.endPacket())
+  {
+    udp.stop();
+    return false;
+  }
+  bool answered = false;
+  int64_t answerUs = 0;
+  int64_t offsetUs = 0;
+  int64_t delayUs = 0;
+  while (!answered && readClockUs() - requestUs < NTP_TIMEOUT_ms * 1000LL)
+  {
+    int length = udp.parsePacket();
+    if (length > 0)
+    {
+      answerUs = readClockUs();
+      length = udp.read(packet, sizeof(packet));
+      answered = parseNtpReply(packet, length, requestUs, answerUs, offsetUs, delayUs);
+    }
+    else
+    {
+      delay(1);
+    }
+  }
+  udp.stop();
+  if (!answered)
+  {
+    return false;
+  }
+
+  // set the clock to UTC, the error is at most half of the round trip
+  uint32_t uncertaintyUs = delayUs / 2 < UINT32_MAX ? delayUs / 2 : UINT32_MAX;
+  int64_t clockUs = readClockUs();
+  applyTimeSync(state, clockUs, offsetUs, uncertaintyUs);
+  setClockUs(clockUs + offsetUs);
+  stepUs = offsetUs;
+  Serial.printf("Time synced, offset %lld ms, round trip %lld ms, drift %.1f ppm\n", offsetUs / 1000, delayUs / 1000, state.driftPpm);
+  return true;
+}
@@ -0,0 +1,15 @@
+#ifndef TIME_FKT_H
+#define TIME_FKT_H
+#include "time_service.h"
+
+/// @brief Read the clock of the station, kept by the RTC in deep sleep
+/// @return the clock in µs since the epoch
+int64_t readClockUs();
+
+/// @brief Ask the SNTP server for the time, set the clock and update the drift estimate
+/// @param state the state of the time service
+/// @param server the host name of the SNTP server
+/// @param stepUs how far the clock was set forward, to convert readings taken before the sync
+/// @return true if the clock was synced, false otherwise
+bool syncTime(TimeState &state, const char *server, int64_t &stepUs);
+#endif
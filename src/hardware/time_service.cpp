@@ -0,0 +1,155 @@
+#include "time_service.h"
+#include <math.h>
+#include <string.h>
+
+// Seconds from 1900, the epoch of NTP, to 1970
+#define NTP_UNIX_OFFSET 2208988800ULL
+
+// Error bound of a time read from the clock, elapsed µs after the last sync
+static uint32_t timeUncertaintyMs(const TimeState &state, int64_t elapsedUs)
+{
+  double ppm = (state.flags & TIME_FLAG_DRIFT_KNOWN) ? TIME_DRIFT_RESIDUAL_PPM : TIME_DRIFT_UNKNOWN_PPM;
+  double uncertaintyMs = ceil((state.syncUncertaintyUs + fabs((double)elapsedUs) * ppm * 1e-6) / 1000);
+  return uncertaintyMs < UINT32_MAX ? (uint32_t)uncertaintyMs : UINT32_MAX;
+}
+
+void clearTimeState(TimeState &state)
+{
+  memset(&state, 0, sizeof(state));
+}
+
+bool isTimeSyncDue(const TimeState &state, int64_t clockUs, uint32_t intervalS, uint32_t maxUncertaintyMs, uint32_t retryS)
+{
+  // at most one round trip per retry time, also while the server can't be reached
+  if ((state.flags & TIME_FLAG_ATTEMPTED) && clockUs >= state.lastAttemptUs && clockUs - state.lastAttemptUs < (int64_t)retryS * 1000000)
+  {
+    return false;
+  }
+  if (!(state.flags & TIME_FLAG_SYNCED))
+  {
+    return true;
+  }
+  // a clock that went back was set by something else
+  int64_t elapsedUs = clockUs - state.anchorUs;
+  return elapsedUs < 0 || elapsedUs >= (int64_t)intervalS * 1000000 || timeUncertaintyMs(state, elapsedUs) > maxUncertaintyMs;
+}
+
+void noteTimeSyncAttempt(TimeState &state, int64_t clockUs)
+{
+  state.flags |= TIME_FLAG_ATTEMPTED;
+  state.lastAttemptUs = clockUs;
+}
+
+void applyTimeSync(TimeState &state, int64_t clockUs, int64_t offsetUs, uint32_t uncertaintyUs)
+{
+  // the clock ran free since it was set to UTC at the anchor, so the offset is all drift
+  int64_t elapsedUs = clockUs - state.anchorUs;
+  if ((state.flags & TIME_FLAG_SYNCED) && elapsedUs >= (int64_t)TIME_DRIFT_MIN_INTERVAL_s * 1000000)
+  {
+    double observedPpm = (double)offsetUs / elapsedUs * 1e6;
+    // the errors of both syncs have to be small against the drift
+    double errorPpm = ((double)state.syncUncertaintyUs + uncertaintyUs) / elapsedUs * 1e6;
+    if (fabs(observedPpm) <= TIME_DRIFT_LIMIT_PPM && errorPpm <= TIME_DRIFT_RESIDUAL_PPM)
+    {
+      if (state.flags & TIME_FLAG_DRIFT_KNOWN)
+      {
+        // the drift changes slowly with the temperature, average it over a few syncs
+        state.driftPpm += (observedPpm - state.driftPpm) / 4;
+      }
+      else
+      {
+        state.driftPpm = observedPpm;
+        state.flags |= TIME_FLAG_DRIFT_KNOWN;
+      }
+    }
+  }
+  state.anchorUs = clockUs + offsetUs;
+  state.syncUncertaintyUs = uncertaintyUs;
+  state.flags |= TIME_FLAG_SYNCED;
+  noteTimeSyncAttempt(state, state.anchorUs);
+}
+
+uint8_t stampTime(const TimeState &state, int64_t clockUs, int64_t &utcUs, uint32_t &uncertaintyMs)
+{
+  if (!(state.flags & TIME_FLAG_SYNCED))
+  {
+    utcUs = clockUs;
+    uncertaintyMs = UINT32_MAX;
+    return TIME_QUALITY_NONE;
+  }
+  int64_t elapsedUs = clockUs - state.anchorUs;
+  uncertaintyMs = timeUncertaintyMs(state, elapsedUs);
+  if (!(state.flags & TIME_FLAG_DRIFT_KNOWN))
+  {
+    utcUs = clockUs;
+    return TIME_QUALITY_SYNCED;
+  }
+  utcUs = clockUs + (int64_t)llround(elapsedUs * (double)state.driftPpm * 1e-6);
+  return TIME_QUALITY_CORRECTED;
+}
+
+// NTP time stamps are big-endian seconds since 1900 and fractions of 2^-32 seconds
+static void writeNtpTime(uint8_t *p, int64_t unixUs)
+{
+  uint32_t seconds = (uint32_t)(unixUs / 1000000 + NTP_UNIX_OFFSET);
+  uint32_t fraction = (uint32_t)(((uint64_t)(unixUs % 1000000) << 32) / 1000000);
+  for (int i = 0; i < 4; i++)
+  {
+    p[i] = seconds >> (24 - 8 * i);
+    p[4 + i] = fraction >> (24 - 8 * i);
+  }
+}
+
+static int64_t readNtpTime(const uint8_t *p)
+{
+  uint32_t seconds = (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+  uint32_t fraction = (uint32_t)p[4] << 24 | (uint32_t)p[5] << 16 | (uint32_t)p[6] << 8 | p[7];
+  // the seconds wrap in 2036, a time in the first half of the range is after the wrap
+  uint64_t ntpSeconds = seconds < 0x80000000UL ? seconds + 0x100000000ULL : seconds;
+  return (int64_t)(ntpSeconds - NTP_UNIX_OFFSET) * 1000000 + (int64_t)(((uint64_t)fraction * 1000000) >> 32);
+}
+
+void buildNtpRequest(uint8_t *packet, int64_t clockUs)
+{
+  memset(packet, 0, NTP_PACKET_SIZE);
+  packet[0] = 0x23; // no leap second warning, version 4, client
+  writeNtpTime(packet + 40, clockUs);
+}
+
+bool parseNtpReply(const uint8_t *packet, size_t length, int64_t requestUs, int64_t answerUs, int64_t &offsetUs, int64_t &delayUs)
+{
+  if (length < NTP_PACKET_SIZE)
+  {
+    return false;
+  }
+  // a server answer from a synchronized server, stratum 0 is a kiss-o'-death
+  uint8_t leap = packet[0] >> 6;
+  uint8_t mode = packet[0] & 0x07;
+  uint8_t stratum = packet[1];
+  if (mode != 4 || leap == 3 || stratum == 0 || stratum > 15)
+  {
+    return false;
+  }
+  // the server sends the transmit time of the request back, an answer to another request has another one
+  uint8_t origin[8];
+  writeNtpTime(origin, requestUs);
+  if (memcmp(packet + 24, origin, sizeof(origin)) != 0)
+  {
+    return false;
+  }
+  // a server that doesn't know the time leaves its transmit time at zero
+  static const uint8_t zero[8] = {0};
+  if (memcmp(packet + 40, zero, sizeof(zero)) == 0)
+  {
+    return false;
+  }
+  int64_t receivedUs = readNtpTime(packet + 32);
+  int64_t transmittedUs = readNtpTime(packet + 40);
+  offsetUs = ((receivedUs - requestUs) + (transmittedUs - answerUs)) / 2;
+  delayUs = (answerUs - requestUs) - (transmittedUs - receivedUs);
+  if (delayUs < 0)
+  {
+    delayUs = 0;
+  }
+  return true;
+}
@@ -0,0 +1,89 @@
+#ifndef TIME_SERVICE_H
+#define TIME_SERVICE_H
+#include <stddef.h>
+#include <stdint.h>
+
+// time_fkt reads and sets the clock of the station and asks the SNTP server.
+// The clock is the system time of the ESP32: it is set to UTC at each sync and keeps running in deep sleep on the RTC,
+// between two syncs it drifts. The drift is estimated from the offsets measured by the syncs and corrected in the stamps.
+
+// Quality of a time stamp
+#define TIME_QUALITY_NONE 0      // no sync since the power-on, the time is the clock, not UTC
+#define TIME_QUALITY_SYNCED 1    // UTC, from the clock since the last sync, the drift isn't known yet
+#define TIME_QUALITY_CORRECTED 2 // UTC, from the clock since the last sync, corrected with the estimated drift
+
+// Bound of the drift of the clock before it is estimated, and of the error of the estimate
+#define TIME_DRIFT_UNKNOWN_PPM 500
+#define TIME_DRIFT_RESIDUAL_PPM 50
+// Shortest time between two syncs that estimates the drift: the error of a sync is tens of ms
+#define TIME_DRIFT_MIN_INTERVAL_s 1800
+// A larger drift means that the clock was set by something else, it isn't used for the estimate
+#define TIME_DRIFT_LIMIT_PPM 5000
+
+// Bits of TimeState::flags
+#define TIME_FLAG_SYNCED 0x0001
+#define TIME_FLAG_DRIFT_KNOWN 0x0002
+#define TIME_FLAG_ATTEMPTED 0x0004
+
+// Size of an SNTP request and answer
+#define NTP_PACKET_SIZE 48
+
+/// @brief What the time service knows about the clock, kept in RTC memory across deep sleep
+struct TimeState
+{
+  uint32_t flags;
+  uint32_t syncUncertaintyUs; // error bound of the last sync, half of its round trip
+  int64_t anchorUs;           // clock, set to UTC, at the last sync, in µs since the epoch
+  int64_t lastAttemptUs;      // clock at the last sync, successful or not
+  float driftPpm;             // correction of the clock since the anchor: UTC runs (1 + drift) times as fast
+};
+
+/// @brief Forget the syncs: the next time stamps are TIME_QUALITY_NONE
+/// @param state the state
+void clearTimeState(TimeState &state);
+
+/// @brief Check if the clock should be synced: never synced, too uncertain or too old, but not twice within the retry time
+/// @param state the state
+/// @param clockUs the clock now
+/// @param intervalS the longest time between two syncs
+/// @param maxUncertaintyMs the uncertainty that makes a sync due before the interval
+/// @param retryS the shortest time between two attempts, also after a failed one
+/// @return true if a sync is due, false otherwise
+bool isTimeSyncDue(const TimeState &state, int64_t clockUs, uint32_t intervalS, uint32_t maxUncertaintyMs, uint32_t retryS);
+
+/// @brief Remember a sync attempt, for the retry time of isTimeSyncDue()
+/// @param state the state
+/// @param clockUs the clock when the attempt was made
+void noteTimeSyncAttempt(TimeState &state, int64_t clockUs);
+
+/// @brief Use the offset measured by a sync: estimate the drift since the last sync and move the anchor.
+/// The clock has to be set to clockUs + offsetUs by the caller.
+/// @param state the state
+/// @param clockUs the clock when the offset was measured
+/// @param offsetUs UTC minus the clock
+/// @param uncertaintyUs error bound of the offset
+void applyTimeSync(TimeState &state, int64_t clockUs, int64_t offsetUs, uint32_t uncertaintyUs);
+
+/// @brief Convert a reading of the clock to UTC
+/// @param state the state
+/// @param clockUs the clock, when the measurement was made
+/// @param utcUs the time in µs since the epoch, the clock itself if the quality is TIME_QUALITY_NONE
+/// @param uncertaintyMs error bound of the time, UINT32_MAX if the quality is TIME_QUALITY_NONE
+/// @return the quality of the time, TIME_QUALITY_
+uint8_t stampTime(const TimeState &state, int64_t clockUs, int64_t &utcUs, uint32_t &uncertaintyMs);
+
+/// @brief Write an SNTP client request
+/// @param packet the request, NTP_PACKET_SIZE bytes
+/// @param clockUs the clock when the request is sent, the server sends it back
+void buildNtpRequest(uint8_t *packet, int64_t clockUs);
+
+/// @brief Read the answer of an SNTP server
+/// @param packet the answer
+/// @param length the length of the answer
+/// @param requestUs the clock when the request was sent, as in buildNtpRequest()
+/// @param answerUs the clock when the answer was received
+/// @param offsetUs UTC minus the clock
+/// @param delayUs the round trip, without the time spent by the server
+/// @return true if the answer is a valid answer to the request, false otherwise
+bool parseNtpReply(const uint8_t *packet, size_t length, int64_t requestUs, int64_t answerUs, int64_t &offsetUs, int64_t &delayUs);
+#endif
@@ -1,11 +1,11 @@
 #include <Arduino.h>
 #include "spiffs_fkt.h"
+#include "nvs_fkt.h"
 #include <WiFi.h>
 #include <HTTPClient.h>
 #include <ESPAsyncWebServer.h>
 #include <AsyncTCP.h>
 #include <SPIFFS.h>
-#include <sstream>
 #include "settings.h"
 #include <ArduinoJson.h>
 
@@ -46,9 +46,10 @@ void activate_access_point()
     // Get the parameters from the HTML form
     int params = request->params();
 
-    char WIFI_SSID[100];
-    char WIFI_PASS[100];
-    char SERVER_IP[100];
+    // Start from the saved configuration, so that the server settings are kept
+    StationConfig config;
+    loadConfig(config);
+    bool fits = true;
     
     // Loop through the parameters
     for (int i = 0; i < params; i++) {
@@ -57,28 +58,30 @@ void activate_access_point()
         // Handle the HTTP POST for the SSID parameter
         if (p->name() == "ssid") {
           // WIFI_SSID = on  website entered SSID
-          (p->value()).toCharArray(WIFI_SSID, 100);
-          // Write the SSID to a file for persistence
-          if (!writeLineOfFile(SPIFFS, ssidPath, WIFI_SSID)) {
-            Serial.println("Couldn't write");
-          }
+          fits = setConfigString(config.WIFI_SSID, sizeof(config.WIFI_SSID), p->value().c_str()) && fits;
         }
         // Handle the HTTP POST for the password parameter
         if (p->name() == "pass") {
-          (p->value()).toCharArray(WIFI_PASS, 100);
-          // Write the password to a file for persistence
-          writeLineOfFile(SPIFFS, passPath, WIFI_PASS);
+          fits = setConfigString(config.WIFI_PASS, sizeof(config.WIFI_PASS), p->value().c_str()) && fits;
         }
         // Handle the HTTP POST for the IP address parameter
         if (p->name() == "ip") {
-          (p->value()).toCharArray(SERVER_IP, 100);
-          // Write the IP address to a file for persistence
-          writeLineOfFile(SPIFFS, ipPath, SERVER_IP);
+          fits = setConfigString(config.SERVER_IP, sizeof(config.SERVER_IP), p->value().c_str()) && fits;
         }
       }
     }
+    // A value cut to fit would be another network or another server: ask for it again instead
+    if (!fits) {
+      request->send(400, "text/plain", "Too long: the SSID takes up to 32 characters, the password 64 and the IP address 99");
+      return;
+    }
+    // Save all the settings at once for persistence
+    config.flags |= CONFIG_HAS_WIFI;
+    if (!saveConfig(config)) {
+      Serial.println("Couldn't write");
+    }
     // Send a confirmation message and restart the ESP
-    request->send(200, "text/plain", "Done. ESP will restart, connect to your router " + String(WIFI_SSID) + " and go to IP address: " + SERVER_IP);
+    request->send(200, "text/plain", "Done. ESP will restart, connect to your router " + String(config.WIFI_SSID) + " and go to IP address: " + config.SERVER_IP);
     delay(100);
     ESP.restart(); });
 
@@ -101,129 +104,109 @@ void activate_access_point()
   //esp_deep_sleep(-77777777);
 }
 
-bool getSavedWifiSettings(char *WIFI_SSID, char *WIFI_PASS, char *SERVER_IP, char *SEND_VALUES_SERVER, char *FETCH_SETTINGS_SERVER)
+bool getSavedWifiSettings(StationConfig &config, char *SEND_VALUES_SERVER, char *FETCH_SETTINGS_SERVER)
 {
-  if (!initSPIFFS())
-  {
-    return false;
-  }
-
-  // Load values saved in SPIFFS
-  String temp;
-  // Load SSID
-  if (SPIFFS.exists(ssidPath))
-  {
-    temp = readLineOfFile(SPIFFS, ssidPath);
-    temp.toCharArray(WIFI_SSID, 100);
-  }
-  // Load password
-  if (SPIFFS.exists(passPath))
-  {
-    temp = readLineOfFile(SPIFFS, passPath);
-    temp.toCharArray(WIFI_PASS, 100);
-  }
-  // Load IP address
-  if (SPIFFS.exists(ipPath))
-  {
-    temp = readLineOfFile(SPIFFS, ipPath);
-    temp.toCharArray(SERVER_IP, 100);
-  }
+  // Load the configuration from NVS, from the SPIFFS files of older firmware the first time
+  bool loaded = loadConfig(config);
 
   // Construct URLs for posting sensor values and fetching settings
-  ("http://" + String(SERVER_IP) + ":" + String(serverPort) + "/SQM").toCharArray(SEND_VALUES_SERVER, 100);
-  ("http://" + String(SERVER_IP) + ":" + String(serverPort) + "/getsettings").toCharArray(FETCH_SETTINGS_SERVER, 100);
+  snprintf(SEND_VALUES_SERVER, SERVER_URL_SIZE, "http://%s:%s/SQM", config.SERVER_IP, serverPort);
+  snprintf(FETCH_SETTINGS_SERVER, SERVER_URL_SIZE, "http://%s:%s/getsettings", config.SERVER_IP, serverPort);
 
-  SPIFFS.end();
-  return true;
+  return loaded;
 }
 
-// Function to fetch settings from a server
-bool fetch_settings(char *FETCH_SETTINGS_SERVER, int &seeing_thr, double &SP1, double &SP2, double &MAX_LUX, int &SLEEPTIME_s, int &DISPLAY_TIMEOUT_s, int &DISPLAY_ON, double &SQM_LIMIT)
+// Each member of the settings is bound to a key of the JSON response
+static const JsonField<StationSettings> serverSettingsFields[] = {
+    JsonField<StationSettings>("seeing_thr", &StationSettings::seeing_thr),
+    JsonField<StationSettings>("setpoint1", &StationSettings::SP1),
+    JsonField<StationSettings>("setpoint2", &StationSettings::SP2),
+    JsonField<StationSettings>("max_lux", &StationSettings::MAX_LUX),
+    JsonField<StationSettings>("SLEEPTIME_s", &StationSettings::SLEEPTIME_s),
+    JsonField<StationSettings>("DISPLAY_TIMEOUT_s", &StationSettings::DISPLAY_TIMEOUT_s),
+    JsonField<StationSettings>("DISPLAY_ON", &StationSettings::DISPLAY_ON),
+    JsonField<StationSettings>("set_sqm_limit", &StationSettings::SQM_LIMIT),
+};
+
+// The request for the settings, with HTTPClient
+class HttpSettingsClient : public SettingsClient
 {
-  // Create client object for communication
-  WiFiClient client;
-
-  // Create HTTP client object
-  HTTPClient http;
+public:
+  HttpSettingsClient(const char *url) : _url(url) {}
 
-  // Send request to the server
-  http.useHTTP10(true);
-  http.begin(client, FETCH_SETTINGS_SERVER);
-  int httpResponseCode = http.GET();
+  // Disconnect
+  ~HttpSettingsClient() { _http.end(); }
 
-  // Check if the request was successful
-  if (httpResponseCode == 200)
+  int get(const char *ifNoneMatch)
   {
-    // Parse the JSON response from the server
-    DynamicJsonDocument doc(2048);
-    deserializeJson(doc, http.getStream());
-    // Read values from the JSON document
-    // The code checks if the key exists before trying to read its value
-    // This ensures that the code does not crash if the key is not present in the JSON document
-
-    // Read values
-    if (doc.containsKey("seeing_thr"))
-    {
-      seeing_thr = doc["seeing_thr"].as<int>();
-    }
-    if (doc.containsKey("setpoint1"))
-    {
-      SP1 = doc["setpoint1"].as<double>();
-    }
-    if (doc.containsKey("setpoint2"))
-    {
-      SP2 = doc["setpoint2"].as<double>();
-    }
-    if (doc.containsKey("max_lux"))
+    // Keep the ETag of the response, to send it back next time
+    const char *headerKeys[] = {"ETag"};
+
+    // Send request to the server
+    _http.useHTTP10(true);
+    _http.begin(_client, _url);
+    _http.collectHeaders(headerKeys, 1);
+    if (ifNoneMatch != NULL)
     {
-      MAX_LUX = doc["max_lux"].as<double>();
-    }
-    if (doc.containsKey("SLEEPTIME_s"))
-    {
-      SLEEPTIME_s = doc["SLEEPTIME_s"].as<int>();
-    }
-    if (doc.containsKey("DISPLAY_TIMEOUT_s"))
-    {
-      DISPLAY_TIMEOUT_s = doc["DISPLAY_TIMEOUT_s"].as<int>();
-    }
-    if (doc.containsKey("DISPLAY_ON"))
-    {
-      DISPLAY_ON = doc["DISPLAY_ON"].as<int>();
-    }
-    if (doc.containsKey("set_sqm_limit"))
-    {
-      SQM_LIMIT = doc["set_sqm_limit"].as<double>();
+      _http.addHeader("If-None-Match", ifNoneMatch);
     }
+    return _http.GET();
   }
-  // Disconnect
-  http.end();
-  return httpResponseCode == 200;
+
+  const char *etag()
+  {
+    _etag = _http.header("ETag");
+    return _etag.c_str();
+  }
+
+  bool readSettings(StationSettings &settings)
+  {
+    // Parse the JSON response straight into the struct
+    // Unknown keys are skipped, no JsonDocument is allocated
+    // With a Content-Length, the body is read by blocks instead of byte by byte
+    DeserializationError error;
+    int contentLength = _http.getSize();
+    if (contentLength > 0)
+      error = deserializeJson(settings, serverSettingsFields, _http.getStream(), (size_t)contentLength);
+    else
+      error = deserializeJson(settings, serverSettingsFields, _http.getStream());
+    return !error;
+  }
+
+private:
+  const char *_url;
+  WiFiClient _client;
+  HTTPClient _http;
+  String _etag;
+};
+
+// Function to fetch settings from a server, only if they changed since the last fetch
+int fetch_settings(char *FETCH_SETTINGS_SERVER, SettingsFetchState &state, uint32_t cycle, StationSettings &settings, uint8_t &changes)
+{
+  HttpSettingsClient client(FETCH_SETTINGS_SERVER);
+  return fetchSettings(client, state, cycle, settings, changes);
 }
 
 // send the sensor values via http post request to the server
-bool post_data(char *SEND_VALUES_SERVER, bool raining, float luminosity, String seeing, double nelm, int concentration, float object, float ambient, double lux, int lightning_distanceToStorm, std::vector<String> sensorErrors, bool SEEING_ENABLED)
+bool post_data(char *SEND_VALUES_SERVER, const Measurement &measurement, const HeapSummary *heap)
 {
 
   WiFiClient client;
   HTTPClient http;
 
-  std::stringstream data;
-
-  String errors = "";
-  for (int i = 0; i < sensorErrors.size(); i++)
+  // create a json string, in a buffer that is reused every cycle
+  static char sensor_data[MEASUREMENT_JSON_SIZE];
+  size_t length = encodeMeasurement(measurement, sensor_data, sizeof(sensor_data), heap);
+  if (length == 0)
   {
-    errors = errors + sensorErrors[i] + ", ";
+    return false;
   }
-  // create a json string
-  String sensor_data = "{\"raining\":\"" + String(raining) + "\",\"luminosity\":\"" + luminosity + "\",\"seeing\":\"" + seeing + "\",\"nelm\":\"" + nelm +
-                       "\",\"concentration\":\"" + concentration + "\",\"object\":\"" + object + "\",\"ambient\":\"" + ambient + "\",\"lux\":\"" + lux +
-                       "\",\"lightning_distanceToStorm\":\"" + lightning_distanceToStorm + "\",\"errors\":\"" + errors + "\",\"isSeeing\":\"" + SEEING_ENABLED + "\"}";
   // Start the HTTP connection
   http.begin(client, SEND_VALUES_SERVER);
   http.addHeader("Content-Type", "application/json");
 
   // Send the JSON string as the HTTP body
-  int httpResponseCode = http.POST(sensor_data);
+  int httpResponseCode = http.POST((uint8_t *)sensor_data, length);
   http.end(); // End the connection
 
   // Return true if the post request is successful
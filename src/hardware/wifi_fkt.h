@@ -1,44 +1,33 @@
 #ifndef WIFI_FKT_H
 #define WIFI_FKT_H
 #include <Arduino.h>
+#include "config_store.h"
+#include "settings_manager.h"
+#include "sensors/measurement.h"
 
 /// @brief Send the sensor data to the server
 /// @param SEND_VALUES_SERVER the server ip route to send the data to
-/// @param raining 
-/// @param luminosity 
-/// @param seeing 
-/// @param nelm 
-/// @param concentration 
-/// @param object 
-/// @param ambient 
-/// @param lux 
-/// @param lightning_distanceToStorm 
-/// @param sensorErrors 
-/// @param SEEING_ENABLED 
+/// @param measurement the values of the current cycle
+/// @param heap the heap summary to send along, NULL if it isn't due
 /// @return true if the data was sent successfully, false otherwise
-bool post_data(char *SEND_VALUES_SERVER, bool raining, float luminosity, String seeing, double nelm, int concentration, float object, float ambient, double lux, int lightning_distanceToStorm, std::vector<String> sensorErrors, bool SEEING_ENABLED);
+bool post_data(char *SEND_VALUES_SERVER, const Measurement &measurement, const HeapSummary *heap = NULL);
 
-/// @brief Fetch the settings from the server
+/// @brief Fetch the settings from the server, with If-None-Match so that unchanged settings cost an empty answer
 /// @param FETCH_SETTINGS_SERVER the server ip route to fetch the settings from
-/// @param seeing_thr
-/// @param SP1
-/// @param SP2
-/// @param MAX_LUX
-/// @param SLEEPTIME_s
-/// @param DISPLAY_TIMEOUT_s
-/// @param DISPLAY_ON
-/// @param SQM_LIMIT
-/// @return true if the settings were fetched successfully, false otherwise
-bool fetch_settings(char *FETCH_SETTINGS_SERVER, int &seeing_thr, double &SP1, double &SP2, double &MAX_LUX, int &SLEEPTIME_s, int &DISPLAY_TIMEOUT_s, int &DISPLAY_ON, double &SQM_LIMIT);
+/// @param state the ETag of the last settings received, updated with the new one, and the cycle of the last answer
+/// @param cycle the current cycle
+/// @param settings the settings in use, replaced by the new settings if the server sent them
+/// @param changes the SETTINGS_CHANGED_ bits of the settings that changed, 0 unless the result is FETCH_UPDATED
+/// @return FETCH_UPDATED if the server sent the settings, FETCH_NOT_MODIFIED if they didn't change, FETCH_FAILED otherwise
+int fetch_settings(char *FETCH_SETTINGS_SERVER, SettingsFetchState &state, uint32_t cycle, StationSettings &settings, uint8_t &changes);
 
-/// @brief Read the saved wifi settings from the SPIFFS file system
-/// @param WIFI_SSID the wifi ssid
-/// @param WIFI_PASS the wifi password
-/// @param SERVER_IP the server ip
-/// @param SEND_VALUES_SERVER the server ip route to send the data to
-/// @param FETCH_SETTINGS_SERVER the server ip route to fetch the settings from
-bool getSavedWifiSettings(char *WIFI_SSID, char *WIFI_PASS, char *SERVER_IP, char *SEND_VALUES_SERVER, char *FETCH_SETTINGS_SERVER);
+/// @brief Read the saved configuration from NVS
+/// @param config the configuration, with the wifi settings and the last settings fetched from the server
+/// @param SEND_VALUES_SERVER the server ip route to send the data to, SERVER_URL_SIZE bytes
+/// @param FETCH_SETTINGS_SERVER the server ip route to fetch the settings from, SERVER_URL_SIZE bytes
+/// @return true if a configuration was found, false otherwise
+bool getSavedWifiSettings(StationConfig &config, char *SEND_VALUES_SERVER, char *FETCH_SETTINGS_SERVER);
 
-/// @brief activate the access point and save the obtained wifi settings to the SPIFFS file system
+/// @brief activate the access point and save the obtained wifi settings to NVS
 void activate_access_point();
 #endif
\ No newline at end of file
@@ -9,10 +9,10 @@
  */
 
 #include <Arduino.h>
-#include <vector>
 #include "settings.h"
 #include <Wire.h>
 #include <WiFi.h>
+#include <SPIFFS.h>
 
 #include "FreqCountESP.h"
 
@@ -22,10 +22,17 @@
 #include "sensors/sensor_dust.h"
 #include "sensors/sensor_rain.h"
 #include "sensors/sensor_SQM.h"
+#include "sensors/measurement.h"
 
 #include "hardware/wifi_fkt.h"
 #include "hardware/seeing_fkt.h"
 #include "hardware/display_and_pins.h"
+#include "hardware/spiffs_fkt.h"
+#include "hardware/nvs_fkt.h"
+#include "hardware/settings_manager.h"
+#include "hardware/measurement_log.h"
+#include "hardware/heap_fkt.h"
+#include "hardware/time_fkt.h"
 
 using namespace std;
 
@@ -49,29 +56,68 @@ RTC_DATA_ATTR int SLEEPTIME_s = 10, NO_WIFI_MAX_RETRIES = 25, DISPLAY_TIMEOUT_s
 RTC_DATA_ATTR double SQM_LIMIT = 21, SP1 = 20, SP2 = 22, MAX_LUX = 50;
 RTC_DATA_ATTR bool SEEING_ENABLED = false;
 
-// sensor values
-bool raining = false;
-float ambient = -333; // TQ
-float object = -333;  // HT
-double lux = -333;    // Resulting lux value
-int lightning_distanceToStorm = -333;
-float luminosity = -333; // the SQM value, sky magnitude
-String seeing = "-333";
-double nelm = -333; // NE
-int concentration = -333;
-vector<String> sensorErrors;
+// sensor values of the current cycle, and the errors of the sensor initialization
+Measurement measurement;
+uint16_t initErrors = 0;
 
 // Sky state indicators
 RTC_DATA_ATTR int CLOUD_STATE = -333;
 RTC_DATA_ATTR int BAD_SKY_STATE_COUNT = 0;
 RTC_DATA_ATTR int GOOD_SKY_STATE_COUNT = 0;
 
-// across deepsleep stored connection settings
-RTC_DATA_ATTR char WIFI_SSID[100] = "";
-RTC_DATA_ATTR char WIFI_PASS[100] = "";
-RTC_DATA_ATTR char SERVER_IP[100] = "";
-RTC_DATA_ATTR char SEND_VALUES_SERVER[100] = "";
-RTC_DATA_ATTR char FETCH_SETTINGS_SERVER[100] = "";
+// across deepsleep stored connection settings, loaded from NVS at cold boot
+RTC_DATA_ATTR StationConfig stationConfig;
+RTC_DATA_ATTR char SEND_VALUES_SERVER[SERVER_URL_SIZE] = "";
+RTC_DATA_ATTR char FETCH_SETTINGS_SERVER[SERVER_URL_SIZE] = "";
+RTC_DATA_ATTR SettingsFetchState settingsFetch;
+// anchor and drift of the clock, the clock itself keeps running on the RTC in deep sleep
+RTC_DATA_ATTR TimeState timeState;
+
+// local history of the measurements, also kept when they can't be sent
+SpiffsLogStorage logStorage(SPIFFS);
+MeasurementLog measurementLog(logStorage, LOG_RECORDS_PER_SEGMENT, LOG_SEGMENTS);
+bool hasLog = false;
+
+// free heap, largest free block and task stacks of the last cycles, to spot a leak before it crashes the station
+HeapHistory heapHistory;
+static_assert(HEAP_HISTORY_SIZE >= HEAP_REPORT_CYCLES, "a heap report must cover every cycle since the previous one");
+
+// Settings last sent by the server, or the defaults above if the server never sent any
+static StationSettings lastServerSettings()
+{
+  StationSettings settings = {seeing_thr, SP1, SP2, MAX_LUX, SLEEPTIME_s, DISPLAY_TIMEOUT_s, DISPLAY_ON, SQM_LIMIT};
+  if (stationConfig.flags & CONFIG_HAS_SERVER_SETTINGS)
+  {
+    settingsFromConfig(stationConfig, settings);
+  }
+  return settings;
+}
+
+// Use new settings in place, without a reboot
+static void applySettings(const StationSettings &settings, uint8_t changes)
+{
+  // the other settings are read at every cycle, nothing has to be set up again for them
+  seeing_thr = settings.seeing_thr;
+  SP1 = settings.SP1;
+  SP2 = settings.SP2;
+  MAX_LUX = settings.MAX_LUX;
+  SLEEPTIME_s = settings.SLEEPTIME_s;
+  DISPLAY_TIMEOUT_s = settings.DISPLAY_TIMEOUT_s;
+  SQM_LIMIT = settings.SQM_LIMIT;
+  // DISPLAY_ON is also cleared by the display timeout: only a new value from the server switches the display
+  if (changes & SETTINGS_CHANGED_DISPLAY)
+  {
+    DISPLAY_ON = settings.DISPLAY_ON;
+    if (DISPLAY_ON)
+    {
+      high_hold_Pin(EN_Display);
+    }
+    else
+    {
+      low_hold_Pin(EN_Display);
+    }
+  }
+}
 
 void setup()
 {
@@ -96,27 +142,41 @@ void setup()
 
   // Start the serial communication with a baud rate of 115200
   Serial.begin(115200);
-  Serial.println("Seeingsensor enabled: " + String(SEEING_ENABLED));
+  Serial.printf("Seeingsensor enabled: %d\n", SEEING_ENABLED);
   bool pinstate = digitalRead(EN_SEEING);
-  Serial.println("Seeingsensor pinstate: " + String(pinstate));
+  Serial.printf("Seeingsensor pinstate: %d\n", pinstate);
 
   // Start the I2C communication for the lightning sensor
   Wire1.begin(SDA_2, SCL_2, 100000U);
   // Start the I2C communication for the other sensors
   Wire.begin(SDA_1, SCL_1, 100000U);
 
-  // Load the network settings from the server once
+  // Load the saved configuration once
   if (!hasInitialized)
   {
-    Serial.println("Loading wifi settings files...");
-    getSavedWifiSettings(WIFI_SSID, WIFI_PASS, SERVER_IP, SEND_VALUES_SERVER, FETCH_SETTINGS_SERVER);
+    Serial.println("Loading configuration...");
+    getSavedWifiSettings(stationConfig, SEND_VALUES_SERVER, FETCH_SETTINGS_SERVER);
+    // use the settings last fetched from the server until they are fetched again
+    if (stationConfig.flags & CONFIG_HAS_SERVER_SETTINGS)
+    {
+      StationSettings defaults = {seeing_thr, SP1, SP2, MAX_LUX, SLEEPTIME_s, DISPLAY_TIMEOUT_s, DISPLAY_ON, SQM_LIMIT};
+      StationSettings saved = lastServerSettings();
+      applySettings(saved, compareSettings(defaults, saved));
+    }
     hasInitialized = true;
   }
 
+  // Mount SPIFFS and resume the measurement log after its last record
+  hasLog = initSPIFFS() && measurementLog.begin();
+  if (!hasLog)
+  {
+    Serial.println("Measurement log not available");
+  }
+
   // Enable and set the WiFi to station mode
   WiFi.mode(WIFI_STA);
-  WiFi.begin(WIFI_SSID, WIFI_PASS);
-  Serial.println("WIFI:" + String(WIFI_SSID));
+  WiFi.begin(stationConfig.WIFI_SSID, stationConfig.WIFI_PASS);
+  Serial.printf("WIFI:%s\n", stationConfig.WIFI_SSID);
   WiFi.setTxPower(WIFI_POWER_19_5dBm);
 
   // Enable the supply voltage for the sensors
@@ -129,20 +189,20 @@ void setup()
   // Initialize the SQM sensor
   FreqCountESP.begin(SQMpin, 100);
 
-  // Initialize the sensors, add errors to error array if sensor error
+  // Initialize the sensors, keep the errors to send them with every measurement
   if (!init_MLX90614())
   {
-    sensorErrors.push_back("init_MLX90614");
+    initErrors |= ERROR_INIT_MLX90614;
   }
   delay(20);
   if (!init_TSL2561())
   {
-    sensorErrors.push_back("init_TSL2561");
+    initErrors |= ERROR_INIT_TSL2561;
   }
   delay(20);
   if (!init_AS3935(Wire1))
   {
-    sensorErrors.push_back("init_AS3935");
+    initErrors |= ERROR_INIT_AS3935;
   }
   delay(20);
 
@@ -153,57 +213,101 @@ void setup()
 
 void loop()
 {
-  // read sensors, if sensor error add to  error array to be able send them to the server
-  if (!read_MLX90614(ambient, object))
+  // start the cycle with the values of unread sensors, only the errors of this cycle are sent
+  clearMeasurement(measurement, initErrors);
+  measurement.seeingEnabled = SEEING_ENABLED;
+
+  // the measurement is stamped with the time the sensors are read at
+  int64_t acquiredUs = readClockUs();
+
+  // sample the heap before the cycle allocates anything
+  HeapSample heapSample;
+  sampleHeap(heapSample);
+  heapHistory.add(heapSample);
+
+  // read sensors, if sensor error set its bit to be able send them to the server
+  if (!read_MLX90614(measurement.ambient, measurement.object))
   {
-    sensorErrors.push_back("read_MLX90614");
+    measurement.errors |= ERROR_READ_MLX90614;
   }
   delay(20);
-  if (!read_TSL2561(lux))
+  if (!read_TSL2561(measurement.lux))
   {
-    sensorErrors.push_back("read_TSL2561");
+    measurement.errors |= ERROR_READ_TSL2561;
   }
-  if (!read_AS3935(lightning_distanceToStorm))
+  if (!read_AS3935(measurement.lightning_distanceToStorm))
   {
-    sensorErrors.push_back("read_AS3935");
+    measurement.errors |= ERROR_READ_AS3935;
   }
   delay(20);
-  if (!read_TSL237(luminosity, nelm, SQM_LIMIT))
+  if (!read_TSL237(measurement.luminosity, measurement.nelm, SQM_LIMIT))
   {
-    sensorErrors.push_back("read_TSL237");
+    measurement.errors |= ERROR_READ_TSL237;
   }
   delay(20);
   // read the sensor values
-  read_particles(concentration); // read the particle sensor
-  read_rain(raining);            // read the rain sensor
+  read_particles(measurement.concentration); // read the particle sensor
+  read_rain(measurement.raining);            // read the rain sensor
+
+  // sync the clock when it is too uncertain, at most every TIME_SYNC_RETRY_s
+  if (WiFi.status() == WL_CONNECTED && isTimeSyncDue(timeState, readClockUs(), TIME_SYNC_INTERVAL_s, TIME_MAX_UNCERTAINTY_ms, TIME_SYNC_RETRY_s))
+  {
+    int64_t stepUs;
+    if (syncTime(timeState, NTP_SERVER, stepUs))
+    {
+      // the sensors were read before the clock was set
+      acquiredUs += stepUs;
+    }
+  }
+  measurement.timeQuality = stampTime(timeState, acquiredUs, measurement.timeUs, measurement.timeUncertaintyMs);
 
   // send data if connected to wifi
   if (WiFi.status() == WL_CONNECTED)
   {
-    // fetch settings if not loaded yet
-    if (!settingsLoaded)
+    // fetch the settings at the first connection, then again every SETTINGS_FETCH_CYCLES cycles
+    // while they don't change, the server answers with an empty 304
+    if (!settingsLoaded || isSettingsFetchDue(settingsFetch, sendCount, SETTINGS_FETCH_CYCLES))
     {
-      // fetch settings from server, save if successfully fetched
-      settingsLoaded = fetch_settings(FETCH_SETTINGS_SERVER, seeing_thr, SP1, SP2, MAX_LUX, SLEEPTIME_s, DISPLAY_TIMEOUT_s, DISPLAY_ON, SQM_LIMIT);
-      // start setup() again if settings loaded to apply changes
-      Serial.println("Settings loaded: " + String(settingsLoaded));
-      esp_deep_sleep(100000);
+      StationSettings settings = lastServerSettings();
+      uint8_t changes;
+      int result = fetch_settings(FETCH_SETTINGS_SERVER, settingsFetch, sendCount, settings, changes);
+      if (result != FETCH_FAILED)
+      {
+        settingsLoaded = true;
+      }
+      // use the new settings in this cycle already, and keep them for the next cold boot
+      // a new ETag for the same settings changes nothing
+      if (result == FETCH_UPDATED && changes != 0)
+      {
+        applySettings(settings, changes);
+        settingsToConfig(settings, stationConfig);
+        saveConfig(stationConfig);
+      }
+      Serial.printf("Settings fetched: %d\n", result);
     }
 
     // if seeing enabled, get seeing value
     if (SEEING_ENABLED)
     {
       Serial.println("Getting seeing...");
-      if (!UART_get_Seeing(seeing))
+      if (!UART_get_Seeing(measurement.seeing))
       {
-        sensorErrors.push_back("UART_get_Seeing");
-        seeing = "-333";
+        measurement.errors |= ERROR_UART_SEEING;
+        measurement.seeing = SEEING_MISSING;
       }
-      // check if seeing only contains numbers and a dot
+    }
+
+    // send the heap summary along every HEAP_REPORT_CYCLES cycles
+    HeapSummary heapSummary;
+    bool heapReport = sendCount % HEAP_REPORT_CYCLES == 0 && heapHistory.summarize(heapSummary);
+    if (heapReport)
+    {
+      Serial.printf("Heap: %lu free, %lu min, %lu largest block, trend %.1f B/cycle\n", (unsigned long)heapSummary.freeHeap,
+                    (unsigned long)heapSummary.minFreeHeap, (unsigned long)heapSummary.largestFreeBlock, heapSummary.freeHeapTrend);
     }
 
     // else send sensor values to server
-    hasServerError = !post_data(SEND_VALUES_SERVER, raining, luminosity, seeing, nelm, concentration, object, ambient, lux, lightning_distanceToStorm, sensorErrors, SEEING_ENABLED);
+    hasServerError = !post_data(SEND_VALUES_SERVER, measurement, heapReport ? &heapSummary : NULL);
 
     if (hasServerError) // if server error, increase error count
     {
@@ -230,13 +334,24 @@ void loop()
     hasWIFI = false;
   }
 
+  // keep the measurement in the local log, whether it was sent or not
+  if (hasLog)
+  {
+    LogRecord record;
+    measurementToLogRecord(measurement, record);
+    if (!measurementLog.append(record))
+    {
+      Serial.println("Could not write the measurement log");
+    }
+  }
+
   // check cloud state and if seeing should be enabled if has wifi
   if (hasWIFI)
   {
     // calculate the cloud state based on IR sensor values
-    CLOUD_STATE = get_cloud_state(object, ambient, SP1, SP2);
+    CLOUD_STATE = get_cloud_state(measurement.object, measurement.ambient, SP1, SP2);
     // check if seeing should be enabled with settings and sensor values
-    check_seeing_threshhold(seeing_thr, GOOD_SKY_STATE_COUNT, BAD_SKY_STATE_COUNT, CLOUD_STATE, lux, MAX_LUX, SEEING_ENABLED, SLEEPTIME_s);
+    check_seeing_threshhold(seeing_thr, GOOD_SKY_STATE_COUNT, BAD_SKY_STATE_COUNT, CLOUD_STATE, measurement.lux, MAX_LUX, SEEING_ENABLED, SLEEPTIME_s);
   }
 
   // turn display off after set time
@@ -255,6 +370,8 @@ void loop()
       sleepForever = true;
       // show status message on display
       DisplayStatusMessage(hasWIFI, hasServerError, settingsLoaded, sendCount, noWifiCount, sleepForever, DISPLAY_ON);
+      // write the buffered measurements before the access point takes over
+      measurementLog.flush();
       // open AP for changing WIFI settings
       activate_access_point();
     }
@@ -264,9 +381,9 @@ void loop()
       WiFi.disconnect();
       delay(100);
       WiFi.mode(WIFI_STA);
-      WiFi.begin(WIFI_SSID, WIFI_PASS);
+      WiFi.begin(stationConfig.WIFI_SSID, stationConfig.WIFI_PASS);
       delay(100);
-      Serial.println("WIFI:" + String(WIFI_SSID));
+      Serial.printf("WIFI:%s\n", stationConfig.WIFI_SSID);
     }
   }
 
@@ -281,7 +398,7 @@ void loop()
   // show status message on display
   DisplayStatusMessage(hasWIFI, hasServerError, settingsLoaded, sendCount, noWifiCount, sleepForever, DISPLAY_ON);
 
-  Serial.println("Going to sleep now for " + String(sleepTime) + " seconds");
+  Serial.printf("Going to sleep now for %d seconds\n", sleepTime);
 
   // WiFi.mode(WIFI_MODE_NULL); // Switch WiFi off
   // esp_deep_sleep(sleepTime * 1000000); // send ESP32 to deepsleep
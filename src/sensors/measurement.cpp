@@ -0,0 +1,246 @@
+#include "measurement.h"
+#include <math.h>
+#include <string.h>
+
+// Names of the errors sent to the server, in the order of the ERROR_ bits
+static const char *const errorNames[] = {
+    "init_MLX90614",
+    "init_TSL2561",
+    "init_AS3935",
+    "read_MLX90614",
+    "read_TSL2561",
+    "read_AS3935",
+    "read_TSL237",
+    "UART_get_Seeing",
+};
+
+// Writes text to a fixed buffer, and remembers if it didn't fit
+struct JsonWriter
+{
+  char *cursor;
+  char *end;
+  bool overflowed;
+
+  void write(const char *text)
+  {
+    size_t n = strlen(text);
+    if (n >= (size_t)(end - cursor))
+    {
+      overflowed = true;
+      return;
+    }
+    memcpy(cursor, text, n);
+    cursor += n;
+  }
+
+  void writeInteger(long value)
+  {
+    char digits[12];
+    char *p = digits + sizeof(digits);
+    unsigned long magnitude = value < 0 ? 0UL - (unsigned long)value : (unsigned long)value;
+    *--p = 0;
+    do
+    {
+      *--p = '0' + magnitude % 10;
+      magnitude /= 10;
+    } while (magnitude > 0);
+    if (value < 0)
+    {
+      *--p = '-';
+    }
+    write(p);
+  }
+
+  // Two decimals, as String(float) did before
+  void writeFixed2(double value)
+  {
+    if (isnan(value) || isinf(value) || fabs(value) > 2e7)
+    {
+      write(isnan(value) ? "nan" : isinf(value) ? "inf" : "ovf");
+      return;
+    }
+    long hundredths = lround(value * 100);
+    writeHundredths(hundredths);
+  }
+
+  void writeHundredths(long hundredths)
+  {
+    if (hundredths < 0)
+    {
+      write("-");
+      hundredths = -hundredths;
+    }
+    char decimals[4] = {'.', char('0' + hundredths % 100 / 10), char('0' + hundredths % 10), 0};
+    writeInteger(hundredths / 100);
+    write(decimals);
+  }
+
+  void writeMillis(int64_t millis)
+  {
+    char decimals[5] = {'.', char('0' + millis % 1000 / 100), char('0' + millis % 100 / 10), char('0' + millis % 10), 0};
+    writeInteger(millis / 1000);
+    write(decimals);
+  }
+};
+
+void clearMeasurement(Measurement &measurement, uint16_t errors)
+{
+  measurement.raining = false;
+  measurement.seeingEnabled = false;
+  measurement.errors = errors;
+  measurement.luminosity = -333;
+  measurement.nelm = -333;
+  measurement.seeing = SEEING_MISSING;
+  measurement.concentration = -333;
+  measurement.object = -333;
+  measurement.ambient = -333;
+  measurement.lux = -333;
+  measurement.lightning_distanceToStorm = -333;
+  measurement.timeUs = 0;
+  measurement.timeUncertaintyMs = UINT32_MAX;
+  measurement.timeQuality = TIME_QUALITY_NONE;
+}
+
+bool parseSeeing(const char *text, int32_t &seeing)
+{
+  while (*text == ' ' || *text == '\t' || *text == '\r' || *text == '\n')
+  {
+    text++;
+  }
+  int32_t whole = 0;
+  int32_t hundredths = 0;
+  int digits = 0;
+  for (; *text >= '0' && *text <= '9' && whole < 100000; text++, digits++)
+  {
+    whole = whole * 10 + (*text - '0');
+  }
+  if (*text == '.')
+  {
+    text++;
+    // round to the hundredth with the third decimal, skip the others
+    int32_t scale = 100;
+    for (; *text >= '0' && *text <= '9'; text++, digits++)
+    {
+      if (scale >= 1)
+      {
+        hundredths += (*text - '0') * scale;
+        scale /= 10;
+      }
+    }
+    hundredths = (hundredths + 5) / 10;
+  }
+  while (*text == ' ' || *text == '\t' || *text == '\r' || *text == '\n')
+  {
+    text++;
+  }
+  int32_t value = whole * 100 + hundredths;
+  if (digits == 0 || *text != 0 || value <= 0)
+  {
+    return false;
+  }
+  seeing = value;
+  return true;
+}
+
+// Same keys and format as the body built with Strings before, the server reads every value as a string
+size_t encodeMeasurement(const Measurement &measurement, char *buffer, size_t size, const HeapSummary *heap)
+{
+  if (size == 0)
+  {
+    return 0;
+  }
+  JsonWriter writer = {buffer, buffer + size, false};
+  writer.write("{\"raining\":\"");
+  writer.writeInteger(measurement.raining);
+  writer.write("\",\"luminosity\":\"");
+  writer.writeFixed2(measurement.luminosity);
+  writer.write("\",\"seeing\":\"");
+  if (measurement.seeing == SEEING_MISSING)
+  {
+    writer.write("-333");
+  }
+  else
+  {
+    writer.writeHundredths(measurement.seeing);
+  }
+  writer.write("\",\"nelm\":\"");
+  writer.writeFixed2(measurement.nelm);
+  writer.write("\",\"concentration\":\"");
+  writer.writeInteger(measurement.concentration);
+  writer.write("\",\"object\":\"");
+  writer.writeFixed2(measurement.object);
+  writer.write("\",\"ambient\":\"");
+  writer.writeFixed2(measurement.ambient);
+  writer.write("\",\"lux\":\"");
+  writer.writeFixed2(measurement.lux);
+  writer.write("\",\"lightning_distanceToStorm\":\"");
+  writer.writeInteger(measurement.lightning_distanceToStorm);
+  writer.write("\",\"errors\":\"");
+  for (size_t i = 0; i < sizeof(errorNames) / sizeof(errorNames[0]); i++)
+  {
+    if (measurement.errors & (1 << i))
+    {
+      writer.write(errorNames[i]);
+      writer.write(", ");
+    }
+  }
+  writer.write("\",\"isSeeing\":\"");
+  writer.writeInteger(measurement.seeingEnabled);
+  // seconds since the epoch with milliseconds, -333 if the clock was never synced
+  writer.write("\",\"time\":\"");
+  if (measurement.timeQuality == TIME_QUALITY_NONE)
+  {
+    writer.write("-333");
+  }
+  else
+  {
+    writer.writeMillis(measurement.timeUs / 1000);
+  }
+  writer.write("\",\"timeQuality\":\"");
+  writer.writeInteger(measurement.timeQuality);
+  writer.write("\",\"timeUncertainty\":\"");
+  writer.writeInteger(measurement.timeQuality == TIME_QUALITY_NONE ? -333 : (long)measurement.timeUncertaintyMs);
+  if (heap != NULL)
+  {
+    writer.write("\",\"heapFree\":\"");
+    writer.writeInteger(heap->freeHeap);
+    writer.write("\",\"heapMinFree\":\"");
+    writer.writeInteger(heap->minFreeHeap);
+    writer.write("\",\"heapLargestBlock\":\"");
+    writer.writeInteger(heap->largestFreeBlock);
+    writer.write("\",\"heapFragmentation\":\"");
+    writer.writeInteger(heap->fragmentation);
+    writer.write("\",\"heapTrend\":\"");
+    writer.writeFixed2(heap->freeHeapTrend);
+    for (int t = 0; t < HEAP_TASKS; t++)
+    {
+      writer.write("\",\"stack_");
+      writer.write(heapTaskNames[t]);
+      writer.write("\":\"");
+      writer.writeInteger(heap->stackFree[t] == HEAP_NO_TASK ? -333 : heap->stackFree[t]);
+    }
+  }
+  writer.write("\"}");
+  if (writer.overflowed)
+  {
+    return 0;
+  }
+  *writer.cursor = 0;
+  return writer.cursor - buffer;
+}
+
+void measurementToLogRecord(const Measurement &measurement, LogRecord &record)
+{
+  memset(&record, 0, sizeof(record));
+  record.time = measurement.timeUs / 1000000;
+  record.lux = measurement.lux;
+  record.sqm = logFixed(measurement.luminosity, 100);
+  record.nelm = logFixed(measurement.nelm, 100);
+  record.seeing = measurement.seeingEnabled && measurement.seeing != SEEING_MISSING ? logFixed(measurement.seeing, 1) : LOG_MISSING;
+  record.objectTemp = logFixed(measurement.object, 100);
+  record.ambientTemp = logFixed(measurement.ambient, 100);
+  record.concentration = logFixed(measurement.concentration, 1);
+  record.lightningDistance = logFixed(measurement.lightning_distanceToStorm, 1);
+  record.flags = (measurement.raining ? LOG_FLAG_RAINING : 0) | (measurement.seeingEnabled ? LOG_FLAG_SEEING_ENABLED : 0) | (measurement.errors ? LOG_FLAG_SENSOR_ERROR : 0) |
+                 (measurement.timeQuality == TIME_QUALITY_NONE ? LOG_FLAG_TIME_UNSYNCED : 0);
+}
@@ -0,0 +1,71 @@
+#ifndef MEASUREMENT_H
+#define MEASUREMENT_H
+#include <stddef.h>
+#include <stdint.h>
+#include "hardware/measurement_log.h"
+#include "hardware/heap_telemetry.h"
+#include "hardware/time_service.h"
+
+// A Measurement has a fixed layout and is encoded into the caller's buffer, so a cycle never allocates.
+
+// Bits of Measurement::errors, one for each sensor call that failed
+#define ERROR_INIT_MLX90614 0x0001
+#define ERROR_INIT_TSL2561 0x0002
+#define ERROR_INIT_AS3935 0x0004
+#define ERROR_READ_MLX90614 0x0008
+#define ERROR_READ_TSL2561 0x0010
+#define ERROR_READ_AS3935 0x0020
+#define ERROR_READ_TSL237 0x0040
+#define ERROR_UART_SEEING 0x0080
+
+// Value of Measurement::seeing when there is none
+#define SEEING_MISSING (-33300)
+
+// Size of the buffer for encodeMeasurement(), enough for every sensor error and the heap summary
+#define MEASUREMENT_JSON_SIZE 768
+
+/// @brief The values of one measurement cycle, filled by the sensors and passed by reference to every stage
+struct Measurement
+{
+  bool raining;
+  bool seeingEnabled;
+  uint16_t errors;                  // ERROR_ bits
+  float luminosity;                 // the SQM value, sky magnitude
+  double nelm;                      // naked eye limiting magnitude
+  int32_t seeing;                   // hundredths of an arcsecond, SEEING_MISSING if unknown
+  int concentration;                // particles
+  float object;                     // IR temperature of the sky
+  float ambient;                    // ambient temperature
+  double lux;                       // brightness
+  int lightning_distanceToStorm;    // km
+  int64_t timeUs;                   // when the sensors were read, µs since the epoch, see stampTime()
+  uint32_t timeUncertaintyMs;       // error bound of the time
+  uint8_t timeQuality;              // TIME_QUALITY_
+};
+
+/// @brief Reset the values to -333, the value of a sensor that couldn't be read, and the time to unknown
+/// @param measurement the measurement
+/// @param errors the errors found before the cycle, by the initialization of the sensors
+void clearMeasurement(Measurement &measurement, uint16_t errors);
+
+/// @brief Read a seeing value sent by the seeing sensor, like "1.27"
+/// @details The value is rounded to the hundredth with its third decimal, so "1.275" is sent as "1.28" and
+/// "1.2749" as "1.27": the server gets two decimals, not the text of the sensor.
+/// @param text the text, spaces and line ends around the number are skipped
+/// @param seeing the value in hundredths of an arcsecond
+/// @return true if the text is a positive number below 1000000, false otherwise
+bool parseSeeing(const char *text, int32_t &seeing);
+
+/// @brief Write the measurement as the JSON body expected by the server
+/// @param measurement the measurement
+/// @param buffer the buffer, MEASUREMENT_JSON_SIZE bytes are always enough
+/// @param size the size of the buffer
+/// @param heap the heap summary to send along, NULL if it isn't due
+/// @return the length of the JSON, 0 if the buffer is too small
+size_t encodeMeasurement(const Measurement &measurement, char *buffer, size_t size, const HeapSummary *heap = NULL);
+
+/// @brief Convert the measurement to a record of the measurement log
+/// @param measurement the measurement
+/// @param record the record
+void measurementToLogRecord(const Measurement &measurement, LogRecord &record);
+#endif
@@ -8,6 +8,7 @@
 
 // WiFi credentials.
 #define serverPort "5000" // Port of the server
+#define SETTINGS_FETCH_CYCLES 30 // cycles between two fetches of the settings, unchanged settings cost an empty 304 answer
 
 // File paths to save input values permanently
 #define ssidPath  "/ssid.txt"
@@ -47,6 +48,43 @@
    https://github.com/me−no−dev/arduino−esp32fs−plugin */
 #define FORMAT_SPIFFS_IF_FAILED false
 
+// ===========================================================
+//                 MEASUREMENT LOG SETTINGS
+// ===========================================================
+
+#define LOG_RECORDS_PER_SEGMENT 512
+// Records in a segment file of the measurement log, 32 bytes each (16 kB)
+
+#define LOG_SEGMENTS 8
+// Full segments kept besides the one being written, the oldest is overwritten
+// 8 segments keep at least 4096 measurements: about 3 days with a measurement per minute
+
+// ===========================================================
+//                 TIME SETTINGS
+// ===========================================================
+
+#define NTP_SERVER "pool.ntp.org"
+#define NTP_LOCAL_PORT 2390
+#define NTP_TIMEOUT_ms 1000
+// SNTP server, local UDP port of the request and time to wait for the answer
+
+#define TIME_SYNC_INTERVAL_s 21600
+// Longest time between two syncs of the clock
+
+#define TIME_MAX_UNCERTAINTY_ms 1000
+// The clock is synced before the interval when the error bound of its time grows larger
+// With a known drift the bound grows by 50 ms per 1000 s, with an unknown drift ten times faster
+
+#define TIME_SYNC_RETRY_s 600
+// Shortest time between two sync attempts, so that an unreachable server doesn't cost a round trip every cycle
+
+// ===========================================================
+//                 HEAP TELEMETRY SETTINGS
+// ===========================================================
+
+#define HEAP_REPORT_CYCLES 60
+// Cycles between two heap summaries sent with the measurements, the heap is sampled at every cycle
+
 // ===========================================================
 //                 LIGHTNING SENSOR SETTINGS
 // ===========================================================
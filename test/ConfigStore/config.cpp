@@ -0,0 +1,186 @@
+#include <catch.hpp>
+#include <string.h>
+#include <string>
+#include <config_store.h>
+
+static StationConfig filledConfig()
+{
+  StationConfig config;
+  clearConfig(config);
+  strcpy(config.WIFI_SSID, "station");
+  strcpy(config.WIFI_PASS, "secret");
+  strcpy(config.SERVER_IP, "192.168.1.10");
+  config.flags = CONFIG_HAS_WIFI;
+  config.SLEEPTIME_s = 60;
+  config.SQM_LIMIT = 21.5;
+  return config;
+}
+
+TEST_CASE("isConfigValid()")
+{
+  StationConfig config = filledConfig();
+  sealConfig(config);
+
+  SECTION("a sealed configuration")
+  {
+    REQUIRE(isConfigValid(config));
+  }
+
+  SECTION("a flipped bit anywhere before the CRC")
+  {
+    unsigned char *bytes = reinterpret_cast<unsigned char *>(&config);
+    for (size_t i = 0; i < offsetof(StationConfig, crc); i++)
+    {
+      for (int bit = 0; bit < 8; bit++)
+      {
+        StationConfig flipped = config;
+        reinterpret_cast<unsigned char *>(&flipped)[i] = bytes[i] ^ (1 << bit);
+        INFO("byte " << i << ", bit " << bit);
+        REQUIRE_FALSE(isConfigValid(flipped));
+      }
+    }
+  }
+
+  SECTION("a flipped bit in the CRC")
+  {
+    config.crc ^= 0x00010000;
+    REQUIRE_FALSE(isConfigValid(config));
+  }
+
+  SECTION("another version, even with a matching CRC")
+  {
+    config.version = CONFIG_VERSION + 1;
+    StationConfig resealed = config;
+    sealConfig(resealed);
+    config.crc = resealed.crc;
+    REQUIRE_FALSE(isConfigValid(config));
+  }
+
+  SECTION("a changed setting that wasn't sealed again")
+  {
+    config.SLEEPTIME_s = 120;
+    REQUIRE_FALSE(isConfigValid(config));
+    sealConfig(config);
+    REQUIRE(isConfigValid(config));
+  }
+}
+
+TEST_CASE("clearConfig() leaves no configuration to use")
+{
+  StationConfig config = filledConfig();
+  clearConfig(config);
+
+  REQUIRE(config.version == CONFIG_VERSION);
+  REQUIRE(config.flags == 0);
+  REQUIRE(std::string(config.WIFI_SSID) == "");
+  REQUIRE_FALSE(isConfigValid(config));
+}
+
+TEST_CASE("sealConfig() terminates the strings")
+{
+  StationConfig config;
+  clearConfig(config);
+  memset(config.WIFI_SSID, 'a', sizeof(config.WIFI_SSID));
+  memset(config.WIFI_PASS, 'b', sizeof(config.WIFI_PASS));
+  memset(config.SERVER_IP, 'c', sizeof(config.SERVER_IP));
+  sealConfig(config);
+
+  REQUIRE(strlen(config.WIFI_SSID) == sizeof(config.WIFI_SSID) - 1);
+  REQUIRE(strlen(config.WIFI_PASS) == sizeof(config.WIFI_PASS) - 1);
+  REQUIRE(strlen(config.SERVER_IP) == sizeof(config.SERVER_IP) - 1);
+  REQUIRE(isConfigValid(config));
+}
+
+TEST_CASE("setConfigString()")
+{
+  StationConfig config = filledConfig();
+
+  SECTION("the longest string that fits")
+  {
+    std::string host(sizeof(config.SERVER_IP) - 1, 'h');
+    REQUIRE(setConfigString(config.SERVER_IP, sizeof(config.SERVER_IP), host.c_str()));
+    REQUIRE(std::string(config.SERVER_IP) == host);
+  }
+
+  SECTION("a string one character too long keeps the field")
+  {
+    std::string host(sizeof(config.SERVER_IP), 'h');
+    REQUIRE_FALSE(setConfigString(config.SERVER_IP, sizeof(config.SERVER_IP), host.c_str()));
+    REQUIRE(std::string(config.SERVER_IP) == "192.168.1.10");
+  }
+
+  SECTION("an SSID longer than 32 characters")
+  {
+    std::string ssid(33, 's');
+    REQUIRE_FALSE(setConfigString(config.WIFI_SSID, sizeof(config.WIFI_SSID), ssid.c_str()));
+    REQUIRE(std::string(config.WIFI_SSID) == "station");
+  }
+
+  SECTION("an empty string")
+  {
+    REQUIRE(setConfigString(config.WIFI_PASS, sizeof(config.WIFI_PASS), ""));
+    REQUIRE(std::string(config.WIFI_PASS) == "");
+  }
+}
+
+TEST_CASE("a host name of the older firmware still fits with the URLs built from it")
+{
+  StationConfig config;
+  std::string host(sizeof(config.SERVER_IP) - 1, 'h');
+  std::string longest = "http://" + host + ":65535/getsettings";
+
+  REQUIRE(longest.size() < SERVER_URL_SIZE);
+}
+
+TEST_CASE("migrateNetworkSettings()")
+{
+  StationConfig config;
+  clearConfig(config);
+
+  SECTION("the values of /ssid.txt, /pass.txt and /ip.txt")
+  {
+    REQUIRE(migrateNetworkSettings(config, "station", "secret", "sqm.example.org"));
+    REQUIRE(std::string(config.WIFI_SSID) == "station");
+    REQUIRE(std::string(config.WIFI_PASS) == "secret");
+    REQUIRE(std::string(config.SERVER_IP) == "sqm.example.org");
+    REQUIRE(config.flags == CONFIG_HAS_WIFI);
+
+    sealConfig(config);
+    REQUIRE(isConfigValid(config));
+  }
+
+  SECTION("without /pass.txt and /ip.txt")
+  {
+    REQUIRE(migrateNetworkSettings(config, "open network", NULL, NULL));
+    REQUIRE(std::string(config.WIFI_SSID) == "open network");
+    REQUIRE(std::string(config.WIFI_PASS) == "");
+    REQUIRE(std::string(config.SERVER_IP) == "");
+    REQUIRE(config.flags == CONFIG_HAS_WIFI);
+  }
+
+  SECTION("the longest values the older firmware kept")
+  {
+    std::string ssid(sizeof(config.WIFI_SSID) - 1, 's');
+    std::string pass(sizeof(config.WIFI_PASS) - 1, 'p');
+    std::string ip(sizeof(config.SERVER_IP) - 1, 'i');
+    REQUIRE(migrateNetworkSettings(config, ssid.c_str(), pass.c_str(), ip.c_str()));
+    REQUIRE(std::string(config.SERVER_IP) == ip);
+  }
+
+  SECTION("a value too long changes nothing")
+  {
+    std::string ip(sizeof(config.SERVER_IP), 'i');
+    REQUIRE_FALSE(migrateNetworkSettings(config, "station", "secret", ip.c_str()));
+    REQUIRE(std::string(config.WIFI_SSID) == "");
+    REQUIRE(std::string(config.WIFI_PASS) == "");
+    REQUIRE(config.flags == 0);
+  }
+
+  SECTION("a password too long changes nothing")
+  {
+    std::string pass(sizeof(config.WIFI_PASS), 'p');
+    REQUIRE_FALSE(migrateNetworkSettings(config, "station", pass.c_str(), "sqm.example.org"));
+    REQUIRE(std::string(config.WIFI_SSID) == "");
+    REQUIRE(config.flags == 0);
+  }
+}
@@ -0,0 +1,167 @@
+#include <catch.hpp>
+#include <string.h>
+#include <hardware/heap_fkt.h>
+
+// A station that loses bytesPerCycle of heap every cycle, with a shrinking largest block
+static HeapSample makeSample(int cycle, int bytesPerCycle)
+{
+  HeapSample sample;
+  sample.freeHeap = 200000 + bytesPerCycle * cycle + (cycle % 3) * 100;
+  sample.largestFreeBlock = 110000 - 200 * cycle;
+  sample.minFreeHeap = 190000 - 48 * cycle;
+  sample.stackFree[0] = 5000;
+  sample.stackFree[1] = 1800;
+  sample.stackFree[2] = 3000;
+  sample.stackFree[3] = HEAP_NO_TASK;
+  return sample;
+}
+
+TEST_CASE("HeapHistory keeps the last samples in order")
+{
+  HeapHistory history;
+  HeapSummary summary;
+  CHECK(history.size() == 0);
+  CHECK_FALSE(history.summarize(summary));
+
+  SECTION("before the ring is full")
+  {
+    for (int cycle = 0; cycle < 10; cycle++)
+    {
+      history.add(makeSample(cycle, -48));
+    }
+    REQUIRE(history.size() == 10);
+    for (int i = 0; i < 10; i++)
+    {
+      INFO(i);
+      CHECK(history.sample(i).largestFreeBlock == makeSample(i, -48).largestFreeBlock);
+    }
+  }
+
+  SECTION("after the ring wrapped")
+  {
+    const int cycles = 2 * HEAP_HISTORY_SIZE + 5;
+    for (int cycle = 0; cycle < cycles; cycle++)
+    {
+      history.add(makeSample(cycle, -48));
+    }
+    REQUIRE(history.size() == HEAP_HISTORY_SIZE);
+    // the oldest first, the latest last
+    for (int i = 0; i < HEAP_HISTORY_SIZE; i++)
+    {
+      INFO(i);
+      CHECK(history.sample(i).largestFreeBlock == makeSample(cycles - HEAP_HISTORY_SIZE + i, -48).largestFreeBlock);
+    }
+    REQUIRE(history.summarize(summary));
+    CHECK(summary.samples == HEAP_HISTORY_SIZE);
+    CHECK(summary.freeHeap == makeSample(cycles - 1, -48).freeHeap);
+    CHECK(summary.largestFreeBlock == makeSample(cycles - 1, -48).largestFreeBlock);
+  }
+}
+
+TEST_CASE("HeapHistory::summarize()")
+{
+  HeapHistory history;
+  HeapSummary summary;
+
+  SECTION("the lowest stack of each task within the history")
+  {
+    for (int cycle = 0; cycle < 20; cycle++)
+    {
+      HeapSample sample = makeSample(cycle, 0);
+      if (cycle == 10)
+      {
+        sample.stackFree[0] = 4100;
+      }
+      if (cycle == 15)
+      {
+        sample.stackFree[2] = 2500;
+      }
+      history.add(sample);
+    }
+    REQUIRE(history.summarize(summary));
+    CHECK(summary.stackFree[0] == 4100);
+    CHECK(summary.stackFree[1] == 1800);
+    CHECK(summary.stackFree[2] == 2500);
+    CHECK(summary.stackFree[3] == HEAP_NO_TASK);
+  }
+
+  SECTION("a dip older than the history is forgotten")
+  {
+    for (int cycle = 0; cycle < HEAP_HISTORY_SIZE + 1; cycle++)
+    {
+      HeapSample sample = makeSample(cycle, 0);
+      if (cycle == 0)
+      {
+        sample.stackFree[1] = 100;
+      }
+      history.add(sample);
+    }
+    REQUIRE(history.summarize(summary));
+    CHECK(summary.stackFree[1] == 1800);
+  }
+
+  SECTION("a leak gives a negative trend")
+  {
+    for (int cycle = 0; cycle < HEAP_HISTORY_SIZE; cycle++)
+    {
+      history.add(makeSample(cycle, -48));
+    }
+    REQUIRE(history.summarize(summary));
+    CHECK(summary.freeHeapTrend == Approx(-48).epsilon(0.05));
+  }
+
+  SECTION("a heap that grows back gives a positive trend")
+  {
+    for (int cycle = 0; cycle < HEAP_HISTORY_SIZE; cycle++)
+    {
+      history.add(makeSample(cycle, 20));
+    }
+    REQUIRE(history.summarize(summary));
+    CHECK(summary.freeHeapTrend > 15);
+    CHECK(summary.freeHeapTrend < 25);
+  }
+
+  SECTION("a steady heap and a single sample give no trend")
+  {
+    HeapSample sample = makeSample(0, 0);
+    history.add(sample);
+    REQUIRE(history.summarize(summary));
+    CHECK(summary.freeHeapTrend == 0);
+    for (int cycle = 1; cycle < 10; cycle++)
+    {
+      history.add(sample);
+    }
+    REQUIRE(history.summarize(summary));
+    CHECK(summary.freeHeapTrend == 0);
+  }
+
+  SECTION("the fragmentation of the latest sample")
+  {
+    HeapSample sample = makeSample(0, 0);
+    sample.freeHeap = 100000;
+    sample.largestFreeBlock = 40000;
+    history.add(sample);
+    REQUIRE(history.summarize(summary));
+    CHECK(summary.fragmentation == 60);
+    CHECK(summary.minFreeHeap == sample.minFreeHeap);
+  }
+}
+
+TEST_CASE("sampleHeap() on a host")
+{
+  HeapSample sample;
+  memset(&sample, 0x55, sizeof(sample));
+  sampleHeap(sample);
+  CHECK(sample.freeHeap == 0);
+  for (int t = 0; t < HEAP_TASKS; t++)
+  {
+    CHECK(sample.stackFree[t] == HEAP_NO_TASK);
+  }
+
+  HeapHistory history;
+  history.add(sample);
+  HeapSummary summary;
+  REQUIRE(history.summarize(summary));
+  CHECK(summary.fragmentation == 0);
+  CHECK(summary.stackFree[0] == HEAP_NO_TASK);
+}
@@ -0,0 +1,35 @@
+// Just enough of the Arduino core to build the display library on a host
+#pragma once
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <math.h>
+#include <algorithm>
+#include <string>
+
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+
+using std::max;
+using std::min;
+
+inline void yield() {}
+
+class Print
+{
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t) = 0;
+  virtual size_t write(const char *) { return 0; }
+};
+
+class String : public std::string
+{
+public:
+  String(const char *s = "") : std::string(s) {}
+  String(const std::string &s) : std::string(s) {}
+  unsigned length() const { return (unsigned)size(); }
+  void toCharArray(char *buffer, unsigned size) const { strncpy(buffer, c_str(), size); }
+};
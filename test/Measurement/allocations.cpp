@@ -0,0 +1,151 @@
+// The heap of the whole test program goes through these counters, a cycle must leave them unchanged
+#include <catch.hpp>
+#include <new>
+#include <stdlib.h>
+#include <string.h>
+#include <sensors/measurement.h>
+
+static size_t allocations = 0;
+
+#ifdef __GLIBC__
+// glibc keeps its allocator under these names, so that malloc() can be replaced as well
+extern "C" void *__libc_malloc(size_t size);
+extern "C" void *__libc_calloc(size_t count, size_t size);
+extern "C" void *__libc_realloc(void *p, size_t size);
+
+extern "C" void *malloc(size_t size)
+{
+  allocations++;
+  return __libc_malloc(size);
+}
+
+extern "C" void *calloc(size_t count, size_t size)
+{
+  allocations++;
+  return __libc_calloc(count, size);
+}
+
+extern "C" void *realloc(void *p, size_t size)
+{
+  allocations++;
+  return __libc_realloc(p, size);
+}
+
+static void *allocate(size_t size)
+{
+  return __libc_malloc(size);
+}
+#else
+static void *allocate(size_t size)
+{
+  return malloc(size);
+}
+#endif
+
+void *operator new(size_t size)
+{
+  allocations++;
+  void *p = allocate(size > 0 ? size : 1);
+  if (p == NULL)
+  {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void *operator new[](size_t size)
+{
+  return operator new(size);
+}
+
+void operator delete(void *p) noexcept
+{
+  free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+  free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+  free(p);
+}
+
+void operator delete[](void *p, size_t) noexcept
+{
+  free(p);
+}
+
+
+// Everything main.cpp does with a measurement in a cycle, from the sensors to the upload and the log
+static size_t runCycle(uint32_t cycle, HeapHistory &history, const TimeState &timeState, char *buffer, size_t size)
+{
+  Measurement measurement;
+  clearMeasurement(measurement, cycle % 3 == 0 ? ERROR_INIT_AS3935 : 0);
+  measurement.raining = cycle % 2 == 0;
+  measurement.seeingEnabled = true;
+  measurement.luminosity = 21.35f;
+  measurement.nelm = 6.0;
+  measurement.object = -12.5f;
+  measurement.ambient = 4;
+  measurement.lux = cycle * 0.01;
+  measurement.concentration = 42;
+  measurement.lightning_distanceToStorm = 63;
+  if (!parseSeeing("1.42\r\n", measurement.seeing))
+  {
+    measurement.errors |= ERROR_UART_SEEING;
+  }
+  measurement.timeQuality = stampTime(timeState, 1700000000000000LL + cycle * 60000000LL, measurement.timeUs, measurement.timeUncertaintyMs);
+
+  HeapSample sample;
+  memset(&sample, 0, sizeof(sample));
+  sample.freeHeap = 200000 - cycle;
+  sample.largestFreeBlock = 100000;
+  sample.minFreeHeap = 150000;
+  history.add(sample);
+  HeapSummary summary;
+  bool hasSummary = cycle % 10 == 0 && history.summarize(summary);
+
+  size_t length = encodeMeasurement(measurement, buffer, size, hasSummary ? &summary : NULL);
+  LogRecord record;
+  measurementToLogRecord(measurement, record);
+  return length;
+}
+
+TEST_CASE("A measurement cycle doesn't allocate")
+{
+  static char buffer[MEASUREMENT_JSON_SIZE];
+  static HeapHistory history;
+  static TimeState timeState;
+  clearTimeState(timeState);
+  applyTimeSync(timeState, 1700000000000000LL, 0, 20000);
+
+  // the counters see the allocations; Catch allocates too, so the counts are taken before the checks
+  size_t before = allocations;
+  delete new int(0);
+  free(malloc(16));
+  size_t counted = allocations - before;
+#ifdef __GLIBC__
+  REQUIRE(counted == 2);
+#else
+  REQUIRE(counted == 1);
+#endif
+
+  before = allocations;
+  size_t length = runCycle(0, history, timeState, buffer, sizeof(buffer));
+  counted = allocations - before;
+  CHECK(counted == 0);
+  CHECK(length > 0);
+
+  // and over many cycles, some with the heap summary
+  before = allocations;
+  for (uint32_t cycle = 1; cycle <= 100; cycle++)
+  {
+    length = runCycle(cycle, history, timeState, buffer, sizeof(buffer));
+  }
+  counted = allocations - before;
+  CHECK(counted == 0);
+  CHECK(length > 0);
+}
@@ -0,0 +1,167 @@
+#include <catch.hpp>
+#include <string.h>
+#include <string>
+#include <sensors/measurement.h>
+
+static std::string encode(const Measurement &measurement, const HeapSummary *heap = NULL)
+{
+  char buffer[MEASUREMENT_JSON_SIZE];
+  size_t length = encodeMeasurement(measurement, buffer, sizeof(buffer), heap);
+  REQUIRE(length == strlen(buffer));
+  return buffer;
+}
+
+TEST_CASE("encodeMeasurement()")
+{
+  Measurement measurement;
+  clearMeasurement(measurement, 0);
+
+  SECTION("nothing read")
+  {
+    CHECK(encode(measurement) ==
+          "{\"raining\":\"0\",\"luminosity\":\"-333.00\",\"seeing\":\"-333\",\"nelm\":\"-333.00\","
+          "\"concentration\":\"-333\",\"object\":\"-333.00\",\"ambient\":\"-333.00\",\"lux\":\"-333.00\","
+          "\"lightning_distanceToStorm\":\"-333\",\"errors\":\"\",\"isSeeing\":\"0\",\"time\":\"-333\","
+          "\"timeQuality\":\"0\",\"timeUncertainty\":\"-333\"}");
+  }
+
+  SECTION("every sensor read")
+  {
+    measurement.raining = true;
+    measurement.seeingEnabled = true;
+    measurement.luminosity = 21.25f;
+    measurement.nelm = 6.004;
+    measurement.seeing = 128;
+    measurement.concentration = 42;
+    measurement.object = -12.5f;
+    measurement.ambient = 3.999f;
+    measurement.lux = 0.005;
+    measurement.lightning_distanceToStorm = 63;
+    measurement.errors = ERROR_INIT_AS3935 | ERROR_UART_SEEING;
+    measurement.timeUs = 1700000000123456LL;
+    measurement.timeUncertaintyMs = 21;
+    measurement.timeQuality = TIME_QUALITY_SYNCED;
+    CHECK(encode(measurement) ==
+          "{\"raining\":\"1\",\"luminosity\":\"21.25\",\"seeing\":\"1.28\",\"nelm\":\"6.00\","
+          "\"concentration\":\"42\",\"object\":\"-12.50\",\"ambient\":\"4.00\",\"lux\":\"0.01\","
+          "\"lightning_distanceToStorm\":\"63\",\"errors\":\"init_AS3935, UART_get_Seeing, \",\"isSeeing\":\"1\","
+          "\"time\":\"1700000000.123\",\"timeQuality\":\"1\",\"timeUncertainty\":\"21\"}");
+  }
+
+  SECTION("every error and the heap summary fit in MEASUREMENT_JSON_SIZE")
+  {
+    measurement.errors = 0xffff;
+    measurement.timeUs = INT64_MAX;
+    measurement.timeUncertaintyMs = UINT32_MAX;
+    measurement.timeQuality = TIME_QUALITY_CORRECTED;
+    HeapSummary heap;
+    memset(&heap, 0xff, sizeof(heap));
+    heap.freeHeapTrend = -1.99e7f;
+    heap.stackFree[0] = 1234;
+    std::string json = encode(measurement, &heap);
+    CHECK(json.find("\"heapTrend\":\"-19900000.00\"") != std::string::npos);
+    CHECK(json.find("\"stack_loopTask\":\"1234\",\"stack_tiT\":\"-333\"") != std::string::npos);
+  }
+
+  SECTION("a buffer too small")
+  {
+    char buffer[40];
+    memset(buffer, 'x', sizeof(buffer));
+    CHECK(encodeMeasurement(measurement, buffer, sizeof(buffer)) == 0);
+    CHECK(encodeMeasurement(measurement, buffer, 0) == 0);
+  }
+}
+
+TEST_CASE("parseSeeing()")
+{
+  int32_t seeing = 7;
+  CHECK(parseSeeing(" 1.275\r\n", seeing));
+  CHECK(seeing == 128);
+  CHECK(parseSeeing("2", seeing));
+  CHECK(seeing == 200);
+
+  seeing = 7;
+  CHECK_FALSE(parseSeeing("", seeing));
+  CHECK_FALSE(parseSeeing("abc", seeing));
+  CHECK_FALSE(parseSeeing("0.00", seeing));
+  CHECK_FALSE(parseSeeing("-1", seeing));
+  CHECK_FALSE(parseSeeing("1.2x", seeing));
+  CHECK(seeing == 7);
+}
+
+TEST_CASE("parseSeeing() rounds to the hundredth")
+{
+  int32_t seeing = 7;
+
+  SECTION("with the third decimal only")
+  {
+    CHECK(parseSeeing("1.2749", seeing));
+    CHECK(seeing == 127);
+    CHECK(parseSeeing("1.2750", seeing));
+    CHECK(seeing == 128);
+    CHECK(parseSeeing("0.995", seeing));
+    CHECK(seeing == 100);
+    CHECK(parseSeeing("0.005", seeing));
+    CHECK(seeing == 1);
+  }
+
+  SECTION("below half a hundredth is no seeing")
+  {
+    CHECK_FALSE(parseSeeing("0.004", seeing));
+    CHECK(seeing == 7);
+  }
+
+  SECTION("the JSON has two decimals")
+  {
+    Measurement measurement;
+    clearMeasurement(measurement, 0);
+    REQUIRE(parseSeeing("1.23456\r\n", measurement.seeing));
+    char json[MEASUREMENT_JSON_SIZE];
+    REQUIRE(encodeMeasurement(measurement, json, sizeof(json)) > 0);
+    CHECK(strstr(json, "\"seeing\":\"1.23\"") != NULL);
+  }
+}
+
+TEST_CASE("parseSeeing() with an overlong input")
+{
+  int32_t seeing = 7;
+
+  SECTION("many decimals")
+  {
+    CHECK(parseSeeing("1.27499999999999999999999999999999", seeing));
+    CHECK(seeing == 127);
+  }
+
+  SECTION("a whole part too large")
+  {
+    CHECK_FALSE(parseSeeing("12345678901234567890", seeing));
+    CHECK_FALSE(parseSeeing("1000000", seeing));
+    CHECK(seeing == 7);
+    CHECK(parseSeeing("999999.99", seeing));
+    CHECK(seeing == 99999999);
+  }
+
+  SECTION("text after the number")
+  {
+    CHECK_FALSE(parseSeeing("1.27 1.28 1.29 1.30 1.31 1.32", seeing));
+    CHECK(seeing == 7);
+  }
+}
+
+TEST_CASE("measurementToLogRecord()")
+{
+  Measurement measurement;
+  clearMeasurement(measurement, ERROR_READ_TSL237);
+  measurement.raining = true;
+  measurement.luminosity = 21.25f;
+  measurement.timeUs = 1700000000999999LL;
+  LogRecord record;
+  measurementToLogRecord(measurement, record);
+  CHECK(record.time == 1700000000u);
+  CHECK(record.sqm == 2125);
+  CHECK(record.nelm == LOG_MISSING);
+  CHECK(record.seeing == LOG_MISSING);
+  CHECK((record.flags & LOG_FLAG_RAINING) != 0);
+  CHECK((record.flags & LOG_FLAG_SENSOR_ERROR) != 0);
+  CHECK((record.flags & LOG_FLAG_TIME_UNSYNCED) != 0);
+}
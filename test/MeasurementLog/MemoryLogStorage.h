@@ -0,0 +1,89 @@
+#ifndef MEMORY_LOG_STORAGE_H
+#define MEMORY_LOG_STORAGE_H
+#include <map>
+#include <string>
+#include <string.h>
+#include <vector>
+#include <measurement_log.h>
+
+// Files of the log in memory, with failures on demand
+class MemoryLogStorage : public LogStorage
+{
+public:
+  MemoryLogStorage() : appends(0), writes(0), failAppends(false), failWrites(false) {}
+
+  size_t size(const char *path) override
+  {
+    std::map<std::string, std::vector<uint8_t> >::const_iterator file = files.find(path);
+    return file == files.end() ? 0 : file->second.size();
+  }
+
+  size_t read(const char *path, size_t offset, void *buffer, size_t length) override
+  {
+    std::map<std::string, std::vector<uint8_t> >::const_iterator file = files.find(path);
+    if (file == files.end() || offset >= file->second.size())
+    {
+      return 0;
+    }
+    size_t n = file->second.size() - offset < length ? file->second.size() - offset : length;
+    memcpy(buffer, &file->second[offset], n);
+    return n;
+  }
+
+  // A failing append writes half of the data, as a power loss in the middle of the write
+  bool append(const char *path, const void *data, size_t length) override
+  {
+    std::vector<uint8_t> &file = files[path];
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    if (failAppends)
+    {
+      file.insert(file.end(), bytes, bytes + length / 2);
+      return false;
+    }
+    appends++;
+    file.insert(file.end(), bytes, bytes + length);
+    return true;
+  }
+
+  // A failing write leaves the file as it was
+  bool write(const char *path, const void *data, size_t length) override
+  {
+    if (failWrites)
+    {
+      return false;
+    }
+    writes++;
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    files[path].assign(bytes, bytes + length);
+    return true;
+  }
+
+  std::vector<uint8_t> &file(const char *path) { return files[path]; }
+
+  std::map<std::string, std::vector<uint8_t> > files;
+  size_t appends;
+  size_t writes;
+  bool failAppends;
+  bool failWrites;
+};
+
+// A record with a time and a SQM value that changes with it
+inline LogRecord makeRecord(uint32_t time)
+{
+  LogRecord record;
+  memset(&record, 0, sizeof(record));
+  record.time = time;
+  record.lux = 0.5f;
+  record.sqm = logFixed(20 + (time % 200) / 100.0, 100);
+  record.nelm = LOG_MISSING;
+  record.seeing = LOG_MISSING;
+  return record;
+}
+
+// Visitor that keeps the time of the records
+inline bool collectTimes(const LogRecord &record, void *context)
+{
+  static_cast<std::vector<uint32_t> *>(context)->push_back(record.time);
+  return true;
+}
+#endif
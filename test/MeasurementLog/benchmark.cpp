@@ -0,0 +1,68 @@
+// Throughput of the log on files in memory: the cost of the log itself, without the flash
+#include <chrono>
+#include <stdio.h>
+#include "MemoryLogStorage.h"
+
+static double seconds(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool countRecords(const LogRecord &, void *context)
+{
+  (*static_cast<size_t *>(context))++;
+  return true;
+}
+
+int main()
+{
+  // a year of measurements every minute, in the layout of the station
+  const uint32_t records = 525600;
+  MemoryLogStorage storage;
+  MeasurementLog log(storage, 512, 16);
+  log.begin();
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (uint32_t time = 0; time < records; time++)
+  {
+    log.append(makeRecord(time));
+  }
+  log.flush();
+  double appendTime = seconds(start);
+  printf("append       %8.1f Mrecords/s  (%zu appends, %zu writes)\n", records / appendTime / 1e6, storage.appends, storage.writes);
+
+  size_t visited = 0;
+  start = std::chrono::steady_clock::now();
+  log.query(0, UINT32_MAX, countRecords, &visited);
+  double scanTime = seconds(start);
+  printf("full query   %8.1f Mrecords/s  (%zu records)\n", visited / scanTime / 1e6, visited);
+
+  // the index skips all the segments but the last
+  const int queries = 10000;
+  visited = 0;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < queries; i++)
+  {
+    log.query(records - 100, records - 50, countRecords, &visited);
+  }
+  printf("range query  %8.2f us  (%zu records)\n", seconds(start) / queries * 1e6, visited / queries);
+
+  const int opens = 1000;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < opens; i++)
+  {
+    MeasurementLog reopened(storage, 512, 16);
+    reopened.begin();
+  }
+  printf("begin        %8.2f us  (index)\n", seconds(start) / opens * 1e6);
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < opens; i++)
+  {
+    storage.files.erase("/tslog.idx");
+    MeasurementLog reopened(storage, 512, 16);
+    reopened.begin();
+  }
+  printf("begin        %8.2f us  (rebuilt index)\n", seconds(start) / opens * 1e6);
+  return 0;
+}
@@ -0,0 +1,298 @@
+#include <algorithm>
+#include <catch.hpp>
+#include <stdio.h>
+#include "MemoryLogStorage.h"
+
+static const uint16_t RECORDS_PER_SEGMENT = 100;
+static const uint8_t MAX_SEGMENTS = 4;
+
+// The segment files are a ring of MAX_SEGMENTS + 1 files
+static std::string segmentFile(uint32_t id)
+{
+  char path[16];
+  snprintf(path, sizeof(path), "/tslog%u.bin", (unsigned)(id % (MAX_SEGMENTS + 1)));
+  return path;
+}
+
+static std::vector<uint32_t> queryAll(MeasurementLog &log)
+{
+  std::vector<uint32_t> times;
+  log.query(0, UINT32_MAX, collectTimes, &times);
+  return times;
+}
+
+static void appendRange(MeasurementLog &log, uint32_t from, uint32_t to)
+{
+  for (uint32_t time = from; time < to; time++)
+  {
+    REQUIRE(log.append(makeRecord(time)));
+  }
+}
+
+// The times from..to-1
+static std::vector<uint32_t> range(uint32_t from, uint32_t to)
+{
+  std::vector<uint32_t> times;
+  for (uint32_t time = from; time < to; time++)
+  {
+    times.push_back(time);
+  }
+  return times;
+}
+
+TEST_CASE("MeasurementLog rotates the segments and recycles the oldest")
+{
+  MemoryLogStorage storage;
+  MeasurementLog log(storage, RECORDS_PER_SEGMENT, MAX_SEGMENTS);
+  REQUIRE(log.begin());
+
+  appendRange(log, 0, 1000);
+
+  // four full segments and an empty one, in five files and the index
+  CHECK(log.size() == MAX_SEGMENTS * RECORDS_PER_SEGMENT);
+  CHECK(log.segmentCount() == MAX_SEGMENTS + 1);
+  CHECK(storage.files.size() == MAX_SEGMENTS + 2);
+  for (uint8_t i = 0; i < MAX_SEGMENTS; i++)
+  {
+    const LogSegmentInfo &info = log.segment(i);
+    CHECK(info.id == 6u + i);
+    CHECK(info.firstSequence == 600u + i * RECORDS_PER_SEGMENT);
+    CHECK(info.count == RECORDS_PER_SEGMENT);
+    CHECK(info.minTime == 600u + i * RECORDS_PER_SEGMENT);
+    CHECK(info.maxTime == 699u + i * RECORDS_PER_SEGMENT);
+  }
+  CHECK(log.segment(MAX_SEGMENTS).count == 0);
+
+  CHECK(queryAll(log) == range(600, 1000));
+  CHECK(log.corrupted() == 0);
+
+  SECTION("a query only visits its range")
+  {
+    std::vector<uint32_t> times;
+    CHECK(log.query(650, 660, collectTimes, &times) == 11);
+    CHECK(times == range(650, 661));
+  }
+
+  SECTION("the buffered records are visited last")
+  {
+    appendRange(log, 1000, 1005);
+    std::vector<uint32_t> times;
+    CHECK(log.query(990, 2000, collectTimes, &times) == 15);
+    CHECK(times == range(990, 1005));
+  }
+
+  SECTION("a page is written in one append")
+  {
+    size_t appends = storage.appends;
+    appendRange(log, 1000, 1000 + LOG_PAGE_RECORDS - 1);
+    CHECK(storage.appends == appends);
+    appendRange(log, 1000 + LOG_PAGE_RECORDS - 1, 1000 + LOG_PAGE_RECORDS);
+    CHECK(storage.appends == appends + 1);
+  }
+}
+
+TEST_CASE("MeasurementLog resumes after flush()")
+{
+  MemoryLogStorage storage;
+  {
+    MeasurementLog log(storage, RECORDS_PER_SEGMENT, MAX_SEGMENTS);
+    REQUIRE(log.begin());
+    appendRange(log, 0, 405);
+    REQUIRE(log.flush());
+  }
+
+  MeasurementLog log(storage, RECORDS_PER_SEGMENT, MAX_SEGMENTS);
+  REQUIRE(log.begin());
+  CHECK(log.size() == 405);
+  CHECK(queryAll(log) == range(0, 405));
+
+  // the sequences go on, so the new records are valid
+  appendRange(log, 405, 410);
+  REQUIRE(log.flush());
+  const LogSegmentInfo &active = log.segment(log.segmentCount() - 1);
+  CHECK(active.firstSequence + active.count == 410);
+
+  MeasurementLog reopened(storage, RECORDS_PER_SEGMENT, MAX_SEGMENTS);
+  REQUIRE(reopened.begin());
+  CHECK(queryAll(reopened) == range(0, 410));
+  CHECK(reopened.corrupted() == 0);
+}
+
+TEST_CASE("MeasurementLog drops a torn last page")
+{
+  MemoryLogStorage storage;
+  uint32_t activeId;
+  {
+    MeasurementLog log(storage, RECORDS_PER_SEGMENT, MAX_SEGMENTS);
+    REQUIRE(log.begin());
+    appendRange(log, 0, 250);
+    REQUIRE(log.flush());
+    activeId = log.segment(log.segmentCount() - 1).id;
+  }
+
+  // a power loss in the middle of the next page
+  std::vector<uint8_t> &file = storage.file(segmentFile(activeId).c_str());
+  LogRecord torn = makeRecord(250);
+  file.insert(file.end(), reinterpret_cast<uint8_t *>(&torn), reinterpret_cast<uint8_t *>(&torn) + sizeof(torn) / 2);
+
+  MeasurementLog log(storage, RECORDS_PER_SEGMENT, MAX_SEGMENTS);
+  REQUIRE(log.begin());
+  CHECK(log.size() == 250);
+
+  // the records that follow go to a new segment, where they are aligned
+  CHECK(log.segment(log.segmentCount() - 1).id == activeId + 1);
+  appendRange(log, 251, 260);
+  REQUIRE(log.flush());
+
+  std::vector<uint32_t> expected = range(0, 250);
+  std::vector<uint32_t> after = range(251, 260);
+  expected.insert(expected.end(), after.begin(), after.end());
+  CHECK(queryAll(log) == expected);
+  CHECK(log.corrupted() == 0);
+}
+
+TEST_CASE("MeasurementLog skips and counts a damaged record")
+{
+  MemoryLogStorage storage;
+  MeasurementLog log(storage, RECORDS_PER_SEGMENT, MAX_SEGMENTS);
+  REQUIRE(log.begin());
+  appendRange(log, 0, 300);
+
+  // one bit of the sixth record of the second segment, after the header
+  std::vector<uint8_t> &file = storage.file(segmentFile(log.segment(1).id).c_str());
+  file[sizeof(LogRecord) + 5 * sizeof(LogRecord) + 3] ^= 1;
+
+  std::vector<uint32_t> times = queryAll(log);
+  CHECK(log.corrupted() == 1);
+  CHECK(times.size() == 299);
+  CHECK(std::find(times.begin(), times.end(), 105u) == times.end());
+
+  SECTION("the following records are still found")
+  {
+    CHECK(std::find(times.begin(), times.end(), 106u) != times.end());
+  }
+
+  SECTION("the count is reset by the next query")
+  {
+    std::vector<uint32_t> none;
+    log.query(500, 600, collectTimes, &none);
+    CHECK(log.corrupted() == 0);
+  }
+}
+
+TEST_CASE("MeasurementLog rebuilds its index")
+{
+  MemoryLogStorage storage;
+  {
+    MeasurementLog log(storage, RECORDS_PER_SEGMENT, MAX_SEGMENTS);
+    REQUIRE(log.begin());
+    appendRange(log, 0, 730);
+    REQUIRE(log.flush());
+  }
+
+  SECTION("lost")
+  {
+    storage.files.erase("/tslog.idx");
+  }
+
+  SECTION("garbled")
+  {
+    storage.file("/tslog.idx")[20] ^= 0x10;
+  }
+
+  MeasurementLog log(storage, RECORDS_PER_SEGMENT, MAX_SEGMENTS);
+  REQUIRE(log.begin());
+  CHECK(log.size() == 430);
+  CHECK(queryAll(log) == range(300, 730));
+  CHECK(log.segment(0).minTime == 300);
+  CHECK(log.segment(MAX_SEGMENTS - 1).maxTime == 699);
+
+  // the rebuilt index is saved, and the log goes on where it stopped
+  appendRange(log, 730, 740);
+  REQUIRE(log.flush());
+  MeasurementLog reopened(storage, RECORDS_PER_SEGMENT, MAX_SEGMENTS);
+  REQUIRE(reopened.begin());
+  CHECK(queryAll(reopened) == range(300, 740));
+  CHECK(reopened.corrupted() == 0);
+}
+
+TEST_CASE("MeasurementLog survives a failed append()")
+{
+  MemoryLogStorage storage;
+  MeasurementLog log(storage, RECORDS_PER_SEGMENT, MAX_SEGMENTS);
+  REQUIRE(log.begin());
+  appendRange(log, 0, 20);
+
+  // the page of the records 16 to 23 is half written
+  storage.failAppends = true;
+  bool written = true;
+  for (uint32_t time = 20; time < 24; time++)
+  {
+    written = log.append(makeRecord(time)) && written;
+  }
+  CHECK_FALSE(written);
+  storage.failAppends = false;
+
+  // the log goes on in a new segment
+  appendRange(log, 24, 40);
+  REQUIRE(log.flush());
+
+  std::vector<uint32_t> expected = range(0, 16);
+  std::vector<uint32_t> after = range(24, 40);
+  expected.insert(expected.end(), after.begin(), after.end());
+  CHECK(queryAll(log) == expected);
+
+  MeasurementLog reopened(storage, RECORDS_PER_SEGMENT, MAX_SEGMENTS);
+  REQUIRE(reopened.begin());
+  CHECK(queryAll(reopened) == expected);
+  CHECK(reopened.corrupted() == 0);
+}
+
+TEST_CASE("MeasurementLog stops after a failed write()")
+{
+  MemoryLogStorage storage;
+  {
+    MeasurementLog log(storage, RECORDS_PER_SEGMENT, MAX_SEGMENTS);
+    REQUIRE(log.begin());
+    appendRange(log, 0, RECORDS_PER_SEGMENT - 1);
+
+    // the index and the next segment can't be written when the segment is full
+    storage.failWrites = true;
+    CHECK_FALSE(log.append(makeRecord(RECORDS_PER_SEGMENT - 1)));
+    CHECK_FALSE(log.append(makeRecord(RECORDS_PER_SEGMENT)));
+    CHECK_FALSE(log.flush());
+  }
+
+  // once the storage works again, begin() starts the next segment
+  storage.failWrites = false;
+  MeasurementLog log(storage, RECORDS_PER_SEGMENT, MAX_SEGMENTS);
+  REQUIRE(log.begin());
+  CHECK(log.segmentCount() == 2);
+  appendRange(log, RECORDS_PER_SEGMENT + 1, RECORDS_PER_SEGMENT + 10);
+  REQUIRE(log.flush());
+
+  std::vector<uint32_t> expected = range(0, RECORDS_PER_SEGMENT);
+  std::vector<uint32_t> after = range(RECORDS_PER_SEGMENT + 1, RECORDS_PER_SEGMENT + 10);
+  expected.insert(expected.end(), after.begin(), after.end());
+  CHECK(queryAll(log) == expected);
+}
+
+TEST_CASE("MeasurementLog can't begin without storage")
+{
+  MemoryLogStorage storage;
+  storage.failWrites = true;
+  MeasurementLog log(storage, RECORDS_PER_SEGMENT, MAX_SEGMENTS);
+  CHECK_FALSE(log.begin());
+  CHECK_FALSE(log.append(makeRecord(0)));
+}
+
+TEST_CASE("logFixed() and logValue()")
+{
+  CHECK(logFixed(21.35, 100) == 2135);
+  CHECK(logFixed(-12.5, 100) == -1250);
+  CHECK(logFixed(-333, 100) == LOG_MISSING);
+  CHECK(logFixed(1e6, 1) == 32767);
+  CHECK(logFixed(-300, 1000) == -32767);
+  CHECK(logValue(2135, 100) == Approx(21.35));
+  CHECK(logValue(LOG_MISSING, 100) == -333);
+}
@@ -0,0 +1,51 @@
+#ifndef TEST_DISPLAY_H
+#define TEST_DISPLAY_H
+#include <OLEDDisplay.h>
+
+// A display without a bus: the drawing only goes to the buffer
+class TestDisplay : public OLEDDisplay
+{
+public:
+  TestDisplay(OLEDDISPLAY_GEOMETRY geometry)
+  {
+    setGeometry(geometry);
+    init();
+  }
+
+  uint8_t *frame() { return buffer; }
+  uint16_t frameSize() const { return displayBufferSize; }
+
+  void display() {}
+
+protected:
+  int getBufferOffset() { return 0; }
+  bool connect() { return true; }
+};
+
+// The per-pixel drawing the library did before the spans: every pixel goes through setPixel(), which clips it
+inline void referenceFillRect(OLEDDisplay &display, int16_t x, int16_t y, int16_t width, int16_t height)
+{
+  for (int16_t px = x; px < x + width; px++)
+  {
+    for (int16_t py = y; py < y + height; py++)
+    {
+      display.setPixel(px, py);
+    }
+  }
+}
+
+inline void referenceDrawXbm(OLEDDisplay &display, int16_t x, int16_t y, int16_t width, int16_t height, const uint8_t *xbm)
+{
+  int16_t widthInXbm = (width + 7) / 8;
+  for (int16_t row = 0; row < height; row++)
+  {
+    for (int16_t column = 0; column < width; column++)
+    {
+      if (xbm[column / 8 + row * widthInXbm] & (1 << (column & 7)))
+      {
+        display.setPixel(x + column, y + row);
+      }
+    }
+  }
+}
+#endif
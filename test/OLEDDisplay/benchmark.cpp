@@ -0,0 +1,48 @@
+// Time of the span drawing against the per-pixel drawing it replaced, on a 128x64 frame
+#include <chrono>
+#include <stdio.h>
+#include "TestDisplay.h"
+
+template <typename Draw>
+static double measure(const char *name, Draw draw)
+{
+  TestDisplay display(GEOMETRY_128_64);
+  const int iterations = 20000;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++)
+  {
+    display.setColor((OLEDDISPLAY_COLOR)(i % 3));
+    draw(display, i);
+  }
+  auto end = std::chrono::steady_clock::now();
+  double ns = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+  // read the frame so that the drawing isn't optimized away
+  printf("%-28s %9.0f ns  (%02x)\n", name, ns, display.frame()[100]);
+  return ns;
+}
+
+int main()
+{
+  uint8_t xbm[8 * 32];
+  for (unsigned i = 0; i < sizeof(xbm); i++)
+  {
+    xbm[i] = (uint8_t)(i * 37 + 11);
+  }
+
+  double span = measure("fillRect 100x50", [](TestDisplay &d, int i) { d.fillRect(i % 7, i % 5, 100, 50); });
+  double pixel = measure("fillRect 100x50 per pixel", [](TestDisplay &d, int i) { referenceFillRect(d, i % 7, i % 5, 100, 50); });
+  printf("%-28s %9.1fx\n", "speedup", pixel / span);
+
+  span = measure("drawXbm 64x32", [&](TestDisplay &d, int i) { d.drawXbm(i % 9 - 4, i % 11 - 5, 64, 32, xbm); });
+  pixel = measure("drawXbm 64x32 per pixel", [&](TestDisplay &d, int i) { referenceDrawXbm(d, i % 9 - 4, i % 11 - 5, 64, 32, xbm); });
+  printf("%-28s %9.1fx\n", "speedup", pixel / span);
+
+  span = measure("drawHorizontalLine 128", [](TestDisplay &d, int i) { d.drawHorizontalLine(0, i % 64, 128); });
+  pixel = measure("drawHorizontalLine per pixel", [](TestDisplay &d, int i) { referenceFillRect(d, 0, i % 64, 128, 1); });
+  printf("%-28s %9.1fx\n", "speedup", pixel / span);
+
+  span = measure("drawVerticalLine 60", [](TestDisplay &d, int i) { d.drawVerticalLine(i % 128, i % 4, 60); });
+  pixel = measure("drawVerticalLine per pixel", [](TestDisplay &d, int i) { referenceFillRect(d, i % 128, i % 4, 1, 60); });
+  printf("%-28s %9.1fx\n", "speedup", pixel / span);
+  return 0;
+}
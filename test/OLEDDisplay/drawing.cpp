@@ -0,0 +1,157 @@
+#include <catch.hpp>
+#include <stdlib.h>
+#include "TestDisplay.h"
+
+static const OLEDDISPLAY_COLOR colors[] = {WHITE, BLACK, INVERSE};
+
+// Draws the same shape with the library and with the per-pixel reference, on the same random frame, and compares
+class Comparison
+{
+public:
+  Comparison(OLEDDISPLAY_GEOMETRY geometry) : actual(geometry), expected(geometry)
+  {
+    srand(42);
+    background = new uint8_t[actual.frameSize()];
+    for (uint16_t i = 0; i < actual.frameSize(); i++)
+    {
+      background[i] = rand();
+    }
+  }
+
+  ~Comparison() { delete[] background; }
+
+  void reset(OLEDDISPLAY_COLOR color)
+  {
+    memcpy(actual.frame(), background, actual.frameSize());
+    memcpy(expected.frame(), background, expected.frameSize());
+    actual.setColor(color);
+    expected.setColor(color);
+  }
+
+  bool same() { return memcmp(actual.frame(), expected.frame(), actual.frameSize()) == 0; }
+
+  TestDisplay actual;
+  TestDisplay expected;
+
+private:
+  uint8_t *background;
+};
+
+TEST_CASE("fillRect matches the per-pixel drawing")
+{
+  Comparison c(GEOMETRY_128_64);
+  int W = c.actual.width(), H = c.actual.height();
+
+  SECTION("every row alignment, height and vertical clipping")
+  {
+    const int columns[][2] = {{-1, 3}, {5, 1}, {W - 2, 4}};
+    for (OLEDDISPLAY_COLOR color : colors)
+      for (auto &column : columns)
+        for (int y = -10; y <= H + 2; y++)
+          for (int height = -2; height <= H + 10; height++)
+          {
+            c.reset(color);
+            c.actual.fillRect(column[0], y, column[1], height);
+            referenceFillRect(c.expected, column[0], y, column[1], height);
+            INFO(color << " " << column[0] << " " << y << " " << column[1] << " " << height);
+            REQUIRE(c.same());
+          }
+  }
+
+  SECTION("every column alignment, width and horizontal clipping")
+  {
+    const int rows[][2] = {{3, 1}, {-2, 5}, {6, 4}, {H - 3, 5}};
+    for (OLEDDISPLAY_COLOR color : colors)
+      for (auto &row : rows)
+        for (int x = -10; x <= W + 2; x++)
+          for (int width = -2; width <= W + 10; width++)
+          {
+            c.reset(color);
+            c.actual.fillRect(x, row[0], width, row[1]);
+            referenceFillRect(c.expected, x, row[0], width, row[1]);
+            INFO(color << " " << x << " " << row[0] << " " << width << " " << row[1]);
+            REQUIRE(c.same());
+          }
+  }
+
+  SECTION("random rectangles on every geometry")
+  {
+    const OLEDDISPLAY_GEOMETRY geometries[] = {GEOMETRY_128_64, GEOMETRY_128_32, GEOMETRY_64_48, GEOMETRY_64_32};
+    for (OLEDDISPLAY_GEOMETRY geometry : geometries)
+    {
+      Comparison g(geometry);
+      for (int i = 0; i < 3000; i++)
+      {
+        OLEDDISPLAY_COLOR color = colors[rand() % 3];
+        int x = rand() % 160 - 20, y = rand() % 90 - 20, width = rand() % 150 - 5, height = rand() % 80 - 5;
+        g.reset(color);
+        g.actual.fillRect(x, y, width, height);
+        referenceFillRect(g.expected, x, y, width, height);
+        INFO(geometry << " " << color << " " << x << " " << y << " " << width << " " << height);
+        REQUIRE(g.same());
+      }
+    }
+  }
+}
+
+TEST_CASE("lines match the per-pixel drawing")
+{
+  Comparison c(GEOMETRY_128_64);
+  int W = c.actual.width(), H = c.actual.height();
+
+  SECTION("drawHorizontalLine")
+  {
+    const int rows[] = {-1, 0, 7, 8, 30, H - 1, H};
+    for (OLEDDISPLAY_COLOR color : colors)
+      for (int y : rows)
+        for (int x = -10; x <= W + 2; x++)
+          for (int length = -2; length <= W + 10; length++)
+          {
+            c.reset(color);
+            c.actual.drawHorizontalLine(x, y, length);
+            referenceFillRect(c.expected, x, y, length, 1);
+            INFO(color << " " << x << " " << y << " " << length);
+            REQUIRE(c.same());
+          }
+  }
+
+  SECTION("drawVerticalLine")
+  {
+    const int columns[] = {-1, 0, 1, 63, W - 1, W};
+    for (OLEDDISPLAY_COLOR color : colors)
+      for (int x : columns)
+        for (int y = -10; y <= H + 2; y++)
+          for (int length = -2; length <= H + 10; length++)
+          {
+            c.reset(color);
+            c.actual.drawVerticalLine(x, y, length);
+            referenceFillRect(c.expected, x, y, 1, length);
+            INFO(color << " " << x << " " << y << " " << length);
+            REQUIRE(c.same());
+          }
+  }
+}
+
+TEST_CASE("drawXbm matches the per-pixel drawing")
+{
+  Comparison c(GEOMETRY_128_64);
+  int W = c.actual.width(), H = c.actual.height();
+  uint8_t xbm[3 * 12];
+  for (uint8_t &b : xbm)
+  {
+    b = rand();
+  }
+
+  const int sizes[][2] = {{1, 1}, {7, 3}, {8, 8}, {13, 5}, {20, 12}};
+  for (OLEDDISPLAY_COLOR color : colors)
+    for (auto &size : sizes)
+      for (int y = -14; y <= H + 2; y++)
+        for (int x = -22; x <= W + 2; x++)
+        {
+          c.reset(color);
+          c.actual.drawXbm(x, y, size[0], size[1], xbm);
+          referenceDrawXbm(c.expected, x, y, size[0], size[1], xbm);
+          INFO(color << " " << x << " " << y << " " << size[0] << " " << size[1]);
+          REQUIRE(c.same());
+        }
+}
@@ -0,0 +1,207 @@
+#include <catch.hpp>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <settings_manager.h>
+
+static const StationSettings defaults = {5, 20, 22, 50, 60, 180, 1, 21};
+
+// Settings server that answers 304 when If-None-Match is the ETag of its settings, whose version is in the ETag
+class StandInServer : public SettingsClient
+{
+public:
+  StandInServer() : settings(defaults), version(1), requests(0), bodies(0), offline(false), truncated(false) {}
+
+  int get(const char *ifNoneMatch)
+  {
+    requests++;
+    receivedIfNoneMatch = ifNoneMatch != NULL ? ifNoneMatch : "";
+    if (offline)
+    {
+      return -1;
+    }
+    if (ifNoneMatch != NULL && currentEtag() == ifNoneMatch)
+    {
+      return 304;
+    }
+    bodies++;
+    return 200;
+  }
+
+  const char *etag()
+  {
+    _etag = currentEtag();
+    return _etag.c_str();
+  }
+
+  bool readSettings(StationSettings &read)
+  {
+    if (truncated)
+    {
+      read.SLEEPTIME_s = -1;
+      return false;
+    }
+    read = settings;
+    return true;
+  }
+
+  // A new version of the settings, with a new ETag
+  void publish(const StationSettings &newSettings)
+  {
+    settings = newSettings;
+    version++;
+  }
+
+  std::string currentEtag() const
+  {
+    char etag[16];
+    snprintf(etag, sizeof(etag), "\"v%d\"", version);
+    return etag;
+  }
+
+  StationSettings settings;
+  int version;
+  int requests;
+  int bodies;
+  bool offline;
+  bool truncated;
+  std::string receivedIfNoneMatch;
+
+private:
+  std::string _etag;
+};
+
+static bool same(const StationSettings &a, const StationSettings &b)
+{
+  return compareSettings(a, b) == 0;
+}
+
+TEST_CASE("fetchSettings() asks for the settings only if they changed")
+{
+  StandInServer server;
+  SettingsFetchState state;
+  memset(&state, 0, sizeof(state));
+  StationSettings settings = defaults;
+  settings.SLEEPTIME_s = 10;
+  uint8_t changes;
+
+  // the first fetch is unconditional, and keeps the ETag
+  CHECK(fetchSettings(server, state, 7, settings, changes) == FETCH_UPDATED);
+  CHECK(server.receivedIfNoneMatch == "");
+  CHECK(changes == SETTINGS_CHANGED_TIMING);
+  CHECK(same(settings, defaults));
+  CHECK(std::string(state.etag) == "\"v1\"");
+  CHECK(state.lastFetchCycle == 7);
+
+  // the same settings cost an empty answer and change nothing
+  StationSettings before = settings;
+  CHECK(fetchSettings(server, state, 37, settings, changes) == FETCH_NOT_MODIFIED);
+  CHECK(server.receivedIfNoneMatch == "\"v1\"");
+  CHECK(changes == 0);
+  CHECK(same(settings, before));
+  CHECK(state.lastFetchCycle == 37);
+  CHECK(server.bodies == 1);
+
+  // changed settings come with a new ETag
+  StationSettings changed = defaults;
+  changed.DISPLAY_ON = 0;
+  changed.SQM_LIMIT = 20.5;
+  server.publish(changed);
+  CHECK(fetchSettings(server, state, 67, settings, changes) == FETCH_UPDATED);
+  CHECK(server.receivedIfNoneMatch == "\"v1\"");
+  CHECK(changes == (SETTINGS_CHANGED_DISPLAY | SETTINGS_CHANGED_SKY));
+  CHECK(same(settings, changed));
+  CHECK(std::string(state.etag) == "\"v2\"");
+
+  SECTION("a new ETag for the same settings changes nothing")
+  {
+    server.publish(changed);
+    CHECK(fetchSettings(server, state, 97, settings, changes) == FETCH_UPDATED);
+    CHECK(changes == 0);
+    CHECK(std::string(state.etag) == "\"v3\"");
+  }
+
+  SECTION("no answer keeps the settings, the ETag and the cycle")
+  {
+    server.offline = true;
+    CHECK(fetchSettings(server, state, 97, settings, changes) == FETCH_FAILED);
+    CHECK(changes == 0);
+    CHECK(same(settings, changed));
+    CHECK(std::string(state.etag) == "\"v2\"");
+    CHECK(state.lastFetchCycle == 67);
+  }
+
+  SECTION("a body that can't be read keeps the settings and the ETag")
+  {
+    server.publish(defaults);
+    server.truncated = true;
+    CHECK(fetchSettings(server, state, 97, settings, changes) == FETCH_FAILED);
+    CHECK(same(settings, changed));
+    CHECK(std::string(state.etag) == "\"v2\"");
+    CHECK(state.lastFetchCycle == 67);
+  }
+}
+
+// An ETag that doesn't fit in the state can't be sent back
+class LongEtagServer : public StandInServer
+{
+public:
+  const char *etag() { return "\"0123456789012345678901234567890123456789012345678901234567890123\""; }
+};
+
+TEST_CASE("fetchSettings() drops an ETag too long to be kept")
+{
+  LongEtagServer server;
+  SettingsFetchState state;
+  strcpy(state.etag, "\"old\"");
+  state.lastFetchCycle = 0;
+  StationSettings settings = defaults;
+  uint8_t changes;
+
+  CHECK(fetchSettings(server, state, 1, settings, changes) == FETCH_UPDATED);
+  CHECK(state.etag[0] == 0);
+
+  // so the next fetch is unconditional
+  CHECK(fetchSettings(server, state, 2, settings, changes) == FETCH_UPDATED);
+  CHECK(server.receivedIfNoneMatch == "");
+}
+
+TEST_CASE("isSettingsFetchDue()")
+{
+  SettingsFetchState state;
+  memset(&state, 0, sizeof(state));
+
+  SECTION("after the interval")
+  {
+    state.lastFetchCycle = 100;
+    CHECK_FALSE(isSettingsFetchDue(state, 100, 30));
+    CHECK_FALSE(isSettingsFetchDue(state, 129, 30));
+    CHECK(isSettingsFetchDue(state, 130, 30));
+  }
+
+  SECTION("across the wraparound of the counter")
+  {
+    state.lastFetchCycle = 0xfffffff0u;
+    CHECK_FALSE(isSettingsFetchDue(state, 0xffffffffu, 30));
+    CHECK_FALSE(isSettingsFetchDue(state, 0x0du, 30));
+    CHECK(isSettingsFetchDue(state, 0x0eu, 30));
+    CHECK(isSettingsFetchDue(state, 0x10u, 30));
+  }
+
+  SECTION("once every interval over the wraparound")
+  {
+    StandInServer server;
+    StationSettings settings = defaults;
+    uint8_t changes;
+    state.lastFetchCycle = 0xffffff00u;
+    for (uint32_t cycle = 0xffffff00u; cycle != 0x200u; cycle++)
+    {
+      if (isSettingsFetchDue(state, cycle, 30))
+      {
+        fetchSettings(server, state, cycle, settings, changes);
+      }
+    }
+    CHECK(server.requests == 0x300 / 30);
+    CHECK(server.bodies == 1);
+  }
+}
@@ -0,0 +1,277 @@
+#include <catch.hpp>
+#include <math.h>
+#include <random>
+#include <string.h>
+#include <hardware/time_service.h>
+
+// The settings of the station
+static const uint32_t SYNC_INTERVAL_s = 21600;
+static const uint32_t MAX_UNCERTAINTY_ms = 1000;
+static const uint32_t SYNC_RETRY_s = 600;
+
+static const int64_t SECOND = 1000000;
+
+// A clock running (1 + driftPpm) times as fast as UTC, that can be set
+struct SimulatedClock
+{
+  double driftPpm;
+  int64_t setUtcUs;
+  int64_t setClockUs;
+
+  int64_t read(int64_t utcUs) const { return setClockUs + (int64_t)llround((utcUs - setUtcUs) * (1 + driftPpm * 1e-6)); }
+
+  void set(int64_t utcUs, int64_t clockUs)
+  {
+    setUtcUs = utcUs;
+    setClockUs = clockUs;
+  }
+};
+
+// An NTP time stamp: big-endian seconds since 1900 and fractions of 2^-32 seconds
+static void writeNtpTime(uint8_t *p, int64_t unixUs)
+{
+  uint32_t seconds = (uint32_t)(unixUs / SECOND + 2208988800ULL);
+  uint32_t fraction = (uint32_t)(((uint64_t)(unixUs % SECOND) << 32) / SECOND);
+  for (int i = 0; i < 4; i++)
+  {
+    p[i] = seconds >> (24 - 8 * i);
+    p[4 + i] = fraction >> (24 - 8 * i);
+  }
+}
+
+// The answer of a stratum 2 server to a request, received and sent at these UTC times
+static void buildReply(uint8_t *reply, const uint8_t *request, int64_t receivedUs, int64_t sentUs)
+{
+  memset(reply, 0, NTP_PACKET_SIZE);
+  reply[0] = 0x24; // no leap second warning, version 4, server
+  reply[1] = 2;
+  memcpy(reply + 24, request + 40, 8);
+  writeNtpTime(reply + 32, receivedUs);
+  writeNtpTime(reply + 40, sentUs);
+}
+
+// An SNTP server with the true time, over a network with random and asymmetric delays
+class StandInNtpServer
+{
+public:
+  StandInNtpServer(uint32_t seed) : _random(seed), _leg(2000, 40000) {}
+
+  // Sync like time_fkt does, return false if the answer isn't valid
+  bool sync(TimeState &state, SimulatedClock &clock, int64_t utcUs)
+  {
+    uint8_t request[NTP_PACKET_SIZE];
+    uint8_t reply[NTP_PACKET_SIZE];
+    int64_t requestUs = clock.read(utcUs);
+    buildNtpRequest(request, requestUs);
+    int64_t receivedUs = utcUs + _leg(_random);
+    int64_t sentUs = receivedUs + 300;
+    buildReply(reply, request, receivedUs, sentUs);
+    int64_t answerUtcUs = sentUs + _leg(_random);
+    int64_t answerUs = clock.read(answerUtcUs);
+
+    int64_t offsetUs, delayUs;
+    if (!parseNtpReply(reply, sizeof(reply), requestUs, answerUs, offsetUs, delayUs))
+    {
+      return false;
+    }
+    applyTimeSync(state, answerUs, offsetUs, (uint32_t)(delayUs / 2));
+    clock.set(answerUtcUs, answerUs + offsetUs);
+    return true;
+  }
+
+private:
+  std::mt19937 _random;
+  std::uniform_int_distribution<int> _leg;
+};
+
+TEST_CASE("parseNtpReply()")
+{
+  const int64_t requestUs = 1760000000123456LL;
+  const int64_t answerUs = requestUs + 80000;
+  uint8_t request[NTP_PACKET_SIZE];
+  uint8_t reply[NTP_PACKET_SIZE];
+  buildNtpRequest(request, requestUs);
+  CHECK(request[0] == 0x23);
+
+  // the clock is 2 s behind, 30 ms each way and 1 ms in the server
+  buildReply(reply, request, requestUs + 2 * SECOND + 30000, requestUs + 2 * SECOND + 31000);
+  int64_t offsetUs = 0, delayUs = 0;
+
+  SECTION("a valid answer")
+  {
+    REQUIRE(parseNtpReply(reply, sizeof(reply), requestUs, requestUs + 61000, offsetUs, delayUs));
+    CHECK(offsetUs == Approx(2 * SECOND).margin(1));
+    CHECK(delayUs == Approx(60000).margin(1));
+  }
+
+  SECTION("a short packet")
+  {
+    CHECK_FALSE(parseNtpReply(reply, NTP_PACKET_SIZE - 1, requestUs, answerUs, offsetUs, delayUs));
+    CHECK_FALSE(parseNtpReply(reply, 0, requestUs, answerUs, offsetUs, delayUs));
+  }
+
+  SECTION("a kiss-o'-death")
+  {
+    reply[1] = 0;
+    memcpy(reply + 12, "RATE", 4);
+    CHECK_FALSE(parseNtpReply(reply, sizeof(reply), requestUs, answerUs, offsetUs, delayUs));
+  }
+
+  SECTION("a transmit time of zero")
+  {
+    memset(reply + 40, 0, 8);
+    CHECK_FALSE(parseNtpReply(reply, sizeof(reply), requestUs, answerUs, offsetUs, delayUs));
+  }
+
+  SECTION("an unsynchronized server")
+  {
+    reply[0] = 0xe4;
+    CHECK_FALSE(parseNtpReply(reply, sizeof(reply), requestUs, answerUs, offsetUs, delayUs));
+  }
+
+  SECTION("a request instead of an answer")
+  {
+    CHECK_FALSE(parseNtpReply(request, sizeof(request), requestUs, answerUs, offsetUs, delayUs));
+  }
+
+  SECTION("the answer to another request")
+  {
+    CHECK_FALSE(parseNtpReply(reply, sizeof(reply), requestUs + 1000, answerUs, offsetUs, delayUs));
+  }
+}
+
+// Ten days of cycles every minute with a clock that drifts: the sensors take 4 s before the sync, and the WiFi is down
+// for 5 hours every 35 hours
+static void simulateDrift(double driftPpm)
+{
+  INFO("drift " << driftPpm << " ppm");
+  StandInNtpServer server(7);
+  TimeState state;
+  clearTimeState(state);
+  const int64_t utc0 = 1760000000LL * SECOND;
+  SimulatedClock clock = {driftPpm, utc0, 5 * SECOND};
+
+  int syncs = 0;
+  int64_t lastAttemptUs = 0;
+  bool attempted = false;
+  double previousError = -1;
+  for (int64_t cycle = 0; cycle < 10 * 1440; cycle++)
+  {
+    int64_t utcUs = utc0 + cycle * 60 * SECOND;
+    int64_t acquiredUs = clock.read(utcUs);
+    int64_t syncUtcUs = utcUs + 4 * SECOND;
+    bool online = (cycle / 300) % 7 != 3;
+    int64_t clockUs = clock.read(syncUtcUs);
+    if (online && isTimeSyncDue(state, clockUs, SYNC_INTERVAL_s, MAX_UNCERTAINTY_ms, SYNC_RETRY_s))
+    {
+      // never twice within the retry time
+      INFO("cycle " << cycle);
+      CHECK((!attempted || syncUtcUs - lastAttemptUs >= (int64_t)SYNC_RETRY_s * SECOND));
+      attempted = true;
+      lastAttemptUs = syncUtcUs;
+      noteTimeSyncAttempt(state, clockUs);
+      int64_t beforeUs = clock.read(syncUtcUs);
+      if (server.sync(state, clock, syncUtcUs))
+      {
+        // the sensors were read before the clock was set
+        acquiredUs += clock.read(syncUtcUs) - beforeUs;
+        syncs++;
+        if (state.flags & TIME_FLAG_DRIFT_KNOWN)
+        {
+          // the estimate gets closer to the drift, or stays close
+          double error = fabs(state.driftPpm + driftPpm);
+          CHECK((previousError < 0 || error < previousError || error < TIME_DRIFT_RESIDUAL_PPM / 5));
+          previousError = error;
+        }
+      }
+    }
+
+    int64_t stampUs;
+    uint32_t uncertaintyMs;
+    uint8_t quality = stampTime(state, acquiredUs, stampUs, uncertaintyMs);
+    if (quality == TIME_QUALITY_NONE)
+    {
+      continue;
+    }
+    // between the syncs, the time stays within its bound
+    double errorMs = fabs((double)(stampUs - utcUs)) / 1000;
+    if (errorMs > uncertaintyMs)
+    {
+      INFO("cycle " << cycle << ": " << errorMs << " ms > " << uncertaintyMs << " ms");
+      FAIL("the time isn't within its bound");
+    }
+  }
+
+  CHECK((state.flags & TIME_FLAG_DRIFT_KNOWN) != 0);
+  CHECK(fabs(state.driftPpm + driftPpm) < 15);
+  int64_t stampUs;
+  uint32_t uncertaintyMs;
+  CHECK(stampTime(state, clock.read(utc0 + 10 * 86400 * SECOND), stampUs, uncertaintyMs) == TIME_QUALITY_CORRECTED);
+  // the known drift makes the syncs rarer than every retry time
+  CHECK(syncs < 200);
+}
+
+TEST_CASE("The time service corrects a drifting clock")
+{
+  SECTION("fast")
+  {
+    simulateDrift(180);
+  }
+
+  SECTION("slow")
+  {
+    simulateDrift(-420);
+  }
+
+  SECTION("nearly right")
+  {
+    simulateDrift(3);
+  }
+}
+
+TEST_CASE("isTimeSyncDue()")
+{
+  TimeState state;
+  clearTimeState(state);
+
+  SECTION("an unreachable server is asked once per retry time")
+  {
+    int attempts = 0;
+    for (int64_t clockUs = 0; clockUs < 3600 * SECOND; clockUs += 60 * SECOND)
+    {
+      if (isTimeSyncDue(state, clockUs, SYNC_INTERVAL_s, MAX_UNCERTAINTY_ms, SYNC_RETRY_s))
+      {
+        noteTimeSyncAttempt(state, clockUs);
+        attempts++;
+      }
+    }
+    CHECK(attempts == 6);
+  }
+
+  SECTION("after the interval, or when the bound is too large")
+  {
+    applyTimeSync(state, 100 * SECOND, 0, 20000);
+    CHECK_FALSE(isTimeSyncDue(state, 200 * SECOND, SYNC_INTERVAL_s, MAX_UNCERTAINTY_ms, SYNC_RETRY_s));
+    // 500 ppm of 2000 s is 1 s, with the 20 ms of the sync
+    CHECK(isTimeSyncDue(state, 2100 * SECOND, SYNC_INTERVAL_s, MAX_UNCERTAINTY_ms, SYNC_RETRY_s));
+    CHECK(isTimeSyncDue(state, 2100 * SECOND, 1000, 100000, SYNC_RETRY_s));
+    CHECK_FALSE(isTimeSyncDue(state, 1000 * SECOND, 3600, 100000, SYNC_RETRY_s));
+  }
+
+  SECTION("when the clock went back")
+  {
+    applyTimeSync(state, 10000 * SECOND, 0, 20000);
+    CHECK(isTimeSyncDue(state, 5000 * SECOND, SYNC_INTERVAL_s, MAX_UNCERTAINTY_ms, SYNC_RETRY_s));
+  }
+}
+
+TEST_CASE("stampTime() before any sync")
+{
+  TimeState state;
+  clearTimeState(state);
+  int64_t stampUs;
+  uint32_t uncertaintyMs;
+  CHECK(stampTime(state, 12 * SECOND, stampUs, uncertaintyMs) == TIME_QUALITY_NONE);
+  CHECK(stampUs == 12 * SECOND);
+  CHECK(uncertaintyMs == UINT32_MAX);
+}